@@ -60,6 +60,9 @@ int main(void)
     unsigned int animCurrentFrame = 0;
     ModelAnimation *modelAnimations = LoadModelAnimations("resources/models/gltf/greenman.glb", &animsCount);
 
+    // Current animation pose, bones transforms sampled from animation keyframes
+    Transform *animPose = (Transform *)MemAlloc(characterModel.boneCount*sizeof(Transform));
+
     // indices of bones for sockets
     int boneSocketIndex[BONE_SOCKETS] = { -1, -1, -1 };
 
@@ -117,6 +120,7 @@ int main(void)
         ModelAnimation anim = modelAnimations[animIndex];
         animCurrentFrame = (animCurrentFrame + 1)%anim.frameCount;
         UpdateModelAnimation(characterModel, anim, animCurrentFrame);
+        GetModelAnimationPose(anim, (float)animCurrentFrame/anim.frameRate, animPose);
         //----------------------------------------------------------------------------------
 
         // Draw
@@ -137,7 +141,7 @@ int main(void)
                 {
                     if (!showEquip[i]) continue;
 
-                    Transform *transform = &anim.framePoses[animCurrentFrame][boneSocketIndex[i]];
+                    Transform *transform = &animPose[boneSocketIndex[i]];
                     Quaternion inRotation = characterModel.bindPose[boneSocketIndex[i]].rotation;
                     Quaternion outRotation = transform->rotation;
 
@@ -167,6 +171,7 @@ int main(void)
     // De-Initialization
     //--------------------------------------------------------------------------------------
     UnloadModelAnimations(modelAnimations, animsCount);
+    MemFree(animPose);
     UnloadModel(characterModel);         // Unload character model and meshes/material
 
     // Unload equipment model and meshes/material
@@ -47,6 +47,9 @@ int main(void)
     Texture2D texture = LoadTexture("resources/models/obj/turret_diffuse.png"); // Load model texture
     tower.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = texture;            // Set model diffuse texture
 
+    // Generate meshes bounding volume hierarchy, it speeds up ray collision checks
+    for (int m = 0; m < tower.meshCount; m++) GenMeshBVH(&tower.meshes[m]);
+
     Vector3 towerPos = { 0.0f, 0.0f, 0.0f };                        // Set model position
     BoundingBox towerBBox = GetMeshBoundingBox(tower.meshes[0]);    // Get mesh bounding box
 
@@ -124,6 +124,9 @@
 // Show OpenGL extensions and capabilities detailed logs on init
 //#define RLGL_SHOW_GL_DETAILS_INFO              1
 
+// Keep rlgl state thread-local, worker threads can record draw calls into their own render batches
+//#define RLGL_ENABLE_THREADED_RECORDING         1
+
 #define RL_SUPPORT_MESH_GPU_SKINNING           1      // GPU skinning, comment if your GPU does not support more than 8 VBOs
 
 //#define RL_DEFAULT_BATCH_BUFFER_ELEMENTS    4096    // Default internal render batch elements limits
@@ -208,6 +211,9 @@
 // Support multiple image editing functions to scale, adjust colors, flip, draw on images, crop...
 // If not defined, still some functions are supported: ImageFormat(), ImageCrop(), ImageToPOT()
 #define SUPPORT_IMAGE_MANIPULATION      1
+// Support automatic packing of small textures into shared atlas pages [EnableTextureAtlas()]
+// Textures drawn from the same atlas page are batched together, avoiding draw calls on texture switches
+#define SUPPORT_TEXTURE_ATLAS           1
 
 //------------------------------------------------------------------------------------
 // Module: rtext - Configuration Flags
@@ -251,6 +257,15 @@
 // Support procedural mesh generation functions, uses external par_shapes.h library
 // NOTE: Some generated meshes DO NOT include generated texture coordinates
 #define SUPPORT_MESH_GENERATION         1
+// Split CPU skinning of large meshes across multiple threads: UpdateModelAnimation()
+//#define SUPPORT_THREADED_SKINNING       1
+// Weld duplicated vertices and generate indices for OBJ, heightmap and cubicmap meshes: OptimizeMesh()
+//#define SUPPORT_MESH_OPTIMIZATION       1
+// Map glTF/glb files in memory instead of loading them, tightly packed accessors read directly: LoadModel()
+//#define SUPPORT_GLTF_FILE_MAPPING       1
+// Bake glTF animations poses by frame (ModelAnimation.framePoses), keyframes are always kept for sampling
+// NOTE: Disabling it reduces animations memory, framePoses is NULL for glTF animations
+#define SUPPORT_GLTF_BAKED_POSES        1
 
 // rmodels: Configuration values
 //------------------------------------------------------------------------------------
@@ -19,16 +19,23 @@
 *           - All uncompressed texture formats supported by raylib
 *           - Texture Minification/Magnification checks
 *           - Point and Bilinear filtering
+*           - Mipmaps (uploaded or generated) with nearest-mip and trilinear filtering
+*           - Optional tiled texture storage for cache friendly sampling (SW_TEXTURE_TILED)
 *           - Texture Wrap Modes with separate checks for S/T coordinates
 *       - Vertex Arrays support with direct primitive drawing mode
 *       - Matrix Stack support (Matrix Push/Pop)
+*       - Optional tile-binned multithreaded rasterization (SW_SUPPORT_MULTITHREADING)
+*           - Deferred rendering mode, opaque primitives replayed sorted by state and texture
+*       - Optional SIMD edge function triangle rasterizer (SW_RASTER_HALFSPACE)
 *       - Other GL misc features:
 *           - GL-style getter functions
 *           - Framebuffer resizing
+*           - Separate color and depth planes, color-only passes never touch depth, color plane can be external memory (zero-copy presentation)
 *           - Perspective correction
 *           - Scissor clipping
 *           - Depth testing
-*           - Blend modes
+*           - Optional hierarchical depth (coarse per-tile depth) rejection (SW_HIERARCHICAL_DEPTH)
+*           - Blend modes (fixed-point alpha, additive, multiplied and premultiplied on RGBA8/RGB565)
 *           - Face culling
 *
 *   ADDITIONAL NOTES:
@@ -51,6 +58,33 @@
 *           #define SW_MAX_MODELVIEW_STACK_SIZE     8
 *           #define SW_MAX_TEXTURE_STACK_SIZE       2
 *           #define SW_MAX_TEXTURES                 128
+*           #define SW_MAX_MIPMAP_LEVELS            16
+*           #define SW_VERTEX_CACHE_SIZE            128
+*
+*       #define SW_SUPPORT_MULTITHREADING
+*           Enables the binned rendering mode: primitives are clipped and projected on the calling
+*           thread, recorded into per-tile bins and rasterized in parallel by a pool of worker threads
+*           Output is identical to the single-threaded path, use swSetThreadCount() to enable it
+*           swSetDeferredRendering() records primitives until the next flush even with a single thread,
+*           opaque depth tested primitives are then rasterized sorted by state, texture and depth in each tile
+*           NOTE: Sorting can change which one of two coplanar opaque primitives is visible
+*           NOTE: Requires linking with pthreads on non-Windows platforms
+*
+*       #define SW_TEXTURE_TILED
+*           Stores textures in 4x4 texels tiles (64 bytes, one cache line) instead of linear rows,
+*           converted at upload, bilinear and rotated lookups touch fewer cache lines
+*
+*       #define SW_RASTER_HALFSPACE
+*           Uses the edge function (half-space) triangle rasterizer instead of the scanline one,
+*           pixels are processed in 2x2 quads (4 lanes with SSE/NEON, 8 lanes with AVX2)
+*
+*       #define SW_HIERARCHICAL_DEPTH
+*           Keeps an upper bound of the depth of each 8x8 pixels tile of the framebuffer, depth tested
+*           triangles, spans and blocks behind it are rejected before any per-pixel work
+*
+*           #define SW_MAX_THREADS                  16
+*           #define SW_TILE_HEIGHT                  32
+*           #define SW_MAX_BINNED_PRIMITIVES        16384
 *
 * 
 *   LICENSE: MIT
@@ -137,6 +171,26 @@
     #define SW_MAX_TEXTURES                 128
 #endif
 
+#ifndef SW_MAX_MIPMAP_LEVELS
+    #define SW_MAX_MIPMAP_LEVELS            16      // Maximum number of mipmap levels per texture (base level included)
+#endif
+
+#ifndef SW_VERTEX_CACHE_SIZE
+    #define SW_VERTEX_CACHE_SIZE            128     // Number of transformed vertices cached by swDrawElements() (power of two)
+#endif
+
+#ifndef SW_MAX_THREADS
+    #define SW_MAX_THREADS                  16      // Maximum number of rasterization threads (including calling thread)
+#endif
+
+#ifndef SW_TILE_HEIGHT
+    #define SW_TILE_HEIGHT                  32      // Height of the screen tiles (rows) used for binning
+#endif
+
+#ifndef SW_MAX_BINNED_PRIMITIVES
+    #define SW_MAX_BINNED_PRIMITIVES        16384   // Number of recorded primitives that forces a flush
+#endif
+
 // Under normal circumstances, clipping a polygon can add at most one vertex per clipping plane.
 // Considering the largest polygon involved is a quadrilateral (4 vertices),
 // and that clipping occurs against both the frustum (6 planes) and the scissors (4 planes),
@@ -263,6 +317,10 @@ typedef double              GLclampd;
 
 #define GL_NEAREST                          0x2600
 #define GL_LINEAR                           0x2601
+#define GL_NEAREST_MIPMAP_NEAREST           0x2700
+#define GL_LINEAR_MIPMAP_NEAREST            0x2701
+#define GL_NEAREST_MIPMAP_LINEAR            0x2702
+#define GL_LINEAR_MIPMAP_LINEAR             0x2703
 
 #define GL_REPEAT                           0x2901
 #define GL_CLAMP                            0x2900
@@ -363,6 +421,8 @@ typedef double              GLclampd;
 #define glColor4fv(v)                               swColor4fv((v))
 #define glTexCoord2f(u, v)                          swTexCoord2f((u), (v))
 #define glTexCoord2fv(v)                            swTexCoord2fv((v))
+#define glFlush()                                   swFlush()
+#define glFinish()                                  swFlush()
 
 #define glEnableClientState(t)                      ((void)(t))
 #define glDisableClientState(t)                     swBindArray((t), 0)
@@ -373,7 +433,8 @@ typedef double              GLclampd;
 #define glDrawElements(m,c,t,i)                     swDrawElements((m),(c),(t),(i))
 #define glGenTextures(c, v)                         swGenTextures((c), (v))
 #define glDeleteTextures(c, v)                      swDeleteTextures((c), (v))
-#define glTexImage2D(tr, l, if, w, h, b, f, t, p)   swTexImage2D((w), (h), (f), (t), (p))
+#define glTexImage2D(tr, l, if, w, h, b, f, t, p)   swTexImage2DLevel((l), (w), (h), (f), (t), (p))
+#define glGenerateMipmap(tr)                        swGenerateMipmap()
 #define glTexParameteri(tr, pname, param)           swTexParameteri((pname), (param))
 #define glBindTexture(tr, id)                       swBindTexture((id))
 
@@ -490,7 +551,11 @@ typedef enum {
 
 typedef enum {
     SW_NEAREST = GL_NEAREST,
-    SW_LINEAR = GL_LINEAR
+    SW_LINEAR = GL_LINEAR,
+    SW_NEAREST_MIPMAP_NEAREST = GL_NEAREST_MIPMAP_NEAREST,
+    SW_LINEAR_MIPMAP_NEAREST = GL_LINEAR_MIPMAP_NEAREST,
+    SW_NEAREST_MIPMAP_LINEAR = GL_NEAREST_MIPMAP_LINEAR,
+    SW_LINEAR_MIPMAP_LINEAR = GL_LINEAR_MIPMAP_LINEAR
 } SWfilter;
 
 typedef enum {
@@ -519,10 +584,15 @@ typedef enum {
 //------------------------------------------------------------------------------------
 SWAPI bool swInit(int w, int h);
 SWAPI void swClose(void);
+SWAPI bool swSetThreadCount(int count);     // Set number of rasterization threads, 1 disables binned mode
+SWAPI int swGetThreadCount(void);
+SWAPI bool swSetDeferredRendering(bool enabled);   // Record primitives until flush, opaque ones replayed sorted by state
+SWAPI void swFlush(void);                   // Rasterize all primitives recorded in binned mode
 
 SWAPI bool swResizeFramebuffer(int w, int h);
 SWAPI void swCopyFramebuffer(int x, int y, int w, int h, SWformat format, SWtype type, void *pixels);
 SWAPI void swBlitFramebuffer(int xDst, int yDst, int wDst, int hDst, int xSrc, int ySrc, int wSrc, int hSrc, SWformat format, SWtype type, void *pixels);
+SWAPI bool swBindColorBuffer(int w, int h, SWformat format, SWtype type, void *pixels); // Render into external color memory, NULL restores the internal buffer
 
 SWAPI void swEnable(SWstate state);
 SWAPI void swDisable(SWstate state);
@@ -589,6 +659,8 @@ SWAPI void swGenTextures(int count, uint32_t *textures);
 SWAPI void swDeleteTextures(int count, uint32_t *textures);
 
 SWAPI void swTexImage2D(int width, int height, SWformat format, SWtype type, const void *data);
+SWAPI void swTexImage2DLevel(int level, int width, int height, SWformat format, SWtype type, const void *data);
+SWAPI void swGenerateMipmap(void);          // Generate mipmap levels for current texture from its base level
 SWAPI void swTexParameteri(int param, int value);
 SWAPI void swBindTexture(uint32_t id);
 
@@ -690,6 +762,28 @@ SWAPI void swBindTexture(uint32_t id);
     #include <riscv_vector.h>
 #endif
 
+// Threading primitives used by the binned rendering mode
+#if defined(SW_SUPPORT_MULTITHREADING)
+    #if defined(_WIN32)
+        #define SW_THREADS_WIN32
+        #if !defined(_WINDOWS_)
+            // NOTE: Declared manually to avoid including <windows.h> and its name collisions
+            __declspec(dllimport) void *__stdcall CreateThread(void *attributes, size_t stackSize, unsigned long (__stdcall *func)(void *), void *param, unsigned long flags, unsigned long *threadId);
+            __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+            __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+            __declspec(dllimport) void __stdcall InitializeSRWLock(void *lock);
+            __declspec(dllimport) void __stdcall AcquireSRWLockExclusive(void *lock);
+            __declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(void *lock);
+            __declspec(dllimport) void __stdcall InitializeConditionVariable(void *cond);
+            __declspec(dllimport) int __stdcall SleepConditionVariableSRW(void *cond, void *lock, unsigned long milliseconds, unsigned long flags);
+            __declspec(dllimport) void __stdcall WakeAllConditionVariable(void *cond);
+        #endif
+    #else
+        #define SW_THREADS_PTHREAD
+        #include <pthread.h>        // Required for: pthread_create(), pthread_join(), pthread_mutex_*(), pthread_cond_*()
+    #endif
+#endif
+
 #ifdef __cplusplus
     #define SW_CURLY_INIT(name) name
 #else
@@ -706,12 +800,13 @@ SWAPI void swBindTexture(uint32_t id);
 
 #define SW_COLOR_PIXEL_SIZE     (SW_COLOR_BUFFER_BITS >> 3)
 #define SW_DEPTH_PIXEL_SIZE     (SW_DEPTH_BUFFER_BITS >> 3)
-#define SW_PIXEL_SIZE           (SW_COLOR_PIXEL_SIZE + SW_DEPTH_PIXEL_SIZE)
 
-#if (SW_PIXEL_SIZE <= 4)
-    #define SW_PIXEL_ALIGNMENT 4
-#else // if (SW_PIXEL_SIZE <= 8)
-    #define SW_PIXEL_ALIGNMENT 8
+// 32-bit colors are stored in the byte order of the framebuffer copies,
+// so the color buffer can be presented without conversion (see swBindColorBuffer())
+#if (SW_COLOR_BUFFER_BITS == 32) && SW_GL_FRAMEBUFFER_COPY_BGRA
+    #define SW_COLOR_STORAGE_BGRA 1
+#else
+    #define SW_COLOR_STORAGE_BGRA 0
 #endif
 
 #if (SW_COLOR_BUFFER_BITS == 8)
@@ -785,6 +880,28 @@ SWAPI void swBindTexture(uint32_t id);
 #define SW_STATE_CULL_FACE      (1 << 3)
 #define SW_STATE_BLEND          (1 << 4)
 
+#define SW_TILE_COUNT(height)   (((height) + SW_TILE_HEIGHT - 1)/SW_TILE_HEIGHT)
+
+#define SW_HIZ_TILE_SIZE        8       // Hierarchical depth tiles size, one bit per pixel in a 64-bit mask
+#define SW_HIZ_DEPTH_UNKNOWN    2.0f    // Depth bound above any stored depth
+
+// Rasterize pending binned primitives before changing state they depend on
+#if defined(SW_SUPPORT_MULTITHREADING)
+    #define SW_BINNING_FLUSH() sw_binning_flush()
+#else
+    #define SW_BINNING_FLUSH()
+#endif
+
+// Hierarchical depth tiles can't straddle two bands, each band is rasterized by a single thread
+#if defined(SW_HIERARCHICAL_DEPTH) && ((SW_TILE_HEIGHT % SW_HIZ_TILE_SIZE) != 0)
+    #error "SW_TILE_HEIGHT must be a multiple of SW_HIZ_TILE_SIZE"
+#endif
+
+// Vertex cache slots are selected by masking the vertex index
+#if (SW_VERTEX_CACHE_SIZE & (SW_VERTEX_CACHE_SIZE - 1)) != 0
+    #error "SW_VERTEX_CACHE_SIZE must be a power of two"
+#endif
+
 //----------------------------------------------------------------------------------
 // Module Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -813,6 +930,16 @@ typedef void (*sw_factor_f)(
     const float *SW_RESTRICT dst
 );
 
+// Blend factors combinations with a fixed-point path on 8 bits per channel framebuffers
+typedef enum {
+    SW_BLEND_MODE_GENERIC = 0,      // Any other combination, blended in float with the factor functions
+    SW_BLEND_MODE_ALPHA,            // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+    SW_BLEND_MODE_ADDITIVE,         // SRC_ALPHA, ONE
+    SW_BLEND_MODE_ADD_COLORS,       // ONE, ONE
+    SW_BLEND_MODE_MULTIPLIED,       // DST_COLOR, ONE_MINUS_SRC_ALPHA
+    SW_BLEND_MODE_PREMULTIPLIED     // ONE, ONE_MINUS_SRC_ALPHA
+} sw_blend_mode_t;
+
 typedef float sw_matrix_t[4*4];
 typedef uint16_t sw_half_t;
 
@@ -826,11 +953,22 @@ typedef struct {
 } sw_vertex_t;
 
 typedef struct {
-    uint8_t *pixels;            // Texture pixels (RGBA32)
+    uint8_t *pixels;            // Mipmap level pixels (RGBA32)
+
+    int width, height;          // Dimensions of the level
+    int wMinus1, hMinus1;       // Dimensions minus one
+    int tileStride;             // Texels per row of tiles (SW_TEXTURE_TILED only)
+} sw_mipmap_t;
+
+typedef struct {
+    uint8_t *pixels;            // Texture pixels (RGBA32), base level
 
     int width, height;          // Dimensions of the texture
     int wMinus1, hMinus1;       // Dimensions minus one
 
+    sw_mipmap_t mipmaps[SW_MAX_MIPMAP_LEVELS];  // Mipmap levels, level 0 is the base level
+    int mipmapCount;            // Number of available mipmap levels
+
     SWfilter minFilter;         // Minification filter
     SWfilter magFilter;         // Magnification filter
 
@@ -841,25 +979,96 @@ typedef struct {
     float ty;                   // Texel height
 } sw_texture_t;
 
-// Pixel data type
-typedef SW_ALIGN(SW_PIXEL_ALIGNMENT) struct {
+// Pixel data types, color and depth are stored in two separate planes
+typedef struct {
     SW_COLOR_TYPE color[SW_COLOR_PACK_COMP];
+} sw_color_t;
+
+typedef struct {
     SW_DEPTH_TYPE depth[SW_DEPTH_PACK_COMP];
-#if (SW_PIXEL_SIZE % SW_PIXEL_ALIGNMENT != 0)
-    uint8_t padding[SW_PIXEL_ALIGNMENT - SW_PIXEL_SIZE % SW_PIXEL_ALIGNMENT];
-#endif
-} sw_pixel_t;
+} sw_depth_t;
+
+// Coarse depth of a framebuffer tile (hierarchical depth)
+typedef struct {
+    uint64_t coverage;              // Pixels written since 'maxDepth' was last tightened
+    float maxDepth;                 // Upper bound of the tile depths
+    float writeMaxDepth;            // Farthest depth written since 'maxDepth' was last tightened
+} sw_hiz_tile_t;
 
 typedef struct {
-    sw_pixel_t *pixels;
+    sw_color_t *color;              // Color plane, internal or external storage
+    sw_depth_t *depth;              // Depth plane
+    sw_color_t *colorInternal;      // Color plane allocated by rlsw, used when no external storage is bound
     int width;
     int height;
     int allocSz;
+#if defined(SW_HIERARCHICAL_DEPTH)
+    sw_hiz_tile_t *hiz;             // Coarse depth tiles, SW_HIZ_TILE_SIZE pixels square
+    int hizWidth;                   // Number of tiles per row
+    int hizHeight;                  // Number of tile rows
+    int hizAllocSz;
+#endif
 } sw_framebuffer_t;
 
+#if defined(SW_SUPPORT_MULTITHREADING)
+#if defined(SW_THREADS_WIN32)
+typedef void *sw_thread_t;
+typedef struct { void *ptr; } sw_mutex_t;   // SRWLOCK
+typedef struct { void *ptr; } sw_cond_t;    // CONDITION_VARIABLE
+#else
+typedef pthread_t sw_thread_t;
+typedef pthread_mutex_t sw_mutex_t;
+typedef pthread_cond_t sw_cond_t;
+#endif
+
+// Binned primitive types
+typedef enum {
+    SW_PRIMITIVE_TRIANGLE = 0,
+    SW_PRIMITIVE_QUAD_AXIS_ALIGNED,
+    SW_PRIMITIVE_LINE,
+    SW_PRIMITIVE_POINT
+} sw_primitive_type_t;
+
+// Primitive recorded after clipping and projection, ready to be rasterized
+typedef struct {
+    sw_vertex_t vertices[4];        // Screen space vertices (triangle: 3, quad: 4, line: 2, point: 1)
+    const sw_texture_t *texture;    // Texture bound when the primitive was submitted
+    uint32_t state;                 // State flags used to select the raster function
+    sw_primitive_type_t type;       // Primitive type
+    float depth;                    // Nearest vertex depth, used to sort opaque primitives front to back
+} sw_primitive_t;
+
+// List of primitive indices overlapping one screen tile, in submission order
+typedef struct {
+    uint32_t *indices;
+    int count;
+    int capacity;
+} sw_bin_t;
+
+typedef struct {
+    sw_thread_t threads[SW_MAX_THREADS];    // Worker threads (calling thread is not included)
+    int threadCount;                        // Number of rasterization threads, including calling thread
+    bool enabled;                           // Binned mode is enabled (threadCount > 1)
+
+    sw_mutex_t mutex;                       // Protects the scheduling values below
+    sw_cond_t workCond;                     // Signaled when a new flush is started (or on quit)
+    sw_cond_t doneCond;                     // Signaled when the last worker finished the flush
+    uint32_t generation;                    // Flush counter, used by workers to detect new work
+    int nextTile;                           // Next tile to be processed in the current flush
+    int activeWorkers;                      // Number of workers still processing the current flush
+    bool quit;                              // Request workers to exit
+
+    sw_primitive_t *primitives;             // Recorded primitives (SW_MAX_BINNED_PRIMITIVES)
+    int primitiveCount;                     // Number of recorded primitives
+    sw_bin_t *bins;                         // One bin per tile (tiles are SW_TILE_HEIGHT rows, full width)
+    int binCount;                           // Number of bins
+} sw_binning_t;
+#endif
+
 typedef struct {
     sw_framebuffer_t framebuffer;   // Main framebuffer
-    sw_pixel_t clearValue;          // Clear value of the framebuffer
+    sw_color_t clearColor;          // Clear color of the framebuffer
+    sw_depth_t clearDepth;          // Clear depth of the framebuffer
 
     float vpCenter[2];              // Viewport center
     float vpHalf[2];                // Viewport half dimensions
@@ -888,6 +1097,9 @@ typedef struct {
     sw_vertex_t vertexBuffer[SW_MAX_CLIPPED_POLYGON_VERTICES];  // Buffer used for storing primitive vertices, used for processing and rendering
     int vertexCounter;                                          // Number of vertices in 'ctx.vertexBuffer'
 
+    sw_vertex_t vertexCache[SW_VERTEX_CACHE_SIZE];              // Transformed vertices of the current swDrawElements() call
+    uint32_t vertexCacheTags[SW_VERTEX_CACHE_SIZE];             // Array index of each cached vertex (UINT32_MAX if empty)
+
     SWdraw drawMode;                                            // Current primitive mode (e.g., lines, triangles)
     SWpoly polyMode;                                            // Current polygon filling mode (e.g., lines, triangles) 
     int reqVertices;                                            // Number of vertices required for the primitive being drawn
@@ -910,6 +1122,7 @@ typedef struct {
 
     sw_factor_f srcFactorFunc;
     sw_factor_f dstFactorFunc;
+    sw_blend_mode_t blendMode;                                  // Fixed-point blend path selected from the factors
 
     SWface cullFace;                                            // Faces to cull
     SWerrcode errCode;                                          // Last error code
@@ -921,6 +1134,11 @@ typedef struct {
     int freeTextureIdCount;
 
     uint32_t stateFlags;
+
+#if defined(SW_SUPPORT_MULTITHREADING)
+    sw_binning_t binning;                                       // Binned rendering mode data
+    bool deferred;                                              // Primitives are recorded and sorted even with a single thread
+#endif
 } sw_context_t;
 
 //----------------------------------------------------------------------------------
@@ -1005,6 +1223,16 @@ static inline int sw_clampi(int v, int min, int max)
     return v;
 }
 
+static inline int sw_mini(int a, int b)
+{
+    return (a < b)? a : b;
+}
+
+static inline int sw_maxi(int a, int b)
+{
+    return (a > b)? a : b;
+}
+
 static inline void sw_lerp_vertex_PTCH(sw_vertex_t *SW_RESTRICT out, const sw_vertex_t *SW_RESTRICT a, const sw_vertex_t *SW_RESTRICT b, float t)
 {
     const float tInv = 1.0f - t;
@@ -1263,9 +1491,11 @@ static inline bool sw_framebuffer_load(int w, int h)
 {
     int size = w*h;
 
-    RLSW.framebuffer.pixels = SW_MALLOC(sizeof(sw_pixel_t)*size);
-    if (RLSW.framebuffer.pixels == NULL) return false;
+    RLSW.framebuffer.colorInternal = (sw_color_t *)SW_MALLOC(sizeof(sw_color_t)*size);
+    RLSW.framebuffer.depth = (sw_depth_t *)SW_MALLOC(sizeof(sw_depth_t)*size);
+    if ((RLSW.framebuffer.colorInternal == NULL) || (RLSW.framebuffer.depth == NULL)) return false;
 
+    RLSW.framebuffer.color = RLSW.framebuffer.colorInternal;
     RLSW.framebuffer.width = w;
     RLSW.framebuffer.height = h;
     RLSW.framebuffer.allocSz = size;
@@ -1277,6 +1507,9 @@ static inline bool sw_framebuffer_resize(int w, int h)
 {
     int newSize = w*h;
 
+    // External color storage has a fixed size, the internal one is used again
+    RLSW.framebuffer.color = RLSW.framebuffer.colorInternal;
+
     if (newSize <= RLSW.framebuffer.allocSz)
     {
         RLSW.framebuffer.width = w;
@@ -1284,10 +1517,16 @@ static inline bool sw_framebuffer_resize(int w, int h)
         return true;
     }
 
-    void *newPixels = SW_REALLOC(RLSW.framebuffer.pixels, sizeof(sw_pixel_t)*newSize);
-    if (newPixels == NULL) return false;
+    void *newColor = SW_REALLOC(RLSW.framebuffer.colorInternal, sizeof(sw_color_t)*newSize);
+    if (newColor == NULL) return false;
+
+    RLSW.framebuffer.colorInternal = (sw_color_t *)newColor;
+    RLSW.framebuffer.color = RLSW.framebuffer.colorInternal;
 
-    RLSW.framebuffer.pixels = newPixels;
+    void *newDepth = SW_REALLOC(RLSW.framebuffer.depth, sizeof(sw_depth_t)*newSize);
+    if (newDepth == NULL) return false;
+
+    RLSW.framebuffer.depth = (sw_depth_t *)newDepth;
 
     RLSW.framebuffer.width = w;
     RLSW.framebuffer.height = h;
@@ -1296,7 +1535,7 @@ static inline bool sw_framebuffer_resize(int w, int h)
     return true;
 }
 
-static inline void sw_framebuffer_read_color(float dst[4], const sw_pixel_t *src)
+static inline void sw_framebuffer_read_color(float dst[4], const sw_color_t *src)
 {
 #if SW_COLOR_IS_PACKED
     SW_COLOR_TYPE pixel = src->color[0];
@@ -1306,10 +1545,15 @@ static inline void sw_framebuffer_read_color(float dst[4], const sw_pixel_t *src
     dst[3] = 1.0f;
 #else
     sw_float_from_unorm8_simd(dst, src->color);
+    #if SW_COLOR_STORAGE_BGRA
+        float b = dst[0];
+        dst[0] = dst[2];
+        dst[2] = b;
+    #endif
 #endif
 }
 
-static inline void sw_framebuffer_read_color8(uint8_t dst[4], const sw_pixel_t *src)
+static inline void sw_framebuffer_read_color8(uint8_t dst[4], const sw_color_t *src)
 {
 #if SW_COLOR_IS_PACKED
     SW_COLOR_TYPE pixel = src->color[0];
@@ -1317,6 +1561,12 @@ static inline void sw_framebuffer_read_color8(uint8_t dst[4], const sw_pixel_t *
     dst[1] = SW_SCALE_G(SW_UNPACK_G(pixel));
     dst[2] = SW_SCALE_B(SW_UNPACK_B(pixel));
     dst[3] = 255;
+#elif SW_COLOR_STORAGE_BGRA
+    const SW_COLOR_TYPE *p = src->color;
+    dst[0] = p[2];
+    dst[1] = p[1];
+    dst[2] = p[0];
+    dst[3] = p[3];
 #else
     const SW_COLOR_TYPE *p = src->color;
     dst[0] = p[0];
@@ -1326,7 +1576,7 @@ static inline void sw_framebuffer_read_color8(uint8_t dst[4], const sw_pixel_t *
 #endif
 }
 
-static inline float sw_framebuffer_read_depth(const sw_pixel_t *src)
+static inline float sw_framebuffer_read_depth(const sw_depth_t *src)
 {
 #if SW_DEPTH_IS_PACKED
     return src->depth[0]*SW_DEPTH_SCALE;
@@ -1335,16 +1585,19 @@ static inline float sw_framebuffer_read_depth(const sw_pixel_t *src)
 #endif
 }
 
-static inline void sw_framebuffer_write_color(sw_pixel_t *dst, const float src[4])
+static inline void sw_framebuffer_write_color(sw_color_t *dst, const float src[4])
 {
 #if SW_COLOR_IS_PACKED
     dst->color[0] = SW_PACK_COLOR(src[0], src[1], src[2]);
+#elif SW_COLOR_STORAGE_BGRA
+    const float bgra[4] = { src[2], src[1], src[0], src[3] };
+    sw_float_to_unorm8_simd(dst->color, bgra);
 #else
     sw_float_to_unorm8_simd(dst->color, src);
 #endif
 }
 
-static inline void sw_framebuffer_write_depth(sw_pixel_t *dst, float depth)
+static inline void sw_framebuffer_write_depth(sw_depth_t *dst, float depth)
 {
     depth = sw_saturate(depth); // REVIEW: An overflow can occur in certain circumstances with clipping, and needs to be reviewed...
 
@@ -1357,91 +1610,144 @@ static inline void sw_framebuffer_write_depth(sw_pixel_t *dst, float depth)
 #endif
 }
 
-static inline void sw_framebuffer_fill_color(sw_pixel_t *ptr, int size, const SW_COLOR_TYPE color[SW_COLOR_PACK_COMP])
+// Planes are cleared and copied 16 bytes at a time when SIMD is available
+#if defined(SW_HAS_SSE2) || defined(SW_HAS_NEON) || defined(SW_HAS_NEON_FMA)
+    #define SW_FRAMEBUFFER_SIMD
+#endif
+
+#if defined(SW_FRAMEBUFFER_SIMD)
+// Fill a span of bytes with a repeated 32-bit pattern
+// NOTE: The pattern is the plane element replicated, so element size must divide 4 bytes
+static inline void sw_framebuffer_fill_span(void *dst, int bytes, uint32_t pattern)
 {
-    if (RLSW.stateFlags & SW_STATE_SCISSOR_TEST)
+    union { uint32_t word; uint8_t bytes[4]; } p = { pattern }, r;
+    uint8_t *ptr = (uint8_t *)dst;
+    uint8_t *end = ptr + bytes;
+
+    // Head, up to the first 16-byte aligned address
+    int head = (int)((16 - ((uintptr_t)ptr & 15)) & 15);
+    if (head > bytes) head = bytes;
+    for (int i = 0; i < head; i++) *ptr++ = p.bytes[i & 3];
+
+    // Pattern rotated to the phase reached after the head
+    for (int i = 0; i < 4; i++) r.bytes[i] = p.bytes[(head + i) & 3];
+
+#if defined(SW_HAS_SSE2)
+    __m128i v = _mm_set1_epi32((int)r.word);
+    for (; end - ptr >= 64; ptr += 64)
     {
-        int w = RLSW.scMax[0] - RLSW.scMin[0] + 1;
-        for (int y = RLSW.scMin[1]; y <= RLSW.scMax[1]; y++)
-        {
-            sw_pixel_t *row = ptr + y*RLSW.framebuffer.width + RLSW.scMin[0];
-            for (int x = 0; x < w; x++, row++)
-            {
-                for (int i = 0; i < SW_COLOR_PACK_COMP; i++) row->color[i] = color[i];
-            }
-        }
+        _mm_store_si128((__m128i *)ptr, v);
+        _mm_store_si128((__m128i *)(ptr + 16), v);
+        _mm_store_si128((__m128i *)(ptr + 32), v);
+        _mm_store_si128((__m128i *)(ptr + 48), v);
     }
-    else
+    for (; end - ptr >= 16; ptr += 16) _mm_store_si128((__m128i *)ptr, v);
+#else
+    uint8x16_t v = vreinterpretq_u8_u32(vdupq_n_u32(r.word));
+    for (; end - ptr >= 64; ptr += 64)
     {
-        for (int i = 0; i < size; i++, ptr++)
-        {
-            for (int j = 0; j < SW_COLOR_PACK_COMP; j++) ptr->color[j] = color[j];
-        }
+        vst1q_u8(ptr, v);
+        vst1q_u8(ptr + 16, v);
+        vst1q_u8(ptr + 32, v);
+        vst1q_u8(ptr + 48, v);
     }
+    for (; end - ptr >= 16; ptr += 16) vst1q_u8(ptr, v);
+#endif
+
+    // Tail, the phase is unchanged since the body is a multiple of 4 bytes
+    for (int i = 0; ptr < end; i++) *ptr++ = r.bytes[i & 3];
 }
+#endif // SW_FRAMEBUFFER_SIMD
 
-static inline void sw_framebuffer_fill_depth(sw_pixel_t *ptr, int size, const SW_DEPTH_TYPE depth[SW_DEPTH_PACK_COMP])
+static inline void sw_framebuffer_fill_color(sw_color_t *ptr, int size, sw_color_t value)
 {
+    // Whole plane as a single span, or one span per scissor row
+    int x = 0, y = 0, w = size, h = 1;
+
     if (RLSW.stateFlags & SW_STATE_SCISSOR_TEST)
     {
-        int w = RLSW.scMax[0] - RLSW.scMin[0] + 1;
-        for (int y = RLSW.scMin[1]; y <= RLSW.scMax[1]; y++)
-        {
-            sw_pixel_t *row = ptr + y*RLSW.framebuffer.width + RLSW.scMin[0];
-            for (int x = 0; x < w; x++, row++)
-            {
-                for (int i = 0; i < SW_DEPTH_PACK_COMP; i++) row->depth[i] = depth[i];
-            }
-        }
+        x = RLSW.scMin[0];
+        y = RLSW.scMin[1];
+        w = RLSW.scMax[0] - RLSW.scMin[0] + 1;
+        h = RLSW.scMax[1] - RLSW.scMin[1] + 1;
     }
-    else
+
+#if defined(SW_FRAMEBUFFER_SIMD)
+    union { uint32_t word; sw_color_t color[4/sizeof(sw_color_t)]; } pattern;
+    for (int i = 0; i < (int)(4/sizeof(sw_color_t)); i++) pattern.color[i] = value;
+
+    for (int iy = 0; iy < h; iy++)
     {
-        for (int i = 0; i < size; i++, ptr++)
-        {
-            for (int j = 0; j < SW_DEPTH_PACK_COMP; j++) ptr->depth[j] = depth[j];
-        }
+        sw_color_t *row = ptr + (y + iy)*RLSW.framebuffer.width + x;
+        sw_framebuffer_fill_span(row, w*(int)sizeof(sw_color_t), pattern.word);
+    }
+#else
+    for (int iy = 0; iy < h; iy++)
+    {
+        sw_color_t *row = ptr + (y + iy)*RLSW.framebuffer.width + x;
+        for (int ix = 0; ix < w; ix++, row++) *row = value;
     }
+#endif
 }
 
-static inline void sw_framebuffer_fill(sw_pixel_t *ptr, int size, sw_pixel_t value)
+static inline void sw_framebuffer_fill_depth(sw_depth_t *ptr, int size, sw_depth_t value)
 {
+    // Whole plane as a single span, or one span per scissor row
+    int x = 0, y = 0, w = size, h = 1;
+
     if (RLSW.stateFlags & SW_STATE_SCISSOR_TEST)
     {
-        int w = RLSW.scMax[0] - RLSW.scMin[0] + 1;
-        for (int y = RLSW.scMin[1]; y <= RLSW.scMax[1]; y++)
-        {
-            sw_pixel_t *row = ptr + y*RLSW.framebuffer.width + RLSW.scMin[0];
-            for (int x = 0; x < w; x++, row++) *row = value;
-        }
+        x = RLSW.scMin[0];
+        y = RLSW.scMin[1];
+        w = RLSW.scMax[0] - RLSW.scMin[0] + 1;
+        h = RLSW.scMax[1] - RLSW.scMin[1] + 1;
     }
-    else
+
+#if defined(SW_FRAMEBUFFER_SIMD) && (SW_DEPTH_PACK_COMP == 1)
+    union { uint32_t word; sw_depth_t depth[4/sizeof(sw_depth_t)]; } pattern;
+    for (int i = 0; i < (int)(4/sizeof(sw_depth_t)); i++) pattern.depth[i] = value;
+
+    for (int iy = 0; iy < h; iy++)
+    {
+        sw_depth_t *row = ptr + (y + iy)*RLSW.framebuffer.width + x;
+        sw_framebuffer_fill_span(row, w*(int)sizeof(sw_depth_t), pattern.word);
+    }
+#else
+    // NOTE: 24-bit depth is three bytes per element, it does not replicate into a word
+    for (int iy = 0; iy < h; iy++)
     {
-        for (int i = 0; i < size; i++, ptr++) *ptr = value;
+        sw_depth_t *row = ptr + (y + iy)*RLSW.framebuffer.width + x;
+        for (int ix = 0; ix < w; ix++, row++) *row = value;
     }
+#endif
 }
 
-static inline void sw_framebuffer_copy_fast(void* dst)
+// Copy the whole color plane, only when the destination format is the storage format
+static inline void sw_framebuffer_copy_fast(void *dst)
 {
     int size = RLSW.framebuffer.width*RLSW.framebuffer.height;
-    const sw_pixel_t *pixels = RLSW.framebuffer.pixels;
+    const sw_color_t *src = RLSW.framebuffer.color;
+    sw_color_t *dstColor = (sw_color_t *)dst;
 
-#if SW_COLOR_BUFFER_BITS == 8
-    uint8_t *dst8 = (uint8_t*)dst;
-    for (int i = 0; i < size; i++) dst8[i] = pixels[i].color[0];
-#elif SW_COLOR_BUFFER_BITS == 16
-    uint16_t *dst16 = (uint16_t*)dst;
-    for (int i = 0; i < size; i++) dst16[i] = *(uint16_t*)pixels[i].color;
-#else // 32 bits
-    uint32_t *dst32 = (uint32_t*)dst;
-    #if SW_GL_FRAMEBUFFER_COPY_BGRA
-        for (int i = 0; i < size; i++)
-        {
-            const uint8_t *c = pixels[i].color;
-            dst32[i] = (uint32_t)c[2] | ((uint32_t)c[1] << 8) | ((uint32_t)c[0] << 16) | ((uint32_t)c[3] << 24);
-        }
-    #else // RGBA
-        for (int i = 0; i < size; i++) dst32[i] = *(uint32_t*)pixels[i].color;
+    if (dstColor == src) return; // External color storage, already up to date
+
+#if defined(SW_FRAMEBUFFER_SIMD)
+    const uint8_t *srcBytes = (const uint8_t *)src;
+    uint8_t *dstBytes = (uint8_t *)dst;
+    int bytes = size*(int)sizeof(sw_color_t);
+    int i = 0;
+
+    for (; i + 16 <= bytes; i += 16)
+    {
+    #if defined(SW_HAS_SSE2)
+        _mm_storeu_si128((__m128i *)(dstBytes + i), _mm_loadu_si128((const __m128i *)(srcBytes + i)));
+    #else
+        vst1q_u8(dstBytes + i, vld1q_u8(srcBytes + i));
     #endif
+    }
+    for (; i < bytes; i++) dstBytes[i] = srcBytes[i];
+#else
+    for (int i = 0; i < size; i++) dstColor[i] = src[i];
 #endif
 }
 
@@ -1449,10 +1755,10 @@ static inline void sw_framebuffer_copy_fast(void* dst)
 static inline void sw_framebuffer_copy_to_##name(int x, int y, int w, int h, DST_PTR_T *dst) \
 {                                                                               \
     const int stride = RLSW.framebuffer.width;                                  \
-    const sw_pixel_t *src = RLSW.framebuffer.pixels + (y*stride + x);           \
+    const sw_color_t *src = RLSW.framebuffer.color + (y*stride + x);            \
                                                                                 \
     for (int iy = 0; iy < h; iy++) {                                            \
-        const sw_pixel_t *line = src;                                           \
+        const sw_color_t *line = src;                                           \
         for (int ix = 0; ix < w; ix++) {                                        \
             uint8_t color[4];                                                   \
             sw_framebuffer_read_color8(color, line);                            \
@@ -1574,7 +1880,7 @@ static inline void sw_framebuffer_blit_to_##name(
     int xSrc, int ySrc, int wSrc, int hSrc,                                     \
     DST_PTR_T *dst)                                                             \
 {                                                                               \
-    const sw_pixel_t *srcBase = RLSW.framebuffer.pixels;                        \
+    const sw_color_t *srcBase = RLSW.framebuffer.color;                         \
     const int fbWidth = RLSW.framebuffer.width;                                 \
                                                                                 \
     const uint32_t xScale = ((uint32_t)wSrc << 16)/(uint32_t)wDst;              \
@@ -1583,13 +1889,13 @@ static inline void sw_framebuffer_blit_to_##name(
     for (int dy = 0; dy < hDst; dy++) {                                         \
         uint32_t yFix = ((uint32_t)ySrc << 16) + dy*yScale;                     \
         int sy = yFix >> 16;                                                    \
-        const sw_pixel_t *srcLine = srcBase + sy*fbWidth + xSrc;                \
+        const sw_color_t *srcLine = srcBase + sy*fbWidth + xSrc;                \
                                                                                 \
-        const sw_pixel_t *srcPtr = srcLine;                                     \
+        const sw_color_t *srcPtr = srcLine;                                     \
         for (int dx = 0; dx < wDst; dx++) {                                     \
             uint32_t xFix = dx*xScale;                                          \
             int sx = xFix >> 16;                                                \
-            const sw_pixel_t *pixel = srcPtr + sx;                              \
+            const sw_color_t *pixel = srcPtr + sx;                              \
             uint8_t color[4];                                                   \
             sw_framebuffer_read_color8(color, pixel);
 
@@ -1700,6 +2006,160 @@ DEFINE_FRAMEBUFFER_BLIT_BEGIN(R8G8B8A8, uint8_t)
 DEFINE_FRAMEBUFFER_BLIT_END()
 //-------------------------------------------------------------------------------------------
 
+// Hierarchical depth functions
+// NOTE: Each tile keeps an upper bound of its depths, used to reject primitives behind it.
+// Depth tested writes only bring pixels closer, so once every pixel of a tile has been written
+// the farthest depth written meanwhile becomes the new bound, without reading the depth buffer
+//-------------------------------------------------------------------------------------------
+// Start a new write coverage, pixels outside of the framebuffer are considered written
+static inline void sw_hiz_reset_coverage(sw_hiz_tile_t *tile, int x, int y)
+{
+    int w = RLSW.framebuffer.width - (x & ~(SW_HIZ_TILE_SIZE - 1));
+    int h = RLSW.framebuffer.height - (y & ~(SW_HIZ_TILE_SIZE - 1));
+    uint64_t rowMask = (w < 8)? ((1ULL << w) - 1) : 0xFFULL;
+    uint64_t mask = 0;
+
+    for (int i = 0; i < sw_mini(h, 8); i++) mask |= rowMask << (i*8);
+
+    tile->coverage = ~mask;
+    tile->writeMaxDepth = 0.0f;
+}
+
+// Set the bound of the tiles overlapping [xMin, xMax)x[yMin, yMax)
+static inline void sw_hiz_set_rect(int xMin, int yMin, int xMax, int yMax, float maxDepth)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    xMin = sw_maxi(xMin, 0);
+    yMin = sw_maxi(yMin, 0);
+    xMax = sw_mini(xMax, RLSW.framebuffer.width);
+    yMax = sw_mini(yMax, RLSW.framebuffer.height);
+    if ((xMin >= xMax) || (yMin >= yMax)) return;
+
+    for (int ty = yMin/SW_HIZ_TILE_SIZE; ty <= (yMax - 1)/SW_HIZ_TILE_SIZE; ty++)
+    {
+        for (int tx = xMin/SW_HIZ_TILE_SIZE; tx <= (xMax - 1)/SW_HIZ_TILE_SIZE; tx++)
+        {
+            sw_hiz_tile_t *tile = &RLSW.framebuffer.hiz[ty*RLSW.framebuffer.hizWidth + tx];
+            tile->maxDepth = maxDepth;
+            sw_hiz_reset_coverage(tile, tx*SW_HIZ_TILE_SIZE, ty*SW_HIZ_TILE_SIZE);
+        }
+    }
+#else
+    (void)xMin; (void)yMin; (void)xMax; (void)yMax; (void)maxDepth;
+#endif
+}
+
+// Invalidate the tiles overlapping [xMin, xMax)x[yMin, yMax), written without depth test
+static inline void sw_hiz_invalidate_rect(int xMin, int yMin, int xMax, int yMax)
+{
+    sw_hiz_set_rect(xMin, yMin, xMax, yMax, SW_HIZ_DEPTH_UNKNOWN);
+}
+
+static inline bool sw_hiz_resize(int w, int h)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    int hizWidth = (w + SW_HIZ_TILE_SIZE - 1)/SW_HIZ_TILE_SIZE;
+    int hizHeight = (h + SW_HIZ_TILE_SIZE - 1)/SW_HIZ_TILE_SIZE;
+    int size = hizWidth*hizHeight;
+
+    if (size > RLSW.framebuffer.hizAllocSz)
+    {
+        void *newTiles = SW_REALLOC(RLSW.framebuffer.hiz, sizeof(sw_hiz_tile_t)*size);
+        if (newTiles == NULL) return false;
+        RLSW.framebuffer.hiz = newTiles;
+        RLSW.framebuffer.hizAllocSz = size;
+    }
+
+    RLSW.framebuffer.hizWidth = hizWidth;
+    RLSW.framebuffer.hizHeight = hizHeight;
+
+    sw_hiz_invalidate_rect(0, 0, w, h);
+#else
+    (void)w; (void)h;
+#endif
+    return true;
+}
+
+static inline sw_hiz_tile_t *sw_hiz_get_tile(int x, int y)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    return &RLSW.framebuffer.hiz[(y/SW_HIZ_TILE_SIZE)*RLSW.framebuffer.hizWidth + x/SW_HIZ_TILE_SIZE];
+#else
+    (void)x; (void)y;
+    return NULL;
+#endif
+}
+
+// Invalidate the tile containing (x, y), written without depth test
+static inline void sw_hiz_invalidate(sw_hiz_tile_t *tile, int x, int y)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    tile->maxDepth = SW_HIZ_DEPTH_UNKNOWN;
+    sw_hiz_reset_coverage(tile, x, y);
+#else
+    (void)tile; (void)x; (void)y;
+#endif
+}
+
+// Update the tile containing (x, y) after a depth tested write of 'depth'
+static inline void sw_hiz_write(sw_hiz_tile_t *tile, int x, int y, float depth)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    tile->coverage |= 1ULL << (((y & 7) << 3) | (x & 7));
+    if (depth > tile->writeMaxDepth) tile->writeMaxDepth = depth;
+
+    if (tile->coverage == ~0ULL)
+    {
+        // Depths are quantized when stored, the bound is taken from the stored value
+        sw_depth_t stored;
+        sw_framebuffer_write_depth(&stored, tile->writeMaxDepth);
+        float maxDepth = sw_framebuffer_read_depth(&stored);
+
+        if (maxDepth < tile->maxDepth) tile->maxDepth = maxDepth;
+        sw_hiz_reset_coverage(tile, x, y);
+    }
+#else
+    (void)tile; (void)x; (void)y; (void)depth;
+#endif
+}
+
+// Check if a depth is behind all the pixels of a tile
+static inline bool sw_hiz_is_occluded(const sw_hiz_tile_t *tile, float depth)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    return (depth > tile->maxDepth);
+#else
+    (void)tile; (void)depth;
+    return false;
+#endif
+}
+
+// Check if a depth is behind all the tiles overlapping [xMin, xMax]x[yMin, yMax]
+static inline bool sw_hiz_is_rect_occluded(int xMin, int yMin, int xMax, int yMax, float depth)
+{
+#if defined(SW_HIERARCHICAL_DEPTH)
+    xMin = sw_maxi(xMin, 0)/SW_HIZ_TILE_SIZE;
+    yMin = sw_maxi(yMin, 0)/SW_HIZ_TILE_SIZE;
+    xMax = sw_mini(xMax, RLSW.framebuffer.width - 1)/SW_HIZ_TILE_SIZE;
+    yMax = sw_mini(yMax, RLSW.framebuffer.height - 1)/SW_HIZ_TILE_SIZE;
+
+    for (int ty = yMin; ty <= yMax; ty++)
+    {
+        const sw_hiz_tile_t *row = RLSW.framebuffer.hiz + ty*RLSW.framebuffer.hizWidth;
+        for (int tx = xMin; tx <= xMax; tx++)
+        {
+            if (depth <= row[tx].maxDepth) return false;
+        }
+    }
+
+    return true;
+#else
+    (void)xMin; (void)yMin; (void)xMax; (void)yMax; (void)depth;
+    return false;
+#endif
+}
+//-------------------------------------------------------------------------------------------
+
 // Pixel format management functions
 //-------------------------------------------------------------------------------------------
 static inline int sw_get_pixel_format(SWformat format, SWtype type)
@@ -1892,29 +2352,65 @@ static inline void sw_get_pixel(uint8_t *color, const void *pixels, uint32_t off
 
 // Texture sampling functionality
 //-------------------------------------------------------------------------------------------
-static inline void sw_texture_fetch(float* color, const sw_texture_t* tex, int x, int y)
+// Get the texel index of (x, y) in the level pixels
+static inline int sw_texture_texel_index(const sw_mipmap_t *mip, int x, int y)
+{
+#if defined(SW_TEXTURE_TILED)
+    // Tiles of 4x4 texels are stored contiguously, in row-major order, and texels are
+    // row-major inside a tile: (y/4)*tileStride + (x/4)*16 + (y%4)*4 + (x%4)
+    return (y >> 2)*mip->tileStride + ((x & ~3) << 2) + ((y & 3) << 2) + (x & 3);
+#else
+    return y*mip->width + x;
+#endif
+}
+
+// Get the number of texels to allocate for a level, tiled levels are padded to full tiles
+static inline int sw_texture_texel_count(int width, int height)
+{
+#if defined(SW_TEXTURE_TILED)
+    return ((width + 3) & ~3)*((height + 3) & ~3);
+#else
+    return width*height;
+#endif
+}
+
+static inline void sw_texture_init_mipmap(sw_mipmap_t *mip, uint8_t *pixels, int width, int height)
+{
+    mip->pixels = pixels;
+    mip->width = width;
+    mip->height = height;
+    mip->wMinus1 = width - 1;
+    mip->hMinus1 = height - 1;
+    mip->tileStride = ((width + 3) & ~3)*4;
+}
+
+static inline void sw_texture_fetch(float* color, const sw_mipmap_t* mip, int x, int y)
 {
-    sw_float_from_unorm8_simd(color, &tex->pixels[4*(y*tex->width + x)]);
+    sw_float_from_unorm8_simd(color, &mip->pixels[4*sw_texture_texel_index(mip, x, y)]);
 }
 
-static inline void sw_texture_sample_nearest(float *color, const sw_texture_t *tex, float u, float v)
+static inline void sw_texture_sample_nearest(float *color, const sw_texture_t *tex, const sw_mipmap_t *mip, float u, float v)
 {
     u = (tex->sWrap == SW_REPEAT)? sw_fract(u) : sw_saturate(u);
     v = (tex->tWrap == SW_REPEAT)? sw_fract(v) : sw_saturate(v);
 
-    int x = u*tex->width;
-    int y = v*tex->height;
+    int x = u*mip->width;
+    int y = v*mip->height;
+
+    // NOTE: Saturated coordinates can reach the level size
+    if (x > mip->wMinus1) x = mip->wMinus1;
+    if (y > mip->hMinus1) y = mip->hMinus1;
 
-    sw_texture_fetch(color, tex, x, y);
+    sw_texture_fetch(color, mip, x, y);
 }
 
-static inline void sw_texture_sample_linear(float *color, const sw_texture_t *tex, float u, float v)
+static inline void sw_texture_sample_linear(float *color, const sw_texture_t *tex, const sw_mipmap_t *mip, float u, float v)
 {
     // TODO: With a bit more cleverness we could clearly reduce the
     // number of operations here, but for now it works fine.
 
-    float xf = (u*tex->width) - 0.5f;
-    float yf = (v*tex->height) - 0.5f;
+    float xf = (u*mip->width) - 0.5f;
+    float yf = (v*mip->height) - 0.5f;
 
     float fx = sw_fract(xf);
     float fy = sw_fract(yf);
@@ -1929,31 +2425,31 @@ static inline void sw_texture_sample_linear(float *color, const sw_texture_t *te
 
     if (tex->sWrap == SW_CLAMP)
     {
-        x0 = (x0 > tex->wMinus1)? tex->wMinus1 : x0;
-        x1 = (x1 > tex->wMinus1)? tex->wMinus1 : x1;
+        x0 = (x0 > mip->wMinus1)? mip->wMinus1 : x0;
+        x1 = (x1 > mip->wMinus1)? mip->wMinus1 : x1;
     }
     else
     {
-        x0 = (x0%tex->width + tex->width)%tex->width;
-        x1 = (x1%tex->width + tex->width)%tex->width;
+        x0 = (x0%mip->width + mip->width)%mip->width;
+        x1 = (x1%mip->width + mip->width)%mip->width;
     }
 
     if (tex->tWrap == SW_CLAMP)
     {
-        y0 = (y0 > tex->hMinus1)? tex->hMinus1 : y0;
-        y1 = (y1 > tex->hMinus1)? tex->hMinus1 : y1;
+        y0 = (y0 > mip->hMinus1)? mip->hMinus1 : y0;
+        y1 = (y1 > mip->hMinus1)? mip->hMinus1 : y1;
     }
     else
     {
-        y0 = (y0%tex->height + tex->height)%tex->height;
-        y1 = (y1%tex->height + tex->height)%tex->height;
+        y0 = (y0%mip->height + mip->height)%mip->height;
+        y1 = (y1%mip->height + mip->height)%mip->height;
     }
 
     float c00[4], c10[4], c01[4], c11[4];
-    sw_texture_fetch(c00, tex, x0, y0);
-    sw_texture_fetch(c10, tex, x1, y0);
-    sw_texture_fetch(c01, tex, x0, y1);
-    sw_texture_fetch(c11, tex, x1, y1);
+    sw_texture_fetch(c00, mip, x0, y0);
+    sw_texture_fetch(c10, mip, x1, y0);
+    sw_texture_fetch(c01, mip, x0, y1);
+    sw_texture_fetch(c11, mip, x1, y1);
 
     for (int i = 0; i < 4; i++)
     {
@@ -1963,28 +2459,87 @@ static inline void sw_texture_sample_linear(float *color, const sw_texture_t *te
     }
 }
 
-static inline void sw_texture_sample(float *color, const sw_texture_t *tex, float u, float v, float dUdx, float dUdy, float dVdx, float dVdy)
+static inline void sw_texture_sample_level(float *color, const sw_texture_t *tex, int level, bool linear, float u, float v)
 {
-    // Previous method: There is no need to compute the square root
-    // because using the squared value, the comparison remains `L2 > 1.0f*1.0f`
-    //float du = sqrtf(dUdx*dUdx + dUdy*dUdy);
-    //float dv = sqrtf(dVdx*dVdx + dVdy*dVdy);
-    //float L = (du > dv)? du : dv;
+    if (linear) sw_texture_sample_linear(color, tex, &tex->mipmaps[level], u, v);
+    else sw_texture_sample_nearest(color, tex, &tex->mipmaps[level], u, v);
+}
 
-    // Calculate the derivatives for each axis
-    float dU2 = dUdx*dUdx + dUdy*dUdy;
-    float dV2 = dVdx*dVdx + dVdy*dVdy;
-    float L2 = (dU2 > dV2)? dU2 : dV2;
+static inline void sw_texture_sample(float *color, const sw_texture_t *tex, float u, float v, float dUdx, float dUdy, float dVdx, float dVdy)
+{
+    // Derivatives are scaled to base level texels, so the level of detail is
+    // lod = log2(rho), with rho the largest texel footprint along x or y
+    // NOTE: There is no need to compute the square roots, lod = 0.5f*log2(rho^2)
+    // and magnification is selected when rho^2 <= 1.0f
+    float w = (float)tex->width;
+    float h = (float)tex->height;
+    float rhoX2 = (dUdx*w)*(dUdx*w) + (dVdx*h)*(dVdx*h);
+    float rhoY2 = (dUdy*w)*(dUdy*w) + (dVdy*h)*(dVdy*h);
+    float rho2 = (rhoX2 > rhoY2)? rhoX2 : rhoY2;
+
+    if (rho2 <= 1.0f)
+    {
+        sw_texture_sample_level(color, tex, 0, (tex->magFilter == SW_LINEAR), u, v);
+        return;
+    }
 
-    SWfilter filter = (L2 > 1.0f)? tex->minFilter : tex->magFilter;
+    int maxLevel = tex->mipmapCount - 1;
 
-    switch (filter)
+    switch (tex->minFilter)
     {
-        case SW_NEAREST: sw_texture_sample_nearest(color, tex, u, v); break;
-        case SW_LINEAR: sw_texture_sample_linear(color, tex, u, v); break;
+        case SW_NEAREST: sw_texture_sample_level(color, tex, 0, false, u, v); break;
+        case SW_LINEAR: sw_texture_sample_level(color, tex, 0, true, u, v); break;
+        case SW_NEAREST_MIPMAP_NEAREST:
+        case SW_LINEAR_MIPMAP_NEAREST:
+        {
+            int level = (int)(0.5f*log2f(rho2) + 0.5f);
+            if (level > maxLevel) level = maxLevel;
+
+            sw_texture_sample_level(color, tex, level, (tex->minFilter == SW_LINEAR_MIPMAP_NEAREST), u, v);
+        } break;
+        case SW_NEAREST_MIPMAP_LINEAR:
+        case SW_LINEAR_MIPMAP_LINEAR:
+        {
+            bool linear = (tex->minFilter == SW_LINEAR_MIPMAP_LINEAR);
+            float lod = 0.5f*log2f(rho2);
+            int level = (int)lod;
+
+            if (level >= maxLevel)
+            {
+                sw_texture_sample_level(color, tex, maxLevel, linear, u, v);
+                break;
+            }
+
+            // Blend between the two nearest levels
+            float c0[4], c1[4];
+            float t = lod - (float)level;
+            sw_texture_sample_level(c0, tex, level, linear, u, v);
+            sw_texture_sample_level(c1, tex, level + 1, linear, u, v);
+
+            for (int i = 0; i < 4; i++) color[i] = c0[i] + t*(c1[i] - c0[i]);
+        } break;
         default: break;
     }
 }
+
+// Release texture pixels of all mipmap levels
+// NOTE: Textures never uploaded share the default texture pixels, those are not freed
+static inline void sw_texture_free(sw_texture_t *tex)
+{
+    const uint8_t *defaultPixels = RLSW.loadedTextures[0].pixels;
+
+    for (int i = 1; i < tex->mipmapCount; i++)
+    {
+        if (tex->mipmaps[i].pixels != defaultPixels) SW_FREE(tex->mipmaps[i].pixels);
+        tex->mipmaps[i].pixels = NULL;
+    }
+
+    if (tex->pixels != defaultPixels) SW_FREE(tex->pixels);
+
+    tex->pixels = NULL;
+    tex->mipmaps[0].pixels = NULL;
+    tex->mipmapCount = 0;
+}
 //-------------------------------------------------------------------------------------------
 
 // Color blending functionality
@@ -2061,6 +2616,75 @@ static inline void sw_blend_colors(float *SW_RESTRICT dst/*[4]*/, const float *S
     dst[2] = srcFactor[2]*src[2] + dstFactor[2]*dst[2];
     dst[3] = srcFactor[3]*src[3] + dstFactor[3]*dst[3];
 }
+
+// Divide a sum of 8-bit products by 255 with rounding
+// NOTE: Division by a constant, compiled to a multiply and shift
+static inline uint32_t sw_div255(uint32_t x)
+{
+    return (x + 127)/255;
+}
+
+// Blend a source color into a framebuffer pixel
+// NOTE: The common blend modes are done in fixed-point on RGBA8 and RGB565 framebuffers,
+// without per-pixel factor function calls, any other case uses the float path
+static inline void sw_blend_pixel(sw_color_t *ptr, const float src[4])
+{
+#if (SW_COLOR_BUFFER_BITS == 32) || (SW_COLOR_BUFFER_BITS == 16)
+    if (RLSW.blendMode != SW_BLEND_MODE_GENERIC)
+    {
+        uint8_t s[4], d[4];
+        sw_float_to_unorm8_simd(s, src);
+        sw_framebuffer_read_color8(d, ptr);
+
+        uint32_t a = s[3];
+        uint32_t ia = 255 - a;
+        uint32_t r[4];
+
+        switch (RLSW.blendMode)
+        {
+            case SW_BLEND_MODE_ALPHA:
+            {
+                for (int i = 0; i < 4; i++) r[i] = sw_div255(s[i]*a + d[i]*ia);
+            } break;
+            case SW_BLEND_MODE_ADDITIVE:
+            {
+                for (int i = 0; i < 4; i++) r[i] = sw_div255(s[i]*a) + d[i];
+            } break;
+            case SW_BLEND_MODE_ADD_COLORS:
+            {
+                for (int i = 0; i < 4; i++) r[i] = s[i] + d[i];
+            } break;
+            case SW_BLEND_MODE_MULTIPLIED:
+            {
+                for (int i = 0; i < 4; i++) r[i] = sw_div255(d[i]*(s[i] + ia));
+            } break;
+            case SW_BLEND_MODE_PREMULTIPLIED:
+            {
+                for (int i = 0; i < 4; i++) r[i] = s[i] + sw_div255(d[i]*ia);
+            } break;
+            default: break;
+        }
+
+    #if (SW_COLOR_BUFFER_BITS == 32)
+        ptr->color[SW_COLOR_STORAGE_BGRA? 2 : 0] = (uint8_t)sw_mini(r[0], 255);
+        ptr->color[1] = (uint8_t)sw_mini(r[1], 255);
+        ptr->color[SW_COLOR_STORAGE_BGRA? 0 : 2] = (uint8_t)sw_mini(r[2], 255);
+        ptr->color[3] = (uint8_t)sw_mini(r[3], 255);
+    #else
+        uint32_t r5 = (sw_mini(r[0], 255)*31 + 127)/255;
+        uint32_t g6 = (sw_mini(r[1], 255)*63 + 127)/255;
+        uint32_t b5 = (sw_mini(r[2], 255)*31 + 127)/255;
+        ptr->color[0] = (uint16_t)((r5 << 11) | (g6 << 5) | b5);
+    #endif
+        return;
+    }
+#endif
+
+    float dstColor[4];
+    sw_framebuffer_read_color(dstColor, ptr);
+    sw_blend_colors(dstColor, src);
+    sw_framebuffer_write_color(ptr, dstColor);
+}
 //-------------------------------------------------------------------------------------------
 
 // Projection helper functions
@@ -2191,6 +2815,14 @@ static inline bool sw_polygon_clip(sw_vertex_t polygon[SW_MAX_CLIPPED_POLYGON_VE
     return (n >= 3);
 }
 
+#if defined(SW_SUPPORT_MULTITHREADING)
+// Binned rendering functions, defined after the raster functions they dispatch to
+static void sw_binning_push_triangle(uint32_t state, const sw_vertex_t *v0, const sw_vertex_t *v1, const sw_vertex_t *v2, const sw_texture_t *tex);
+static void sw_binning_push_quad(uint32_t state, const sw_vertex_t *vertices, const sw_texture_t *tex);
+static void sw_binning_push_line(uint32_t state, const sw_vertex_t *v0, const sw_vertex_t *v1);
+static void sw_binning_push_point(uint32_t state, const sw_vertex_t *v);
+#endif
+
 // Triangle rendering logic
 //-------------------------------------------------------------------------------------------
 static inline bool sw_triangle_face_culling(void)
@@ -2334,35 +2966,70 @@ static inline void FUNC_NAME(const sw_texture_t *tex, const sw_vertex_t *start,
                                                                                     \
     /* Pre-calculate the starting pointers for the framebuffer row */               \
     int y = (int)start->screen[1];                                                  \
-    sw_pixel_t *ptr = RLSW.framebuffer.pixels + y*RLSW.framebuffer.width + xStart;  \
+    int offset = y*RLSW.framebuffer.width + xStart;                                 \
+    sw_color_t *cptr = RLSW.framebuffer.color + offset;                             \
+    sw_depth_t *dptr = RLSW.framebuffer.depth + offset;                             \
                                                                                     \
     /* Scanline rasterization */                                                    \
+    sw_hiz_tile_t *hizTile = NULL;                                                  \
     for (int x = xStart; x < xEnd; x++)                                             \
     {                                                                               \
-        float wRcp = 1.0f/w;                                                        \
-        float srcColor[4] = {                                                       \
-            color[0]*wRcp,                                                          \
-            color[1]*wRcp,                                                          \
-            color[2]*wRcp,                                                          \
-            color[3]*wRcp                                                           \
-        };                                                                          \
+        /* Hierarchical depth test once per tile, occluded runs are skipped */      \
+        if ((x == xStart) || ((x & (SW_HIZ_TILE_SIZE - 1)) == 0))                   \
+        {                                                                           \
+            hizTile = sw_hiz_get_tile(x, y);                                        \
+            if (ENABLE_DEPTH_TEST)                                                  \
+            {                                                                       \
+                int run = sw_mini((x | (SW_HIZ_TILE_SIZE - 1)) + 1, xEnd) - x;      \
+                float zMin = fminf(z, z + dZdx*(run - 1));                          \
+                if (sw_hiz_is_occluded(hizTile, zMin))                              \
+                {                                                                   \
+                    z += dZdx*run;                                                  \
+                    w += dWdx*run;                                                  \
+                    color[0] += dCdx[0]*run;                                        \
+                    color[1] += dCdx[1]*run;                                        \
+                    color[2] += dCdx[2]*run;                                        \
+                    color[3] += dCdx[3]*run;                                        \
+                    if (ENABLE_TEXTURE)                                             \
+                    {                                                               \
+                        u += dUdx*run;                                              \
+                        v += dVdx*run;                                              \
+                    }                                                               \
+                    cptr += run;                                                    \
+                    dptr += run;                                                    \
+                    x += run - 1;                                                   \
+                    continue;                                                       \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
                                                                                     \
+        /* Depth is only updated when tested, as in GL */                           \
         if (ENABLE_DEPTH_TEST)                                                      \
         {                                                                           \
             /* TODO: Implement different depth funcs? */                            \
-            float depth =  sw_framebuffer_read_depth(ptr);                          \
+            float depth =  sw_framebuffer_read_depth(dptr);                         \
             if (z > depth) goto discard;                                            \
+            sw_hiz_write(hizTile, x, y, z);                                         \
+            sw_framebuffer_write_depth(dptr, z);                                    \
         }                                                                           \
                                                                                     \
-        /* TODO: Implement depth mask */                                            \
-        sw_framebuffer_write_depth(ptr, z);                                         \
+        /* Perspective correction, only for the pixels passing the depth test */    \
+        float wRcp = 1.0f/w;                                                        \
+        float srcColor[4] = {                                                       \
+            color[0]*wRcp,                                                          \
+            color[1]*wRcp,                                                          \
+            color[2]*wRcp,                                                          \
+            color[3]*wRcp                                                           \
+        };                                                                          \
                                                                                     \
         if (ENABLE_TEXTURE)                                                         \
         {                                                                           \
             float texColor[4];                                                      \
             float s = u*wRcp;                                                       \
             float t = v*wRcp;                                                       \
-            sw_texture_sample(texColor, tex, s, t, dUdx, dUdy, dVdx, dVdy);         \
+            /* Gradients of u/w scaled by w approximate the texcoord gradients */  \
+            sw_texture_sample(texColor, tex, s, t, dUdx*wRcp, dUdy*wRcp,            \
+                              dVdx*wRcp, dVdy*wRcp);                                \
             srcColor[0] *= texColor[0];                                             \
             srcColor[1] *= texColor[1];                                             \
             srcColor[2] *= texColor[2];                                             \
@@ -2371,14 +3038,11 @@ static inline void FUNC_NAME(const sw_texture_t *tex, const sw_vertex_t *start,
                                                                                     \
         if (ENABLE_COLOR_BLEND)                                                     \
         {                                                                           \
-            float dstColor[4];                                                      \
-            sw_framebuffer_read_color(dstColor, ptr);                               \
-            sw_blend_colors(dstColor, srcColor);                                    \
-            sw_framebuffer_write_color(ptr, dstColor);                              \
+            sw_blend_pixel(cptr, srcColor);                                         \
         }                                                                           \
         else                                                                        \
         {                                                                           \
-            sw_framebuffer_write_color(ptr, srcColor);                              \
+            sw_framebuffer_write_color(cptr, srcColor);                             \
         }                                                                           \
                                                                                     \
         /* Increment the interpolation parameter, UVs, and pointers */              \
@@ -2394,13 +3058,17 @@ static inline void FUNC_NAME(const sw_texture_t *tex, const sw_vertex_t *start,
             u += dUdx;                                                              \
             v += dVdx;                                                              \
         }                                                                           \
-        ++ptr;                                                                      \
+        ++cptr;                                                                     \
+        ++dptr;                                                                     \
     }                                                                               \
 }
 
-#define DEFINE_TRIANGLE_RASTER(FUNC_NAME, FUNC_SCANLINE, ENABLE_TEXTURE)            \
+// NOTE: Only the rows in [bandMin, bandMax) are rasterized, the edges are still walked from the
+// top vertex so the interpolated values are identical whatever the band is (required by binned mode)
+#define DEFINE_TRIANGLE_RASTER(FUNC_NAME, FUNC_SCANLINE, ENABLE_TEXTURE, ENABLE_DEPTH_TEST) \
 static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1,          \
-                             const sw_vertex_t *v2, const sw_texture_t *tex)        \
+                             const sw_vertex_t *v2, const sw_texture_t *tex,        \
+                             int bandMin, int bandMax)                              \
 {                                                                                   \
     /* Swap vertices by increasing y */                                             \
     if (v0->screen[1] > v1->screen[1]) { const sw_vertex_t *tmp = v0; v0 = v1; v1 = tmp; } \
@@ -2419,6 +3087,18 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1,
                                                                                     \
     if (h02 < 1e-6f) return;                                                        \
                                                                                     \
+    /* Whole triangle rejection against the hierarchical depth */                   \
+    if (ENABLE_DEPTH_TEST)                                                          \
+    {                                                                               \
+        float zMin = fminf(v0->homogeneous[2], v1->homogeneous[2]);                 \
+        zMin = fminf(zMin, v2->homogeneous[2]);                                     \
+        int xMin = (int)fminf(x0, fminf(x1, x2));                                   \
+        int xMax = (int)fmaxf(x0, fmaxf(x1, x2));                                   \
+        int yMin = sw_maxi((int)y0, bandMin);                                       \
+        int yMax = sw_mini((int)y2, bandMax - 1);                                   \
+        if (sw_hiz_is_rect_occluded(xMin, yMin, xMax, yMax, zMin)) return;          \
+    }                                                                               \
+                                                                                    \
     /* Precompute the inverse values without additional checks */                   \
     float h02Rcp = 1.0f/h02;                                                        \
     float h01Rcp = (h01 > 1e-6f)? 1.0f/h01 : 0.0f;                                  \
@@ -2455,10 +3135,14 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1,
     /* Scanline for the upper part of the triangle */                               \
     for (int y = yTop; y < yMid; y++)                                               \
     {                                                                               \
-        vLeft.screen[1] = vRight.screen[1] = y;                                     \
+        if (y >= bandMax) return;                                                   \
+        if (y >= bandMin)                                                           \
+        {                                                                           \
+            vLeft.screen[1] = vRight.screen[1] = y;                                 \
                                                                                     \
-        if (vLeft.screen[0] < vRight.screen[0]) FUNC_SCANLINE(tex, &vLeft, &vRight, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
-        else FUNC_SCANLINE(tex, &vRight, &vLeft, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
+            if (vLeft.screen[0] < vRight.screen[0]) FUNC_SCANLINE(tex, &vLeft, &vRight, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
+            else FUNC_SCANLINE(tex, &vRight, &vLeft, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
+        }                                                                           \
                                                                                     \
         sw_add_vertex_grad_PTCH(&vLeft, &dVXdy02);                                  \
         vLeft.screen[0] += dXdy02;                                                  \
@@ -2475,10 +3159,14 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1,
     /* Scanline for the lower part of the triangle */                               \
     for (int y = yMid; y < yBot; y++)                                               \
     {                                                                               \
-        vLeft.screen[1] = vRight.screen[1] = y;                                     \
+        if (y >= bandMax) return;                                                   \
+        if (y >= bandMin)                                                           \
+        {                                                                           \
+            vLeft.screen[1] = vRight.screen[1] = y;                                 \
                                                                                     \
-        if (vLeft.screen[0] < vRight.screen[0]) FUNC_SCANLINE(tex, &vLeft, &vRight, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
-        else FUNC_SCANLINE(tex, &vRight, &vLeft, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
+            if (vLeft.screen[0] < vRight.screen[0]) FUNC_SCANLINE(tex, &vLeft, &vRight, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
+            else FUNC_SCANLINE(tex, &vRight, &vLeft, dVXdy02.texcoord[0], dVXdy02.texcoord[1]); \
+        }                                                                           \
                                                                                     \
         sw_add_vertex_grad_PTCH(&vLeft, &dVXdy02);                                  \
         vLeft.screen[0] += dXdy02;                                                  \
@@ -2488,6 +3176,318 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1,
     }                                                                               \
 }
 
+#if defined(SW_RASTER_HALFSPACE)
+// Pixel block lanes used by the half-space rasterizer
+// NOTE: Blocks are made of 2x2 pixel quads, two quads side by side when AVX2 is available
+#if defined(SW_HAS_AVX2)
+    #define SW_BLOCK_LANES  8
+    #define SW_BLOCK_WIDTH  4
+
+    typedef __m256 sw_lanes_t;
+
+    static inline sw_lanes_t sw_lanes_set1(float x) { return _mm256_set1_ps(x); }
+    static inline sw_lanes_t sw_lanes_load(const float *src) { return _mm256_load_ps(src); }
+    static inline void sw_lanes_store(float *dst, sw_lanes_t v) { _mm256_store_ps(dst, v); }
+    static inline sw_lanes_t sw_lanes_add(sw_lanes_t a, sw_lanes_t b) { return _mm256_add_ps(a, b); }
+    static inline sw_lanes_t sw_lanes_mul(sw_lanes_t a, sw_lanes_t b) { return _mm256_mul_ps(a, b); }
+    static inline sw_lanes_t sw_lanes_div(sw_lanes_t a, sw_lanes_t b) { return _mm256_div_ps(a, b); }
+#if defined(SW_HAS_FMA_AVX2)
+    static inline sw_lanes_t sw_lanes_madd(sw_lanes_t a, sw_lanes_t b, sw_lanes_t c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+    static inline sw_lanes_t sw_lanes_madd(sw_lanes_t a, sw_lanes_t b, sw_lanes_t c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+    static inline int sw_lanes_mask_ge(sw_lanes_t a, sw_lanes_t b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)); }
+    static inline int sw_lanes_mask_gt(sw_lanes_t a, sw_lanes_t b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+#elif defined(SW_HAS_SSE2)
+    #define SW_BLOCK_LANES  4
+    #define SW_BLOCK_WIDTH  2
+
+    typedef __m128 sw_lanes_t;
+
+    static inline sw_lanes_t sw_lanes_set1(float x) { return _mm_set1_ps(x); }
+    static inline sw_lanes_t sw_lanes_load(const float *src) { return _mm_load_ps(src); }
+    static inline void sw_lanes_store(float *dst, sw_lanes_t v) { _mm_store_ps(dst, v); }
+    static inline sw_lanes_t sw_lanes_add(sw_lanes_t a, sw_lanes_t b) { return _mm_add_ps(a, b); }
+    static inline sw_lanes_t sw_lanes_mul(sw_lanes_t a, sw_lanes_t b) { return _mm_mul_ps(a, b); }
+    static inline sw_lanes_t sw_lanes_div(sw_lanes_t a, sw_lanes_t b) { return _mm_div_ps(a, b); }
+    static inline sw_lanes_t sw_lanes_madd(sw_lanes_t a, sw_lanes_t b, sw_lanes_t c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static inline int sw_lanes_mask_ge(sw_lanes_t a, sw_lanes_t b) { return _mm_movemask_ps(_mm_cmpge_ps(a, b)); }
+    static inline int sw_lanes_mask_gt(sw_lanes_t a, sw_lanes_t b) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+#elif defined(SW_HAS_NEON) || defined(SW_HAS_NEON_FMA)
+    #define SW_BLOCK_LANES  4
+    #define SW_BLOCK_WIDTH  2
+
+    typedef float32x4_t sw_lanes_t;
+
+    static inline sw_lanes_t sw_lanes_set1(float x) { return vdupq_n_f32(x); }
+    static inline sw_lanes_t sw_lanes_load(const float *src) { return vld1q_f32(src); }
+    static inline void sw_lanes_store(float *dst, sw_lanes_t v) { vst1q_f32(dst, v); }
+    static inline sw_lanes_t sw_lanes_add(sw_lanes_t a, sw_lanes_t b) { return vaddq_f32(a, b); }
+    static inline sw_lanes_t sw_lanes_mul(sw_lanes_t a, sw_lanes_t b) { return vmulq_f32(a, b); }
+#if defined(__aarch64__)
+    static inline sw_lanes_t sw_lanes_div(sw_lanes_t a, sw_lanes_t b) { return vdivq_f32(a, b); }
+#else
+    static inline sw_lanes_t sw_lanes_div(sw_lanes_t a, sw_lanes_t b)
+    {
+        // No division on ARMv7 NEON, reciprocal estimate refined with two Newton-Raphson steps
+        float32x4_t r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+    }
+#endif
+#if defined(SW_HAS_NEON_FMA)
+    static inline sw_lanes_t sw_lanes_madd(sw_lanes_t a, sw_lanes_t b, sw_lanes_t c) { return vfmaq_f32(c, a, b); }
+#else
+    static inline sw_lanes_t sw_lanes_madd(sw_lanes_t a, sw_lanes_t b, sw_lanes_t c) { return vmlaq_f32(c, a, b); }
+#endif
+    static inline int sw_lanes_movemask(uint32x4_t m)
+    {
+        static const uint32_t bits[4] = { 1, 2, 4, 8 };
+        uint32_t lanes[4];
+        vst1q_u32(lanes, vandq_u32(m, vld1q_u32(bits)));
+        return (int)(lanes[0] | lanes[1] | lanes[2] | lanes[3]);
+    }
+    static inline int sw_lanes_mask_ge(sw_lanes_t a, sw_lanes_t b) { return sw_lanes_movemask(vcgeq_f32(a, b)); }
+    static inline int sw_lanes_mask_gt(sw_lanes_t a, sw_lanes_t b) { return sw_lanes_movemask(vcgtq_f32(a, b)); }
+#else
+    #define SW_BLOCK_LANES  4
+    #define SW_BLOCK_WIDTH  2
+
+    typedef struct { float v[4]; } sw_lanes_t;
+
+    static inline sw_lanes_t sw_lanes_set1(float x) { sw_lanes_t r = { { x, x, x, x } }; return r; }
+    static inline sw_lanes_t sw_lanes_load(const float *src) { sw_lanes_t r = { { src[0], src[1], src[2], src[3] } }; return r; }
+    static inline void sw_lanes_store(float *dst, sw_lanes_t v) { for (int i = 0; i < 4; i++) dst[i] = v.v[i]; }
+    static inline sw_lanes_t sw_lanes_add(sw_lanes_t a, sw_lanes_t b) { for (int i = 0; i < 4; i++) a.v[i] += b.v[i]; return a; }
+    static inline sw_lanes_t sw_lanes_mul(sw_lanes_t a, sw_lanes_t b) { for (int i = 0; i < 4; i++) a.v[i] *= b.v[i]; return a; }
+    static inline sw_lanes_t sw_lanes_div(sw_lanes_t a, sw_lanes_t b) { for (int i = 0; i < 4; i++) a.v[i] /= b.v[i]; return a; }
+    static inline sw_lanes_t sw_lanes_madd(sw_lanes_t a, sw_lanes_t b, sw_lanes_t c) { for (int i = 0; i < 4; i++) c.v[i] += a.v[i]*b.v[i]; return c; }
+    static inline int sw_lanes_mask_ge(sw_lanes_t a, sw_lanes_t b) { int m = 0; for (int i = 0; i < 4; i++) m |= (a.v[i] >= b.v[i]) << i; return m; }
+    static inline int sw_lanes_mask_gt(sw_lanes_t a, sw_lanes_t b) { int m = 0; for (int i = 0; i < 4; i++) m |= (a.v[i] > b.v[i]) << i; return m; }
+#endif
+
+#define SW_BLOCK_MASK_ALL   ((1 << SW_BLOCK_LANES) - 1)
+
+// Pixel offsets of each lane relative to the block origin
+#if (SW_BLOCK_LANES == 8)
+static const int sw_blockLaneX[8] = { 0, 1, 0, 1, 2, 3, 2, 3 };
+static const int sw_blockLaneY[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
+static SW_ALIGN(32) const float sw_blockLaneXf[8] = { 0, 1, 0, 1, 2, 3, 2, 3 };
+static SW_ALIGN(32) const float sw_blockLaneYf[8] = { 0, 0, 1, 1, 0, 0, 1, 1 };
+#else
+static const int sw_blockLaneX[4] = { 0, 1, 0, 1 };
+static const int sw_blockLaneY[4] = { 0, 0, 1, 1 };
+static SW_ALIGN(16) const float sw_blockLaneXf[4] = { 0, 1, 0, 1 };
+static SW_ALIGN(16) const float sw_blockLaneYf[4] = { 0, 0, 1, 1 };
+#endif
+
+// Get the mask of block lanes inside [xMin, xMax]x[yMin, yMax]
+static inline int sw_block_bounds_mask(int bx, int by, int xMin, int xMax, int yMin, int yMax)
+{
+    int mask = 0;
+
+    for (int i = 0; i < SW_BLOCK_LANES; i++)
+    {
+        int x = bx + sw_blockLaneX[i];
+        int y = by + sw_blockLaneY[i];
+        if ((x >= xMin) && (x <= xMax) && (y >= yMin) && (y <= yMax)) mask |= (1 << i);
+    }
+
+    return mask;
+}
+
+// Edge function (half-space) triangle rasterization
+// NOTE: Coverage and attributes are evaluated per pixel from the triangle planes over
+// SW_BLOCK_LANES wide pixel blocks, then depth test, texturing and blending are done for
+// each covered lane. Pixel (x, y) is sampled at (x + 1, y + 1) in screen space, because
+// the projection already adds the half pixel offset, which matches the scanline rasterizer
+#define DEFINE_TRIANGLE_RASTER_HALFSPACE(FUNC_NAME, ENABLE_TEXTURE, ENABLE_DEPTH_TEST, ENABLE_COLOR_BLEND) \
+static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1,          \
+                             const sw_vertex_t *v2, const sw_texture_t *tex,        \
+                             int bandMin, int bandMax)                              \
+{                                                                                   \
+    /* Get a positive signed area, swapping vertices if required */                 \
+    float area = (v1->screen[0] - v0->screen[0])*(v2->screen[1] - v0->screen[1]) -  \
+                 (v2->screen[0] - v0->screen[0])*(v1->screen[1] - v0->screen[1]);   \
+    if (area < 0.0f) { const sw_vertex_t *tmp = v1; v1 = v2; v2 = tmp; area = -area; } \
+    if (area < 1e-6f) return;                                                       \
+    float areaRcp = 1.0f/area;                                                      \
+                                                                                    \
+    float x0 = v0->screen[0], y0 = v0->screen[1];                                   \
+    float x1 = v1->screen[0], y1 = v1->screen[1];                                   \
+    float x2 = v2->screen[0], y2 = v2->screen[1];                                   \
+                                                                                    \
+    /* Pixel bounds, clamped to the framebuffer and the band */                     \
+    int xMin = sw_clampi((int)floorf(fminf(x0, fminf(x1, x2))) - 1, 0, RLSW.framebuffer.width - 1); \
+    int xMax = sw_clampi((int)ceilf(fmaxf(x0, fmaxf(x1, x2))) - 1, 0, RLSW.framebuffer.width - 1); \
+    int yMin = sw_clampi((int)floorf(fminf(y0, fminf(y1, y2))) - 1, bandMin, bandMax - 1); \
+    int yMax = sw_clampi((int)ceilf(fmaxf(y0, fmaxf(y1, y2))) - 1, bandMin, bandMax - 1); \
+    if ((xMin > xMax) || (yMin > yMax) || (bandMin >= bandMax)) return;             \
+                                                                                    \
+    /* Whole triangle rejection against the hierarchical depth */                   \
+    if (ENABLE_DEPTH_TEST)                                                          \
+    {                                                                               \
+        float zMin = fminf(v0->homogeneous[2], v1->homogeneous[2]);                 \
+        zMin = fminf(zMin, v2->homogeneous[2]);                                     \
+        if (sw_hiz_is_rect_occluded(xMin, yMin, xMax, yMax, zMin)) return;          \
+    }                                                                               \
+                                                                                    \
+    /* Edge functions relative to v0, E(p) = A*(p.x - x0) + B*(p.y - y0) + C */     \
+    const float *ea[3] = { v0->screen, v1->screen, v2->screen };                    \
+    const float *eb[3] = { v1->screen, v2->screen, v0->screen };                    \
+    sw_lanes_t edgeA[3], edgeB[3], edgeC[3];                                        \
+    bool edgeTopLeft[3];                                                            \
+    for (int i = 0; i < 3; i++)                                                     \
+    {                                                                               \
+        float a = ea[i][1] - eb[i][1];                                              \
+        float b = eb[i][0] - ea[i][0];                                              \
+        edgeA[i] = sw_lanes_set1(a);                                                \
+        edgeB[i] = sw_lanes_set1(b);                                                \
+        edgeC[i] = sw_lanes_set1(a*(x0 - ea[i][0]) + b*(y0 - ea[i][1]));            \
+        edgeTopLeft[i] = (a > 0.0f) || ((a == 0.0f) && (b > 0.0f));                 \
+    }                                                                               \
+                                                                                    \
+    /* Attribute planes: depth, 1/w, color/w and texcoord/w */                      \
+    float attr0[8], dAdx[8], dAdy[8];                                               \
+    const int attrCount = (ENABLE_TEXTURE)? 8 : 6;                                  \
+    const sw_vertex_t *vs[3] = { v0, v1, v2 };                                      \
+    for (int i = 0; i < 3; i++)                                                     \
+    {                                                                               \
+        float *dst = (i == 0)? attr0 : (i == 1)? dAdx : dAdy;                       \
+        dst[0] = vs[i]->homogeneous[2];                                             \
+        dst[1] = vs[i]->homogeneous[3];                                             \
+        dst[2] = vs[i]->color[0];                                                   \
+        dst[3] = vs[i]->color[1];                                                   \
+        dst[4] = vs[i]->color[2];                                                   \
+        dst[5] = vs[i]->color[3];                                                   \
+        dst[6] = vs[i]->texcoord[0];                                                \
+        dst[7] = vs[i]->texcoord[1];                                                \
+    }                                                                               \
+    for (int i = 0; i < 8; i++)                                                     \
+    {                                                                               \
+        float d1 = dAdx[i] - attr0[i];                                              \
+        float d2 = dAdy[i] - attr0[i];                                              \
+        dAdx[i] = (d1*(y2 - y0) - d2*(y1 - y0))*areaRcp;                            \
+        dAdy[i] = (d2*(x1 - x0) - d1*(x2 - x0))*areaRcp;                            \
+    }                                                                               \
+                                                                                    \
+    sw_lanes_t laneX = sw_lanes_load(sw_blockLaneXf);                               \
+    sw_lanes_t laneY = sw_lanes_load(sw_blockLaneYf);                               \
+    sw_lanes_t zero = sw_lanes_set1(0.0f);                                          \
+    sw_lanes_t one = sw_lanes_set1(1.0f);                                           \
+                                                                                    \
+    const int fbWidth = RLSW.framebuffer.width;                                     \
+    sw_color_t *colors = RLSW.framebuffer.color;                                    \
+    sw_depth_t *depths = RLSW.framebuffer.depth;                                    \
+                                                                                    \
+    /* Blocks are aligned to their width, never straddling two depth tiles */       \
+    for (int by = yMin & ~1; by <= yMax; by += 2)                                   \
+    {                                                                               \
+        sw_lanes_t py = sw_lanes_add(laneY, sw_lanes_set1((float)by + 1.0f - y0));  \
+                                                                                    \
+        for (int bx = xMin & ~(SW_BLOCK_WIDTH - 1); bx <= xMax; bx += SW_BLOCK_WIDTH) \
+        {                                                                           \
+            sw_lanes_t px = sw_lanes_add(laneX, sw_lanes_set1((float)bx + 1.0f - x0)); \
+                                                                                    \
+            /* Coverage test with top-left fill rule */                             \
+            int mask = SW_BLOCK_MASK_ALL;                                           \
+            for (int i = 0; (i < 3) && (mask != 0); i++)                            \
+            {                                                                       \
+                sw_lanes_t e = sw_lanes_madd(edgeA[i], px, sw_lanes_madd(edgeB[i], py, edgeC[i])); \
+                mask &= edgeTopLeft[i]? sw_lanes_mask_ge(e, zero) : sw_lanes_mask_gt(e, zero); \
+            }                                                                       \
+                                                                                    \
+            if ((bx < xMin) || (bx + SW_BLOCK_WIDTH - 1 > xMax) || (by < yMin) || (by + 1 > yMax)) \
+            {                                                                       \
+                mask &= sw_block_bounds_mask(bx, by, xMin, xMax, yMin, yMax);       \
+            }                                                                       \
+                                                                                    \
+            if (mask == 0) continue;                                                \
+                                                                                    \
+            /* Interpolate attributes, perspective correction on all lanes */       \
+            SW_ALIGN(32) float attr[8][SW_BLOCK_LANES];                             \
+            sw_lanes_store(attr[0], sw_lanes_madd(sw_lanes_set1(dAdx[0]), px,       \
+                sw_lanes_madd(sw_lanes_set1(dAdy[0]), py, sw_lanes_set1(attr0[0]))));\
+                                                                                    \
+            /* Hierarchical depth test, blocks never straddle two tiles */          \
+            sw_hiz_tile_t *hizTile = sw_hiz_get_tile(bx, by);                       \
+            if (ENABLE_DEPTH_TEST)                                                  \
+            {                                                                       \
+                float zMin = 1.0f;                                                  \
+                for (int l = 0; l < SW_BLOCK_LANES; l++)                            \
+                {                                                                   \
+                    if (mask & (1 << l)) zMin = fminf(zMin, attr[0][l]);            \
+                }                                                                   \
+                if (sw_hiz_is_occluded(hizTile, zMin)) continue;                    \
+            }                                                                       \
+                                                                                    \
+            for (int i = 1; i < attrCount; i++)                                     \
+            {                                                                       \
+                sw_lanes_t a = sw_lanes_madd(sw_lanes_set1(dAdx[i]), px,            \
+                    sw_lanes_madd(sw_lanes_set1(dAdy[i]), py, sw_lanes_set1(attr0[i]))); \
+                sw_lanes_store(attr[i], a);                                         \
+            }                                                                       \
+                                                                                    \
+            sw_lanes_t wRcp = sw_lanes_div(one, sw_lanes_load(attr[1]));            \
+            sw_lanes_store(attr[1], wRcp);                                          \
+            for (int i = 2; i < attrCount; i++)                                     \
+            {                                                                       \
+                sw_lanes_store(attr[i], sw_lanes_mul(sw_lanes_load(attr[i]), wRcp)); \
+            }                                                                       \
+                                                                                    \
+            for (int l = 0; l < SW_BLOCK_LANES; l++)                                \
+            {                                                                       \
+                if ((mask & (1 << l)) == 0) continue;                               \
+                                                                                    \
+                int offset = (by + sw_blockLaneY[l])*fbWidth + bx + sw_blockLaneX[l]; \
+                sw_color_t *cptr = colors + offset;                                 \
+                sw_depth_t *dptr = depths + offset;                                 \
+                float z = attr[0][l];                                               \
+                                                                                    \
+                if (ENABLE_DEPTH_TEST)                                              \
+                {                                                                   \
+                    float depth = sw_framebuffer_read_depth(dptr);                  \
+                    if (z > depth) continue;                                        \
+                    sw_hiz_write(hizTile, bx + sw_blockLaneX[l], by + sw_blockLaneY[l], z); \
+                    sw_framebuffer_write_depth(dptr, z);                            \
+                }                                                                   \
+                                                                                    \
+                float srcColor[4] = { attr[2][l], attr[3][l], attr[4][l], attr[5][l] }; \
+                                                                                    \
+                if (ENABLE_TEXTURE)                                                 \
+                {                                                                   \
+                    float texColor[4];                                              \
+                    float wl = attr[1][l];                                          \
+                    sw_texture_sample(texColor, tex, attr[6][l], attr[7][l],        \
+                                      dAdx[6]*wl, dAdy[6]*wl, dAdx[7]*wl, dAdy[7]*wl); \
+                    srcColor[0] *= texColor[0];                                     \
+                    srcColor[1] *= texColor[1];                                     \
+                    srcColor[2] *= texColor[2];                                     \
+                    srcColor[3] *= texColor[3];                                     \
+                }                                                                   \
+                                                                                    \
+                if (ENABLE_COLOR_BLEND)                                             \
+                {                                                                   \
+                    sw_blend_pixel(cptr, srcColor);                                 \
+                }                                                                   \
+                else sw_framebuffer_write_color(cptr, srcColor);                    \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+}
+#endif // SW_RASTER_HALFSPACE
+
+#if defined(SW_RASTER_HALFSPACE)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster, 0, 0, 0)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_TEX, 1, 0, 0)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_DEPTH, 0, 1, 0)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_BLEND, 0, 0, 1)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_TEX_DEPTH, 1, 1, 0)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_TEX_BLEND, 1, 0, 1)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_DEPTH_BLEND, 0, 1, 1)
+DEFINE_TRIANGLE_RASTER_HALFSPACE(sw_triangle_raster_TEX_DEPTH_BLEND, 1, 1, 1)
+#else
 DEFINE_TRIANGLE_RASTER_SCANLINE(sw_triangle_raster_scanline, 0, 0, 0)
 DEFINE_TRIANGLE_RASTER_SCANLINE(sw_triangle_raster_scanline_TEX, 1, 0, 0)
 DEFINE_TRIANGLE_RASTER_SCANLINE(sw_triangle_raster_scanline_DEPTH, 0, 1, 0)
@@ -2497,14 +3497,55 @@ DEFINE_TRIANGLE_RASTER_SCANLINE(sw_triangle_raster_scanline_TEX_BLEND, 1, 0, 1)
 DEFINE_TRIANGLE_RASTER_SCANLINE(sw_triangle_raster_scanline_DEPTH_BLEND, 0, 1, 1)
 DEFINE_TRIANGLE_RASTER_SCANLINE(sw_triangle_raster_scanline_TEX_DEPTH_BLEND, 1, 1, 1)
 
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster, sw_triangle_raster_scanline, false)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX, sw_triangle_raster_scanline_TEX, true)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_DEPTH, sw_triangle_raster_scanline_DEPTH, false)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_BLEND, sw_triangle_raster_scanline_BLEND, false)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH, sw_triangle_raster_scanline_TEX_DEPTH, true)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX_BLEND, sw_triangle_raster_scanline_TEX_BLEND, true)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_DEPTH_BLEND, sw_triangle_raster_scanline_DEPTH_BLEND, false)
-DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH_BLEND, sw_triangle_raster_scanline_TEX_DEPTH_BLEND, true)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster, sw_triangle_raster_scanline, false, false)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX, sw_triangle_raster_scanline_TEX, true, false)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_DEPTH, sw_triangle_raster_scanline_DEPTH, false, true)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_BLEND, sw_triangle_raster_scanline_BLEND, false, false)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH, sw_triangle_raster_scanline_TEX_DEPTH, true, true)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX_BLEND, sw_triangle_raster_scanline_TEX_BLEND, true, false)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_DEPTH_BLEND, sw_triangle_raster_scanline_DEPTH_BLEND, false, true)
+DEFINE_TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH_BLEND, sw_triangle_raster_scanline_TEX_DEPTH_BLEND, true, true)
+#endif
+
+static inline void sw_triangle_raster_ex(uint32_t state, const sw_vertex_t *v0, const sw_vertex_t *v1, const sw_vertex_t *v2,
+                                         const sw_texture_t *tex, int bandMin, int bandMax)
+{
+    if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_triangle_raster_TEX_DEPTH_BLEND(v0, v1, v2, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_triangle_raster_DEPTH_BLEND(v0, v1, v2, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_BLEND)) sw_triangle_raster_TEX_BLEND(v0, v1, v2, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST)) sw_triangle_raster_TEX_DEPTH(v0, v1, v2, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_triangle_raster_BLEND(v0, v1, v2, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_triangle_raster_DEPTH(v0, v1, v2, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D)) sw_triangle_raster_TEX(v0, v1, v2, tex, bandMin, bandMax);
+    else sw_triangle_raster(v0, v1, v2, tex, bandMin, bandMax);
+}
+
+static inline uint32_t sw_triangle_raster_state(void)
+{
+    uint32_t state = RLSW.stateFlags;
+    if (RLSW.currentTexture == 0) state &= ~SW_STATE_TEXTURE_2D;
+    if ((RLSW.srcFactor == SW_ONE) && (RLSW.dstFactor == SW_ZERO)) state &= ~SW_STATE_BLEND;
+
+    return state;
+}
+
+static inline void sw_triangle_fan_raster(uint32_t state)
+{
+    const sw_texture_t *tex = &RLSW.loadedTextures[RLSW.currentTexture];
+
+    for (int i = 0; i < RLSW.vertexCounter - 2; i++)
+    {
+#if defined(SW_SUPPORT_MULTITHREADING)
+        if (RLSW.binning.enabled)
+        {
+            sw_binning_push_triangle(state, &RLSW.vertexBuffer[0], &RLSW.vertexBuffer[i + 1], &RLSW.vertexBuffer[i + 2], tex);
+            continue;
+        }
+#endif
+        sw_triangle_raster_ex(state, &RLSW.vertexBuffer[0], &RLSW.vertexBuffer[i + 1],
+            &RLSW.vertexBuffer[i + 2], tex, 0, RLSW.framebuffer.height);
+    }
+}
 
 static inline void sw_triangle_render(void)
 {
@@ -2517,33 +3558,7 @@ static inline void sw_triangle_render(void)
 
     if (RLSW.vertexCounter < 3) return;
 
-    #define TRIANGLE_RASTER(RASTER_FUNC)                        \
-    {                                                           \
-        for (int i = 0; i < RLSW.vertexCounter - 2; i++)        \
-        {                                                       \
-            RASTER_FUNC(                                        \
-                &RLSW.vertexBuffer[0],                          \
-                &RLSW.vertexBuffer[i + 1],                      \
-                &RLSW.vertexBuffer[i + 2],                      \
-                &RLSW.loadedTextures[RLSW.currentTexture]       \
-            );                                                  \
-        }                                                       \
-    }
-
-    uint32_t state = RLSW.stateFlags;
-    if (RLSW.currentTexture == 0) state &= ~SW_STATE_TEXTURE_2D;
-    if ((RLSW.srcFactor == SW_ONE) && (RLSW.dstFactor == SW_ZERO)) state &= ~SW_STATE_BLEND;
-
-    if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_DEPTH_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_TEX_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST)) TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) TRIANGLE_RASTER(sw_triangle_raster_DEPTH)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D)) TRIANGLE_RASTER(sw_triangle_raster_TEX)
-    else TRIANGLE_RASTER(sw_triangle_raster)
-
-    #undef TRIANGLE_RASTER
+    sw_triangle_fan_raster(sw_triangle_raster_state());
 }
 //-------------------------------------------------------------------------------------------
 
@@ -2677,10 +3692,8 @@ static inline bool sw_quad_is_axis_aligned(void)
     return true;
 }
 
-static inline void sw_quad_sort_cw(const sw_vertex_t* *output)
+static inline void sw_quad_sort_cw(const sw_vertex_t* *output, const sw_vertex_t *input)
 {
-    const sw_vertex_t *input = RLSW.vertexBuffer;
-
     // Calculate the centroid of the quad
     float cx = (input[0].screen[0] + input[1].screen[0] + 
                 input[2].screen[0] + input[3].screen[0])*0.25f;
@@ -2719,10 +3732,11 @@ static inline void sw_quad_sort_cw(const sw_vertex_t* *output)
 // still appear perfectly aligned from a certain point of view?
 // Because in that case, we would still need to perform perspective division for textures and colors...
 #define DEFINE_QUAD_RASTER_AXIS_ALIGNED(FUNC_NAME, ENABLE_TEXTURE, ENABLE_DEPTH_TEST, ENABLE_COLOR_BLEND) \
-static inline void FUNC_NAME(void)                                              \
+static inline void FUNC_NAME(const sw_vertex_t *vertices, const sw_texture_t *tex, \
+                             int bandMin, int bandMax)                          \
 {                                                                               \
     const sw_vertex_t *sortedVerts[4];                                          \
-    sw_quad_sort_cw(sortedVerts);                                               \
+    sw_quad_sort_cw(sortedVerts, vertices);                                     \
                                                                                 \
     const sw_vertex_t *v0 = sortedVerts[0];                                     \
     const sw_vertex_t *v1 = sortedVerts[1];                                     \
@@ -2771,11 +3785,12 @@ static inline void FUNC_NAME(void)
     dZdx = (v1->homogeneous[2] - v0->homogeneous[2])*wRcp;                      \
     dZdy = (v3->homogeneous[2] - v0->homogeneous[2])*hRcp;                      \
                                                                                 \
-    /* Start of quad rasterization */                                           \
-    const sw_texture_t *tex;                                                    \
-    if (ENABLE_TEXTURE) tex = &RLSW.loadedTextures[RLSW.currentTexture];        \
+    /* Depth is written over the whole quad, its tiles must be recomputed */    \
+    if (ENABLE_DEPTH_TEST) sw_hiz_invalidate_rect(xMin, sw_maxi(yMin, bandMin), xMax, sw_mini(yMax, bandMax)); \
                                                                                 \
-    sw_pixel_t *pixels = RLSW.framebuffer.pixels;                               \
+    /* Start of quad rasterization */                                           \
+    sw_color_t *colors = RLSW.framebuffer.color;                                \
+    sw_depth_t *depths = RLSW.framebuffer.depth;                                \
     int wDst = RLSW.framebuffer.width;                                          \
                                                                                 \
     float zScanline = v0->homogeneous[2] + dZdx*xSubstep + dZdy*ySubstep;       \
@@ -2791,72 +3806,74 @@ static inline void FUNC_NAME(void)
                                                                                 \
     for (int y = yMin; y < yMax; y++)                                           \
     {                                                                           \
-        sw_pixel_t *ptr = pixels + y*wDst + xMin;                               \
-                                                                                \
-        float z = zScanline;                                                    \
-        float u = uScanline;                                                    \
-        float v = vScanline;                                                    \
+        /* Rows outside the band are skipped but still interpolated */          \
+        if (y >= bandMax) break;                                                \
+        if (y >= bandMin)                                                       \
+        {                                                                       \
+            sw_color_t *cptr = colors + y*wDst + xMin;                          \
+            sw_depth_t *dptr = depths + y*wDst + xMin;                          \
                                                                                 \
-        float color[4] = {                                                      \
-            colorScanline[0],                                                   \
-            colorScanline[1],                                                   \
-            colorScanline[2],                                                   \
-            colorScanline[3]                                                    \
-        };                                                                      \
+            float z = zScanline;                                                \
+            float u = uScanline;                                                \
+            float v = vScanline;                                                \
                                                                                 \
-        /* Scanline rasterization */                                            \
-        for (int x = xMin; x < xMax; x++)                                       \
-        {                                                                       \
-            /* Pixel color computation */                                       \
-            float srcColor[4] = {                                               \
-                color[0],                                                       \
-                color[1],                                                       \
-                color[2],                                                       \
-                color[3]                                                        \
+            float color[4] = {                                                  \
+                colorScanline[0],                                               \
+                colorScanline[1],                                               \
+                colorScanline[2],                                               \
+                colorScanline[3]                                                \
             };                                                                  \
                                                                                 \
-            /* Test and write depth */                                          \
-            if (ENABLE_DEPTH_TEST)                                              \
+            /* Scanline rasterization */                                        \
+            for (int x = xMin; x < xMax; x++)                                   \
             {                                                                   \
-                /* TODO: Implement different depth funcs? */                    \
-                float depth =  sw_framebuffer_read_depth(ptr);                  \
-                if (z > depth) goto discard;                                    \
-            }                                                                   \
+                /* Pixel color computation */                                   \
+                float srcColor[4] = {                                           \
+                    color[0],                                                   \
+                    color[1],                                                   \
+                    color[2],                                                   \
+                    color[3]                                                    \
+                };                                                              \
                                                                                 \
-            /* TODO: Implement depth mask */                                    \
-            sw_framebuffer_write_depth(ptr, z);                                 \
+                /* Test and write depth */                                      \
+                if (ENABLE_DEPTH_TEST)                                          \
+                {                                                               \
+                    /* TODO: Implement different depth funcs? */                \
+                    float depth =  sw_framebuffer_read_depth(dptr);             \
+                    if (z > depth) goto discard;                                \
+                    sw_framebuffer_write_depth(dptr, z);                        \
+                }                                                               \
                                                                                 \
-            if (ENABLE_TEXTURE)                                                 \
-            {                                                                   \
-                float texColor[4];                                              \
-                sw_texture_sample(texColor, tex, u, v, dUdx, dUdy, dVdx, dVdy); \
-                srcColor[0] *= texColor[0];                                     \
-                srcColor[1] *= texColor[1];                                     \
-                srcColor[2] *= texColor[2];                                     \
-                srcColor[3] *= texColor[3];                                     \
-            }                                                                   \
+                if (ENABLE_TEXTURE)                                             \
+                {                                                               \
+                    float texColor[4];                                          \
+                    sw_texture_sample(texColor, tex, u, v, dUdx, dUdy, dVdx, dVdy); \
+                    srcColor[0] *= texColor[0];                                 \
+                    srcColor[1] *= texColor[1];                                 \
+                    srcColor[2] *= texColor[2];                                 \
+                    srcColor[3] *= texColor[3];                                 \
+                }                                                               \
                                                                                 \
-            if (ENABLE_COLOR_BLEND)                                             \
-            {                                                                   \
-                float dstColor[4];                                              \
-                sw_framebuffer_read_color(dstColor, ptr);                       \
-                sw_blend_colors(dstColor, srcColor);                            \
-                sw_framebuffer_write_color(ptr, dstColor);                      \
-            }                                                                   \
-            else sw_framebuffer_write_color(ptr, srcColor);                     \
+                if (ENABLE_COLOR_BLEND)                                         \
+                {                                                               \
+                    sw_blend_pixel(cptr, srcColor);                             \
+                }                                                               \
+                else sw_framebuffer_write_color(cptr, srcColor);                \
                                                                                 \
-        discard:                                                                \
-            z += dZdx;                                                          \
-            color[0] += dCdx[0];                                                \
-            color[1] += dCdx[1];                                                \
-            color[2] += dCdx[2];                                                \
-            color[3] += dCdx[3];                                                \
-            if (ENABLE_TEXTURE)                                                 \
-            {                                                                   \
-                u += dUdx;                                                      \
-                v += dVdx;                                                      \
+            discard:                                                            \
+                z += dZdx;                                                      \
+                color[0] += dCdx[0];                                            \
+                color[1] += dCdx[1];                                            \
+                color[2] += dCdx[2];                                            \
+                color[3] += dCdx[3];                                            \
+                if (ENABLE_TEXTURE)                                             \
+                {                                                               \
+                    u += dUdx;                                                  \
+                    v += dVdx;                                                  \
+                }                                                               \
+                ++cptr;                                                         \
+                ++dptr;                                                         \
             }                                                                   \
-            ++ptr;                                                              \
         }                                                                       \
                                                                                 \
         zScanline += dZdy;                                                      \
@@ -2882,6 +3899,18 @@ DEFINE_QUAD_RASTER_AXIS_ALIGNED(sw_quad_raster_axis_aligned_TEX_BLEND, 1, 0, 1)
 DEFINE_QUAD_RASTER_AXIS_ALIGNED(sw_quad_raster_axis_aligned_DEPTH_BLEND, 0, 1, 1)
 DEFINE_QUAD_RASTER_AXIS_ALIGNED(sw_quad_raster_axis_aligned_TEX_DEPTH_BLEND, 1, 1, 1)
 
+static inline void sw_quad_raster_axis_aligned_ex(uint32_t state, const sw_vertex_t *vertices, const sw_texture_t *tex, int bandMin, int bandMax)
+{
+    if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_quad_raster_axis_aligned_TEX_DEPTH_BLEND(vertices, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_quad_raster_axis_aligned_DEPTH_BLEND(vertices, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_BLEND)) sw_quad_raster_axis_aligned_TEX_BLEND(vertices, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST)) sw_quad_raster_axis_aligned_TEX_DEPTH(vertices, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_quad_raster_axis_aligned_BLEND(vertices, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_quad_raster_axis_aligned_DEPTH(vertices, tex, bandMin, bandMax);
+    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D)) sw_quad_raster_axis_aligned_TEX(vertices, tex, bandMin, bandMax);
+    else sw_quad_raster_axis_aligned(vertices, tex, bandMin, bandMax);
+}
+
 static inline void sw_quad_render(void)
 {
     if (RLSW.stateFlags & SW_STATE_CULL_FACE)
@@ -2893,46 +3922,24 @@ static inline void sw_quad_render(void)
 
     if (RLSW.vertexCounter < 3) return;
 
-    uint32_t state = RLSW.stateFlags;
-    if (RLSW.currentTexture == 0) state &= ~SW_STATE_TEXTURE_2D;
-    if ((RLSW.srcFactor == SW_ONE) && (RLSW.dstFactor == SW_ZERO)) state &= ~SW_STATE_BLEND;
+    uint32_t state = sw_triangle_raster_state();
 
     if ((RLSW.vertexCounter == 4) && sw_quad_is_axis_aligned())
     {
-        if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_quad_raster_axis_aligned_TEX_DEPTH_BLEND();
-        else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_quad_raster_axis_aligned_DEPTH_BLEND();
-        else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_BLEND)) sw_quad_raster_axis_aligned_TEX_BLEND();
-        else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST)) sw_quad_raster_axis_aligned_TEX_DEPTH();
-        else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_quad_raster_axis_aligned_BLEND();
-        else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_quad_raster_axis_aligned_DEPTH();
-        else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D)) sw_quad_raster_axis_aligned_TEX();
-        else sw_quad_raster_axis_aligned();
-        return;
-    }
+        const sw_texture_t *tex = &RLSW.loadedTextures[RLSW.currentTexture];
 
-    #define TRIANGLE_RASTER(RASTER_FUNC)                        \
-    {                                                           \
-        for (int i = 0; i < RLSW.vertexCounter - 2; i++)        \
-        {                                                       \
-            RASTER_FUNC(                                        \
-                &RLSW.vertexBuffer[0],                          \
-                &RLSW.vertexBuffer[i + 1],                      \
-                &RLSW.vertexBuffer[i + 2],                      \
-                &RLSW.loadedTextures[RLSW.currentTexture]       \
-            );                                                  \
-        }                                                       \
+#if defined(SW_SUPPORT_MULTITHREADING)
+        if (RLSW.binning.enabled)
+        {
+            sw_binning_push_quad(state, RLSW.vertexBuffer, tex);
+            return;
+        }
+#endif
+        sw_quad_raster_axis_aligned_ex(state, RLSW.vertexBuffer, tex, 0, RLSW.framebuffer.height);
+        return;
     }
 
-    if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_DEPTH_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_TEX_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D | SW_STATE_DEPTH_TEST)) TRIANGLE_RASTER(sw_triangle_raster_TEX_DEPTH)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) TRIANGLE_RASTER(sw_triangle_raster_BLEND)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) TRIANGLE_RASTER(sw_triangle_raster_DEPTH)
-    else if (SW_STATE_CHECK_EX(state, SW_STATE_TEXTURE_2D)) TRIANGLE_RASTER(sw_triangle_raster_TEX)
-    else TRIANGLE_RASTER(sw_triangle_raster)
-
-    #undef TRIANGLE_RASTER
+    sw_triangle_fan_raster(state);
 }
 //-------------------------------------------------------------------------------------------
 
@@ -3034,7 +4041,8 @@ static inline bool sw_line_clip_and_project(sw_vertex_t *v0, sw_vertex_t *v1)
 }
 
 #define DEFINE_LINE_RASTER(FUNC_NAME, ENABLE_DEPTH_TEST, ENABLE_COLOR_BLEND) \
-static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1) \
+static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1, \
+                             int bandMin, int bandMax)                  \
 {                                                                       \
     float x0 = v0->screen[0];                                           \
     float y0 = v0->screen[1];                                           \
@@ -3080,7 +4088,8 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1) \
     float a = v0->color[3] + aInc*substep;                              \
                                                                         \
     const int fbWidth = RLSW.framebuffer.width;                         \
-    sw_pixel_t *pixels = RLSW.framebuffer.pixels;                       \
+    sw_color_t *colors = RLSW.framebuffer.color;                        \
+    sw_depth_t *depths = RLSW.framebuffer.depth;                        \
                                                                         \
     int numPixels = (int)(steps - substep) + 1;                         \
                                                                         \
@@ -3090,26 +4099,26 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1) \
         int px = (int)(x - 0.5f);                                       \
         int py = (int)(y - 0.5f);                                       \
                                                                         \
-        sw_pixel_t *ptr = pixels + py*fbWidth + px;                     \
+        if ((py < bandMin) || (py >= bandMax)) goto discard;            \
+                                                                        \
+        sw_color_t *cptr = colors + py*fbWidth + px;                    \
+        sw_depth_t *dptr = depths + py*fbWidth + px;                    \
                                                                         \
         if (ENABLE_DEPTH_TEST)                                          \
         {                                                               \
-            float depth = sw_framebuffer_read_depth(ptr);               \
+            float depth = sw_framebuffer_read_depth(dptr);              \
             if (z > depth) goto discard;                                \
+            sw_hiz_write(sw_hiz_get_tile(px, py), px, py, z);           \
+            sw_framebuffer_write_depth(dptr, z);                        \
         }                                                               \
                                                                         \
-        sw_framebuffer_write_depth(ptr, z);                             \
-                                                                        \
         float color[4] = {r, g, b, a};                                  \
                                                                         \
         if (ENABLE_COLOR_BLEND)                                         \
         {                                                               \
-            float dstColor[4];                                          \
-            sw_framebuffer_read_color(dstColor, ptr);                   \
-            sw_blend_colors(dstColor, color);                           \
-            sw_framebuffer_write_color(ptr, dstColor);                  \
+            sw_blend_pixel(cptr, color);                                \
         }                                                               \
-        else sw_framebuffer_write_color(ptr, color);                    \
+        else sw_framebuffer_write_color(cptr, color);                   \
                                                                         \
     discard:                                                            \
         x += xInc; y += yInc; z += zInc;                                \
@@ -3118,7 +4127,8 @@ static inline void FUNC_NAME(const sw_vertex_t *v0, const sw_vertex_t *v1) \
 }
 
 #define DEFINE_LINE_THICK_RASTER(FUNC_NAME, RASTER_FUNC)                \
-void FUNC_NAME(const sw_vertex_t *v1, const sw_vertex_t *v2)            \
+void FUNC_NAME(const sw_vertex_t *v1, const sw_vertex_t *v2,            \
+               int bandMin, int bandMax)                                \
 {                                                                       \
     sw_vertex_t tv1, tv2;                                               \
                                                                         \
@@ -3130,7 +4140,7 @@ void FUNC_NAME(const sw_vertex_t *v1, const sw_vertex_t *v2)            \
     int dx = x2 - x1;                                                   \
     int dy = y2 - y1;                                                   \
                                                                         \
-    RASTER_FUNC(v1, v2);                                                \
+    RASTER_FUNC(v1, v2, bandMin, bandMax);                              \
                                                                         \
     if ((dx != 0) && (abs(dy/dx) < 1))                                  \
     {                                                                   \
@@ -3141,11 +4151,11 @@ void FUNC_NAME(const sw_vertex_t *v1, const sw_vertex_t *v2)            \
             tv1 = *v1, tv2 = *v2;                                       \
             tv1.screen[1] -= i;                                         \
             tv2.screen[1] -= i;                                         \
-            RASTER_FUNC(&tv1, &tv2);                                    \
+            RASTER_FUNC(&tv1, &tv2, bandMin, bandMax);                  \
             tv1 = *v1, tv2 = *v2;                                       \
             tv1.screen[1] += i;                                         \
             tv2.screen[1] += i;                                         \
-            RASTER_FUNC(&tv1, &tv2);                                    \
+            RASTER_FUNC(&tv1, &tv2, bandMin, bandMax);                  \
         }                                                               \
     }                                                                   \
     else if (dy != 0)                                                   \
@@ -3157,11 +4167,11 @@ void FUNC_NAME(const sw_vertex_t *v1, const sw_vertex_t *v2)            \
             tv1 = *v1, tv2 = *v2;                                       \
             tv1.screen[0] -= i;                                         \
             tv2.screen[0] -= i;                                         \
-            RASTER_FUNC(&tv1, &tv2);                                    \
+            RASTER_FUNC(&tv1, &tv2, bandMin, bandMax);                  \
             tv1 = *v1, tv2 = *v2;                                       \
             tv1.screen[0] += i;                                         \
             tv2.screen[0] += i;                                         \
-            RASTER_FUNC(&tv1, &tv2);                                    \
+            RASTER_FUNC(&tv1, &tv2, bandMin, bandMax);                  \
         }                                                               \
     }                                                                   \
 }
@@ -3176,25 +4186,38 @@ DEFINE_LINE_THICK_RASTER(sw_line_thick_raster_DEPTH, sw_line_raster_DEPTH)
 DEFINE_LINE_THICK_RASTER(sw_line_thick_raster_BLEND, sw_line_raster_BLEND)
 DEFINE_LINE_THICK_RASTER(sw_line_thick_raster_DEPTH_BLEND, sw_line_raster_DEPTH_BLEND)
 
-static inline void sw_line_render(sw_vertex_t *vertices)
+static inline void sw_line_raster_ex(uint32_t state, const sw_vertex_t *v0, const sw_vertex_t *v1, int bandMin, int bandMax)
 {
-    if (!sw_line_clip_and_project(&vertices[0], &vertices[1])) return;
-
     if (RLSW.lineWidth >= 2.0f)
     {
-        if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_line_thick_raster_DEPTH_BLEND(&vertices[0], &vertices[1]);
-        else if (SW_STATE_CHECK(SW_STATE_BLEND)) sw_line_thick_raster_BLEND(&vertices[0], &vertices[1]);
-        else if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST)) sw_line_thick_raster_DEPTH(&vertices[0], &vertices[1]);
-        else sw_line_thick_raster(&vertices[0], &vertices[1]);
+        if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_line_thick_raster_DEPTH_BLEND(v0, v1, bandMin, bandMax);
+        else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_line_thick_raster_BLEND(v0, v1, bandMin, bandMax);
+        else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_line_thick_raster_DEPTH(v0, v1, bandMin, bandMax);
+        else sw_line_thick_raster(v0, v1, bandMin, bandMax);
     }
     else
     {
-        if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_line_raster_DEPTH_BLEND(&vertices[0], &vertices[1]);
-        else if (SW_STATE_CHECK(SW_STATE_BLEND)) sw_line_raster_BLEND(&vertices[0], &vertices[1]);
-        else if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST)) sw_line_raster_DEPTH(&vertices[0], &vertices[1]);
-        else sw_line_raster(&vertices[0], &vertices[1]);
+        if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_line_raster_DEPTH_BLEND(v0, v1, bandMin, bandMax);
+        else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_line_raster_BLEND(v0, v1, bandMin, bandMax);
+        else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_line_raster_DEPTH(v0, v1, bandMin, bandMax);
+        else sw_line_raster(v0, v1, bandMin, bandMax);
     }
 }
+
+static inline void sw_line_render(sw_vertex_t *vertices)
+{
+    if (!sw_line_clip_and_project(&vertices[0], &vertices[1])) return;
+
+#if defined(SW_SUPPORT_MULTITHREADING)
+    if (RLSW.binning.enabled)
+    {
+        sw_binning_push_line(RLSW.stateFlags, &vertices[0], &vertices[1]);
+        return;
+    }
+#endif
+
+    sw_line_raster_ex(RLSW.stateFlags, &vertices[0], &vertices[1], 0, RLSW.framebuffer.height);
+}
 //-------------------------------------------------------------------------------------------
 
 // Point rendering logic
@@ -3236,8 +4259,11 @@ static inline bool sw_point_clip_and_project(sw_vertex_t *v)
 }
 
 #define DEFINE_POINT_RASTER(FUNC_NAME, ENABLE_DEPTH_TEST, ENABLE_COLOR_BLEND, CHECK_BOUNDS) \
-static inline void FUNC_NAME(int x, int y, float z, const float color[4])   \
+static inline void FUNC_NAME(int x, int y, float z, const float color[4],   \
+                             int bandMin, int bandMax)                      \
 {                                                                           \
+    if ((y < bandMin) || (y >= bandMax)) return;                            \
+                                                                            \
     if (CHECK_BOUNDS == 1)                                                  \
     {                                                                       \
         if ((x < RLSW.vpMin[0]) || (x >= RLSW.vpMax[0])) return;            \
@@ -3250,28 +4276,26 @@ static inline void FUNC_NAME(int x, int y, float z, const float color[4])   \
     }                                                                       \
                                                                             \
     int offset = y*RLSW.framebuffer.width + x;                              \
-    sw_pixel_t *ptr = RLSW.framebuffer.pixels + offset;                     \
+    sw_color_t *cptr = RLSW.framebuffer.color + offset;                     \
+    sw_depth_t *dptr = RLSW.framebuffer.depth + offset;                     \
                                                                             \
     if (ENABLE_DEPTH_TEST)                                                  \
     {                                                                       \
-        float depth = sw_framebuffer_read_depth(ptr);                       \
+        float depth = sw_framebuffer_read_depth(dptr);                      \
         if (z > depth) return;                                              \
+        sw_hiz_write(sw_hiz_get_tile(x, y), x, y, z);                       \
+        sw_framebuffer_write_depth(dptr, z);                                \
     }                                                                       \
                                                                             \
-    sw_framebuffer_write_depth(ptr, z);                                     \
-                                                                            \
     if (ENABLE_COLOR_BLEND)                                                 \
     {                                                                       \
-        float dstColor[4];                                                  \
-        sw_framebuffer_read_color(dstColor, ptr);                           \
-        sw_blend_colors(dstColor, color);                                   \
-        sw_framebuffer_write_color(ptr, dstColor);                          \
+        sw_blend_pixel(cptr, color);                                        \
     }                                                                       \
-    else sw_framebuffer_write_color(ptr, color);                            \
+    else sw_framebuffer_write_color(cptr, color);                           \
 }
 
 #define DEFINE_POINT_THICK_RASTER(FUNC_NAME, RASTER_FUNC)                   \
-static inline void FUNC_NAME(sw_vertex_t *v)                                \
+static inline void FUNC_NAME(const sw_vertex_t *v, int bandMin, int bandMax) \
 {                                                                           \
     int cx = v->screen[0];                                                  \
     int cy = v->screen[1];                                                  \
@@ -3287,13 +4311,13 @@ static inline void FUNC_NAME(sw_vertex_t *v)                                \
     {                                                                       \
         for (int i = -x; i <= x; i++)                                       \
         {                                                                   \
-            RASTER_FUNC(cx + i, cy + y, cz, color);                         \
-            RASTER_FUNC(cx + i, cy - y, cz, color);                         \
+            RASTER_FUNC(cx + i, cy + y, cz, color, bandMin, bandMax);       \
+            RASTER_FUNC(cx + i, cy - y, cz, color, bandMin, bandMax);       \
         }                                                                   \
         for (int i = -y; i <= y; i++)                                       \
         {                                                                   \
-            RASTER_FUNC(cx + i, cy + x, cz, color);                         \
-            RASTER_FUNC(cx + i, cy - x, cz, color);                         \
+            RASTER_FUNC(cx + i, cy + x, cz, color, bandMin, bandMax);       \
+            RASTER_FUNC(cx + i, cy - x, cz, color, bandMin, bandMax);       \
         }                                                                   \
         if (d > 0)                                                          \
         {                                                                   \
@@ -3330,36 +4354,416 @@ DEFINE_POINT_THICK_RASTER(sw_point_thick_raster_DEPTH_SCISSOR, sw_point_raster_D
 DEFINE_POINT_THICK_RASTER(sw_point_thick_raster_BLEND_SCISSOR, sw_point_raster_BLEND_CHECK_SCISSOR)
 DEFINE_POINT_THICK_RASTER(sw_point_thick_raster_DEPTH_BLEND_SCISSOR, sw_point_raster_DEPTH_BLEND_CHECK_SCISSOR)
 
-static inline void sw_point_render(sw_vertex_t *v)
+static inline void sw_point_raster_ex(uint32_t state, const sw_vertex_t *v, int bandMin, int bandMax)
+{
+    if (RLSW.pointRadius >= 1.0f)
+    {
+        if (SW_STATE_CHECK_EX(state, SW_STATE_SCISSOR_TEST))
+        {
+            if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_point_thick_raster_DEPTH_BLEND_SCISSOR(v, bandMin, bandMax);
+            else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_point_thick_raster_BLEND_SCISSOR(v, bandMin, bandMax);
+            else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_point_thick_raster_DEPTH_SCISSOR(v, bandMin, bandMax);
+            else sw_point_thick_raster_SCISSOR(v, bandMin, bandMax);
+        }
+        else
+        {
+            if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_point_thick_raster_DEPTH_BLEND(v, bandMin, bandMax);
+            else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_point_thick_raster_BLEND(v, bandMin, bandMax);
+            else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_point_thick_raster_DEPTH(v, bandMin, bandMax);
+            else sw_point_thick_raster(v, bandMin, bandMax);
+        }
+    }
+    else
+    {
+        if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_point_raster_DEPTH_BLEND(v->screen[0], v->screen[1], v->homogeneous[2], v->color, bandMin, bandMax);
+        else if (SW_STATE_CHECK_EX(state, SW_STATE_BLEND)) sw_point_raster_BLEND(v->screen[0], v->screen[1], v->homogeneous[2], v->color, bandMin, bandMax);
+        else if (SW_STATE_CHECK_EX(state, SW_STATE_DEPTH_TEST)) sw_point_raster_DEPTH(v->screen[0], v->screen[1], v->homogeneous[2], v->color, bandMin, bandMax);
+        else sw_point_raster(v->screen[0], v->screen[1], v->homogeneous[2], v->color, bandMin, bandMax);
+    }
+}
+
+static inline void sw_point_render(sw_vertex_t *v)
+{
+    if (!sw_point_clip_and_project(v)) return;
+
+#if defined(SW_SUPPORT_MULTITHREADING)
+    if (RLSW.binning.enabled)
+    {
+        sw_binning_push_point(RLSW.stateFlags, v);
+        return;
+    }
+#endif
+
+    sw_point_raster_ex(RLSW.stateFlags, v, 0, RLSW.framebuffer.height);
+}
+//-------------------------------------------------------------------------------------------
+
+#if defined(SW_SUPPORT_MULTITHREADING)
+// Threading helper functions
+//-------------------------------------------------------------------------------------------
+#if defined(SW_THREADS_WIN32)
+static bool sw_thread_create(sw_thread_t *thread, unsigned long (__stdcall *func)(void *))
+{
+    *thread = CreateThread(NULL, 0, func, NULL, 0, NULL);
+    return (*thread != NULL);
+}
+
+static void sw_thread_join(sw_thread_t *thread)
+{
+    WaitForSingleObject(*thread, 0xFFFFFFFF);    // INFINITE
+    CloseHandle(*thread);
+}
+
+static void sw_mutex_init(sw_mutex_t *mutex) { InitializeSRWLock(mutex); }
+static void sw_mutex_destroy(sw_mutex_t *mutex) { (void)mutex; }
+static void sw_mutex_lock(sw_mutex_t *mutex) { AcquireSRWLockExclusive(mutex); }
+static void sw_mutex_unlock(sw_mutex_t *mutex) { ReleaseSRWLockExclusive(mutex); }
+
+static void sw_cond_init(sw_cond_t *cond) { InitializeConditionVariable(cond); }
+static void sw_cond_destroy(sw_cond_t *cond) { (void)cond; }
+static void sw_cond_wait(sw_cond_t *cond, sw_mutex_t *mutex) { SleepConditionVariableSRW(cond, mutex, 0xFFFFFFFF, 0); }
+static void sw_cond_broadcast(sw_cond_t *cond) { WakeAllConditionVariable(cond); }
+#else
+static bool sw_thread_create(sw_thread_t *thread, void *(*func)(void *))
+{
+    return (pthread_create(thread, NULL, func, NULL) == 0);
+}
+
+static void sw_thread_join(sw_thread_t *thread) { pthread_join(*thread, NULL); }
+
+static void sw_mutex_init(sw_mutex_t *mutex) { pthread_mutex_init(mutex, NULL); }
+static void sw_mutex_destroy(sw_mutex_t *mutex) { pthread_mutex_destroy(mutex); }
+static void sw_mutex_lock(sw_mutex_t *mutex) { pthread_mutex_lock(mutex); }
+static void sw_mutex_unlock(sw_mutex_t *mutex) { pthread_mutex_unlock(mutex); }
+
+static void sw_cond_init(sw_cond_t *cond) { pthread_cond_init(cond, NULL); }
+static void sw_cond_destroy(sw_cond_t *cond) { pthread_cond_destroy(cond); }
+static void sw_cond_wait(sw_cond_t *cond, sw_mutex_t *mutex) { pthread_cond_wait(cond, mutex); }
+static void sw_cond_broadcast(sw_cond_t *cond) { pthread_cond_broadcast(cond); }
+#endif
+//-------------------------------------------------------------------------------------------
+
+// Binned rendering logic
+//-------------------------------------------------------------------------------------------
+// NOTE: Primitives are clipped and projected on the calling thread, then recorded
+// and binned into full-width horizontal tiles of SW_TILE_HEIGHT rows. On flush, each
+// tile is rasterized by a single thread in submission order, using the same raster
+// functions restricted to the tile rows, so the output is identical to the immediate path
+
+static inline void sw_primitive_raster(const sw_primitive_t *prim, int bandMin, int bandMax)
+{
+    switch (prim->type)
+    {
+        case SW_PRIMITIVE_TRIANGLE: sw_triangle_raster_ex(prim->state, &prim->vertices[0], &prim->vertices[1], &prim->vertices[2], prim->texture, bandMin, bandMax); break;
+        case SW_PRIMITIVE_QUAD_AXIS_ALIGNED: sw_quad_raster_axis_aligned_ex(prim->state, prim->vertices, prim->texture, bandMin, bandMax); break;
+        case SW_PRIMITIVE_LINE: sw_line_raster_ex(prim->state, &prim->vertices[0], &prim->vertices[1], bandMin, bandMax); break;
+        case SW_PRIMITIVE_POINT: sw_point_raster_ex(prim->state, &prim->vertices[0], bandMin, bandMax); break;
+        default: break;
+    }
+}
+
+// Opaque depth tested primitives give the same result in any order (except coplanar ones),
+// they can be sorted between each other, other primitives keep their place in the bin
+static inline bool sw_binning_is_sortable(const sw_primitive_t *prim)
+{
+    if ((prim->type != SW_PRIMITIVE_TRIANGLE) && (prim->type != SW_PRIMITIVE_QUAD_AXIS_ALIGNED)) return false;
+
+    return ((prim->state & (SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) == SW_STATE_DEPTH_TEST);
+}
+
+static int sw_binning_compare(const void *a, const void *b)
+{
+    uint32_t ia = *(const uint32_t *)a;
+    uint32_t ib = *(const uint32_t *)b;
+
+    const sw_primitive_t *pa = &RLSW.binning.primitives[ia];
+    const sw_primitive_t *pb = &RLSW.binning.primitives[ib];
+
+    // Sort by raster function, then by texture, then front to back, then in submission order
+    if (pa->state != pb->state) return (pa->state < pb->state)? -1 : 1;
+
+    uintptr_t ta = (pa->state & SW_STATE_TEXTURE_2D)? (uintptr_t)pa->texture : 0;
+    uintptr_t tb = (pb->state & SW_STATE_TEXTURE_2D)? (uintptr_t)pb->texture : 0;
+    if (ta != tb) return (ta < tb)? -1 : 1;
+
+    if (pa->depth != pb->depth) return (pa->depth < pb->depth)? -1 : 1;
+
+    return (ia < ib)? -1 : (ia > ib);
+}
+
+static void sw_binning_sort_bin(sw_bin_t *bin)
+{
+    const sw_primitive_t *primitives = RLSW.binning.primitives;
+    int start = 0;
+
+    while (start < bin->count)
+    {
+        if (!sw_binning_is_sortable(&primitives[bin->indices[start]])) { start++; continue; }
+
+        int end = start + 1;
+        while ((end < bin->count) && sw_binning_is_sortable(&primitives[bin->indices[end]])) end++;
+
+        if (end - start > 1) qsort(&bin->indices[start], end - start, sizeof(uint32_t), sw_binning_compare);
+
+        start = end;
+    }
+}
+
+static void sw_binning_process_tiles(void)
+{
+    sw_binning_t *bn = &RLSW.binning;
+
+    while (true)
+    {
+        sw_mutex_lock(&bn->mutex);
+        int tile = bn->nextTile++;
+        sw_mutex_unlock(&bn->mutex);
+
+        if (tile >= bn->binCount) break;
+
+        sw_bin_t *bin = &bn->bins[tile];
+        int bandMin = tile*SW_TILE_HEIGHT;
+        int bandMax = sw_clampi(bandMin + SW_TILE_HEIGHT, 0, RLSW.framebuffer.height);
+
+        if (RLSW.deferred) sw_binning_sort_bin(bin);
+
+        for (int i = 0; i < bin->count; i++)
+        {
+            sw_primitive_raster(&bn->primitives[bin->indices[i]], bandMin, bandMax);
+        }
+    }
+}
+
+static void sw_binning_worker_loop(void)
+{
+    sw_binning_t *bn = &RLSW.binning;
+    uint32_t generation = 0;    // NOTE: Generation is reset before workers are started
+
+    sw_mutex_lock(&bn->mutex);
+
+    while (true)
+    {
+        while (!bn->quit && (bn->generation == generation)) sw_cond_wait(&bn->workCond, &bn->mutex);
+        if (bn->quit) break;
+
+        generation = bn->generation;
+        sw_mutex_unlock(&bn->mutex);
+
+        sw_binning_process_tiles();
+
+        sw_mutex_lock(&bn->mutex);
+        bn->activeWorkers--;
+        if (bn->activeWorkers == 0) sw_cond_broadcast(&bn->doneCond);
+    }
+
+    sw_mutex_unlock(&bn->mutex);
+}
+
+#if defined(SW_THREADS_WIN32)
+static unsigned long __stdcall sw_binning_worker(void *arg) { (void)arg; sw_binning_worker_loop(); return 0; }
+#else
+static void *sw_binning_worker(void *arg) { (void)arg; sw_binning_worker_loop(); return NULL; }
+#endif
+
+static void sw_binning_flush(void)
+{
+    sw_binning_t *bn = &RLSW.binning;
+
+    if (!bn->enabled || (bn->primitiveCount == 0)) return;
+
+    sw_mutex_lock(&bn->mutex);
+    bn->nextTile = 0;
+    bn->activeWorkers = bn->threadCount - 1;
+    bn->generation++;
+    sw_cond_broadcast(&bn->workCond);
+    sw_mutex_unlock(&bn->mutex);
+
+    // The calling thread also processes tiles while waiting
+    sw_binning_process_tiles();
+
+    sw_mutex_lock(&bn->mutex);
+    while (bn->activeWorkers > 0) sw_cond_wait(&bn->doneCond, &bn->mutex);
+    sw_mutex_unlock(&bn->mutex);
+
+    for (int i = 0; i < bn->binCount; i++) bn->bins[i].count = 0;
+    bn->primitiveCount = 0;
+}
+
+static bool sw_binning_resize_bins(int height)
+{
+    sw_binning_t *bn = &RLSW.binning;
+    int binCount = SW_TILE_COUNT(height);
+
+    if (binCount == bn->binCount) return true;
+
+    for (int i = 0; i < bn->binCount; i++) SW_FREE(bn->bins[i].indices);
+    SW_FREE(bn->bins);
+
+    bn->bins = (sw_bin_t *)SW_MALLOC(binCount*sizeof(sw_bin_t));
+    if (bn->bins == NULL) { bn->binCount = 0; return false; }
+
+    for (int i = 0; i < binCount; i++) bn->bins[i] = SW_CURLY_INIT(sw_bin_t) { 0 };
+    bn->binCount = binCount;
+
+    return true;
+}
+
+static void sw_binning_stop(void)
+{
+    sw_binning_t *bn = &RLSW.binning;
+
+    if (bn->threadCount > 1)
+    {
+        sw_mutex_lock(&bn->mutex);
+        bn->quit = true;
+        sw_cond_broadcast(&bn->workCond);
+        sw_mutex_unlock(&bn->mutex);
+
+        for (int i = 0; i < bn->threadCount - 1; i++) sw_thread_join(&bn->threads[i]);
+    }
+
+    if (bn->threadCount > 0)
+    {
+        sw_cond_destroy(&bn->doneCond);
+        sw_cond_destroy(&bn->workCond);
+        sw_mutex_destroy(&bn->mutex);
+    }
+
+    for (int i = 0; i < bn->binCount; i++) SW_FREE(bn->bins[i].indices);
+    SW_FREE(bn->bins);
+    SW_FREE(bn->primitives);
+
+    *bn = SW_CURLY_INIT(sw_binning_t) { 0 };
+}
+
+static bool sw_binning_start(int threadCount)
+{
+    sw_binning_t *bn = &RLSW.binning;
+
+    bn->primitives = (sw_primitive_t *)SW_MALLOC(SW_MAX_BINNED_PRIMITIVES*sizeof(sw_primitive_t));
+    if ((bn->primitives == NULL) || !sw_binning_resize_bins(RLSW.framebuffer.height)) { sw_binning_stop(); return false; }
+
+    sw_mutex_init(&bn->mutex);
+    sw_cond_init(&bn->workCond);
+    sw_cond_init(&bn->doneCond);
+    bn->generation = 0;
+    bn->quit = false;
+    bn->threadCount = 1;
+
+    for (int i = 0; i < threadCount - 1; i++)
+    {
+        if (!sw_thread_create(&bn->threads[i], sw_binning_worker)) break;
+        bn->threadCount++;
+    }
+
+    // Deferred rendering can record without any worker thread
+    if ((bn->threadCount < 2) && !RLSW.deferred) { sw_binning_stop(); return false; }
+
+    bn->enabled = true;
+
+    return true;
+}
+
+// Append the last recorded primitive to the bins of the tiles overlapping rows [yMin, yMax]
+static void sw_binning_commit(float yMin, float yMax)
 {
-    if (!sw_point_clip_and_project(v)) return;
+    sw_binning_t *bn = &RLSW.binning;
 
-    if (RLSW.pointRadius >= 1.0f)
+    int rowMin = (int)floorf(yMin) - 1;
+    int rowMax = (int)floorf(yMax) + 1;
+
+    if ((rowMax < 0) || (rowMin >= RLSW.framebuffer.height)) return;
+
+    int tileMin = sw_clampi(rowMin, 0, RLSW.framebuffer.height - 1)/SW_TILE_HEIGHT;
+    int tileMax = sw_clampi(rowMax, 0, RLSW.framebuffer.height - 1)/SW_TILE_HEIGHT;
+    uint32_t index = (uint32_t)bn->primitiveCount;
+
+    for (int t = tileMin; t <= tileMax; t++)
     {
-        if (SW_STATE_CHECK(SW_STATE_SCISSOR_TEST))
-        {
-            if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_point_thick_raster_DEPTH_BLEND_SCISSOR(v);
-            else if (SW_STATE_CHECK(SW_STATE_BLEND)) sw_point_thick_raster_BLEND_SCISSOR(v);
-            else if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST)) sw_point_thick_raster_DEPTH_SCISSOR(v);
-            else sw_point_thick_raster_SCISSOR(v);
-        }
-        else
+        sw_bin_t *bin = &bn->bins[t];
+
+        if (bin->count == bin->capacity)
         {
-            if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_point_thick_raster_DEPTH_BLEND(v);
-            else if (SW_STATE_CHECK(SW_STATE_BLEND)) sw_point_thick_raster_BLEND(v);
-            else if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST)) sw_point_thick_raster_DEPTH(v);
-            else sw_point_thick_raster(v);
+            int capacity = (bin->capacity > 0)? 2*bin->capacity : 256;
+            uint32_t *indices = (uint32_t *)SW_REALLOC(bin->indices, capacity*sizeof(uint32_t));
+            if (indices == NULL) { RLSW.errCode = SW_STACK_OVERFLOW; break; } // WARNING: Out of memory, not really stack overflow
+
+            bin->indices = indices;
+            bin->capacity = capacity;
         }
+
+        bin->indices[bin->count++] = index;
     }
-    else
+
+    bn->primitiveCount++;
+}
+
+static inline sw_primitive_t *sw_binning_record(sw_primitive_type_t type, uint32_t state, const sw_texture_t *tex)
+{
+    if (RLSW.binning.primitiveCount >= SW_MAX_BINNED_PRIMITIVES) sw_binning_flush();
+
+    sw_primitive_t *prim = &RLSW.binning.primitives[RLSW.binning.primitiveCount];
+    prim->type = type;
+    prim->state = state;
+    prim->texture = tex;
+    prim->depth = 0.0f;
+
+    return prim;
+}
+
+static void sw_binning_push_triangle(uint32_t state, const sw_vertex_t *v0, const sw_vertex_t *v1, const sw_vertex_t *v2, const sw_texture_t *tex)
+{
+    sw_primitive_t *prim = sw_binning_record(SW_PRIMITIVE_TRIANGLE, state, tex);
+    prim->vertices[0] = *v0;
+    prim->vertices[1] = *v1;
+    prim->vertices[2] = *v2;
+    prim->depth = fminf(v0->homogeneous[2], fminf(v1->homogeneous[2], v2->homogeneous[2]));
+
+    float yMin = fminf(v0->screen[1], fminf(v1->screen[1], v2->screen[1]));
+    float yMax = fmaxf(v0->screen[1], fmaxf(v1->screen[1], v2->screen[1]));
+
+    sw_binning_commit(yMin, yMax);
+}
+
+static void sw_binning_push_quad(uint32_t state, const sw_vertex_t *vertices, const sw_texture_t *tex)
+{
+    sw_primitive_t *prim = sw_binning_record(SW_PRIMITIVE_QUAD_AXIS_ALIGNED, state, tex);
+    float yMin = vertices[0].screen[1];
+    float yMax = vertices[0].screen[1];
+    prim->depth = vertices[0].homogeneous[2];
+
+    for (int i = 0; i < 4; i++)
     {
-        if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST | SW_STATE_BLEND)) sw_point_raster_DEPTH_BLEND(v->screen[0], v->screen[1], v->homogeneous[2], v->color);
-        else if (SW_STATE_CHECK(SW_STATE_BLEND)) sw_point_raster_BLEND(v->screen[0], v->screen[1], v->homogeneous[2], v->color);
-        else if (SW_STATE_CHECK(SW_STATE_DEPTH_TEST)) sw_point_raster_DEPTH(v->screen[0], v->screen[1], v->homogeneous[2], v->color);
-        else sw_point_raster(v->screen[0], v->screen[1], v->homogeneous[2], v->color);
+        prim->vertices[i] = vertices[i];
+        prim->depth = fminf(prim->depth, vertices[i].homogeneous[2]);
+        yMin = fminf(yMin, vertices[i].screen[1]);
+        yMax = fmaxf(yMax, vertices[i].screen[1]);
     }
+
+    sw_binning_commit(yMin, yMax);
+}
+
+static void sw_binning_push_line(uint32_t state, const sw_vertex_t *v0, const sw_vertex_t *v1)
+{
+    sw_primitive_t *prim = sw_binning_record(SW_PRIMITIVE_LINE, state, NULL);
+    prim->vertices[0] = *v0;
+    prim->vertices[1] = *v1;
+
+    float yMin = fminf(v0->screen[1], v1->screen[1]) - RLSW.lineWidth;
+    float yMax = fmaxf(v0->screen[1], v1->screen[1]) + RLSW.lineWidth;
+
+    sw_binning_commit(yMin, yMax);
+}
+
+static void sw_binning_push_point(uint32_t state, const sw_vertex_t *v)
+{
+    sw_primitive_t *prim = sw_binning_record(SW_PRIMITIVE_POINT, state, NULL);
+    prim->vertices[0] = *v;
+
+    sw_binning_commit(v->screen[1] - RLSW.pointRadius - 1.0f, v->screen[1] + RLSW.pointRadius + 1.0f);
 }
 //-------------------------------------------------------------------------------------------
+#endif // SW_SUPPORT_MULTITHREADING
 
 // Polygon modes rendering logic
 //-------------------------------------------------------------------------------------------
@@ -3397,26 +4801,20 @@ static inline void sw_poly_fill_render(void)
 
 // Immediate rendering logic
 //-------------------------------------------------------------------------------------------
-void sw_immediate_push_vertex(const float position[4], const float color[4], const float texcoord[2])
+static inline void sw_immediate_transform_vertex(sw_vertex_t *vertex)
 {
-    // Copy the attributes in the current vertex
-    sw_vertex_t *vertex = &RLSW.vertexBuffer[RLSW.vertexCounter++];
-    for (int i = 0; i < 4; i++)
-    {
-        vertex->position[i] = position[i];
-        if (i < 2) vertex->texcoord[i] = texcoord[i];
-        vertex->color[i] = color[i];
-    }
-
     // Calculate homogeneous coordinates
     const float *m = RLSW.matMVP, *v = vertex->position;
     vertex->homogeneous[0] = m[0]*v[0] + m[4]*v[1] + m[8]*v[2] + m[12]*v[3];
     vertex->homogeneous[1] = m[1]*v[0] + m[5]*v[1] + m[9]*v[2] + m[13]*v[3];
     vertex->homogeneous[2] = m[2]*v[0] + m[6]*v[1] + m[10]*v[2] + m[14]*v[3];
     vertex->homogeneous[3] = m[3]*v[0] + m[7]*v[1] + m[11]*v[2] + m[15]*v[3];
+}
 
+static inline void sw_immediate_emit_vertex(void)
+{
     // Immediate rendering of the primitive if the required number is reached
-    if (RLSW.vertexCounter == RLSW.reqVertices)
+    if (++RLSW.vertexCounter == RLSW.reqVertices)
     {
         switch (RLSW.polyMode)
         {
@@ -3430,6 +4828,78 @@ void sw_immediate_push_vertex(const float position[4], const float color[4], con
     }
 }
 
+void sw_immediate_push_vertex(const float position[4], const float color[4], const float texcoord[2])
+{
+    // Copy the attributes in the current vertex
+    sw_vertex_t *vertex = &RLSW.vertexBuffer[RLSW.vertexCounter];
+    for (int i = 0; i < 4; i++)
+    {
+        vertex->position[i] = position[i];
+        if (i < 2) vertex->texcoord[i] = texcoord[i];
+        vertex->color[i] = color[i];
+    }
+
+    sw_immediate_transform_vertex(vertex);
+    sw_immediate_emit_vertex();
+}
+
+//-------------------------------------------------------------------------------------------
+
+// Vertex arrays processing logic
+//-------------------------------------------------------------------------------------------
+static inline void sw_array_fetch_vertex(sw_vertex_t *vertex, int index, const float *texMatrix)
+{
+    const float *texcoords = RLSW.array.texcoords;
+    const uint8_t *colors = RLSW.array.colors;
+
+    float u = RLSW.current.texcoord[0];
+    float v = RLSW.current.texcoord[1];
+
+    if (texcoords)
+    {
+        u = texcoords[2*index];
+        v = texcoords[2*index + 1];
+    }
+
+    vertex->texcoord[0] = texMatrix[0]*u + texMatrix[4]*v + texMatrix[12];
+    vertex->texcoord[1] = texMatrix[1]*u + texMatrix[5]*v + texMatrix[13];
+
+    for (int i = 0; i < 4; i++) vertex->color[i] = RLSW.current.color[i];
+
+    if (colors)
+    {
+        const uint8_t *c = &colors[4*index];
+        vertex->color[0] *= (float)c[0]*SW_INV_255;
+        vertex->color[1] *= (float)c[1]*SW_INV_255;
+        vertex->color[2] *= (float)c[2]*SW_INV_255;
+        vertex->color[3] *= (float)c[3]*SW_INV_255;
+    }
+
+    const float *p = &RLSW.array.positions[3*index];
+    vertex->position[0] = p[0];
+    vertex->position[1] = p[1];
+    vertex->position[2] = p[2];
+    vertex->position[3] = 1.0f;
+
+    sw_immediate_transform_vertex(vertex);
+}
+
+static inline void sw_array_push_indexed(uint32_t index, const float *texMatrix)
+{
+    // Post-transform cache, direct mapped on the vertex index,
+    // vertices shared by several primitives are fetched and transformed only once
+    int slot = index & (SW_VERTEX_CACHE_SIZE - 1);
+
+    if (RLSW.vertexCacheTags[slot] != index)
+    {
+        sw_array_fetch_vertex(&RLSW.vertexCache[slot], index, texMatrix);
+        RLSW.vertexCacheTags[slot] = index;
+    }
+
+    // Primitive processing modifies the vertex buffer in-place, the cached vertex is copied
+    RLSW.vertexBuffer[RLSW.vertexCounter] = RLSW.vertexCache[slot];
+    sw_immediate_emit_vertex();
+}
 //-------------------------------------------------------------------------------------------
 
 // Validity check helper functions
@@ -3447,7 +4917,9 @@ static inline bool sw_is_texture_valid(uint32_t id)
 
 static inline bool sw_is_texture_filter_valid(int filter)
 {
-    return ((filter == SW_NEAREST) || (filter == SW_LINEAR));
+    return ((filter == SW_NEAREST) || (filter == SW_LINEAR) ||
+            (filter == SW_NEAREST_MIPMAP_NEAREST) || (filter == SW_LINEAR_MIPMAP_NEAREST) ||
+            (filter == SW_NEAREST_MIPMAP_LINEAR) || (filter == SW_LINEAR_MIPMAP_LINEAR));
 }
 
 static inline bool sw_is_texture_wrap_valid(int wrap)
@@ -3543,6 +5015,7 @@ static inline bool sw_is_blend_dst_factor_valid(int blend)
 bool swInit(int w, int h)
 {
     if (!sw_framebuffer_load(w, h)) { swClose(); return false; }
+    if (!sw_hiz_resize(w, h)) { swClose(); return false; }
 
     swViewport(0, 0, w, h);
     swScissor(0, 0, w, h);
@@ -3554,8 +5027,8 @@ bool swInit(int w, int h)
     if (RLSW.loadedTextures == NULL) { swClose(); return false; }
 
     const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-    sw_framebuffer_write_color(&RLSW.clearValue, clearColor);
-    sw_framebuffer_write_depth(&RLSW.clearValue, 1.0f);
+    sw_framebuffer_write_color(&RLSW.clearColor, clearColor);
+    sw_framebuffer_write_depth(&RLSW.clearDepth, 1.0f);
 
     RLSW.currentMatrixMode = SW_MODELVIEW;
     RLSW.currentMatrix = &RLSW.stackModelview[0];
@@ -3583,15 +5056,17 @@ bool swInit(int w, int h)
 
     RLSW.srcFactorFunc = sw_factor_src_alpha;
     RLSW.dstFactorFunc = sw_factor_one_minus_src_alpha;
+    RLSW.blendMode = SW_BLEND_MODE_ALPHA;
 
     RLSW.polyMode = SW_FILL;
     RLSW.cullFace = SW_BACK;
 
-    static uint32_t defaultTex[3*2*2] = {
-        0xFFFFFFFF,
-        0xFFFFFFFF,
-        0xFFFFFFFF,
-        0xFFFFFFFF
+    // NOTE: Sized to a full 4x4 tile, as required by tiled textures storage
+    static uint32_t defaultTex[4*4] = {
+        0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+        0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+        0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+        0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF
     };
 
     RLSW.loadedTextures[0].pixels = (uint8_t*)defaultTex;
@@ -3605,6 +5080,8 @@ bool swInit(int w, int h)
     RLSW.loadedTextures[0].tWrap = SW_REPEAT;
     RLSW.loadedTextures[0].tx = 0.5f;
     RLSW.loadedTextures[0].ty = 0.5f;
+    sw_texture_init_mipmap(&RLSW.loadedTextures[0].mipmaps[0], (uint8_t*)defaultTex, 2, 2);
+    RLSW.loadedTextures[0].mipmapCount = 1;
 
     RLSW.loadedTextureCount = 1;
     
@@ -3630,29 +5107,120 @@ bool swInit(int w, int h)
 
 void swClose(void)
 {
+#if defined(SW_SUPPORT_MULTITHREADING)
+    sw_binning_flush();
+    sw_binning_stop();
+#endif
+
     // NOTE: Starts at texture 1, texture 0 does not have to be freed
     for (int i = 1; i < RLSW.loadedTextureCount; i++)
     {
         if (sw_is_texture_valid(i))
         {
-            SW_FREE(RLSW.loadedTextures[i].pixels);
+            sw_texture_free(&RLSW.loadedTextures[i]);
         }
     }
 
-    SW_FREE(RLSW.framebuffer.pixels);
+    SW_FREE(RLSW.framebuffer.colorInternal);
+    SW_FREE(RLSW.framebuffer.depth);
+#if defined(SW_HIERARCHICAL_DEPTH)
+    SW_FREE(RLSW.framebuffer.hiz);
+#endif
     SW_FREE(RLSW.loadedTextures);
     SW_FREE(RLSW.freeTextureIds);
 
     RLSW = SW_CURLY_INIT(sw_context_t) { 0 };
 }
 
+bool swSetThreadCount(int count)
+{
+#if defined(SW_SUPPORT_MULTITHREADING)
+    if (count < 1) count = 1;
+    if (count > SW_MAX_THREADS) count = SW_MAX_THREADS;
+
+    if (count == RLSW.binning.threadCount) return true;
+
+    sw_binning_flush();
+    sw_binning_stop();
+
+    if ((count == 1) && !RLSW.deferred) return true;
+
+    if (!sw_binning_start(count))
+    {
+        SW_LOG("WARNING: RLSW: Failed to start rasterization threads, using single-threaded mode\n");
+        return false;
+    }
+
+    SW_LOG("INFO: RLSW: Binned rasterization enabled with %i threads\n", RLSW.binning.threadCount);
+
+    return (RLSW.binning.threadCount == count);
+#else
+    return (count <= 1);
+#endif
+}
+
+bool swSetDeferredRendering(bool enabled)
+{
+#if defined(SW_SUPPORT_MULTITHREADING)
+    if (enabled == RLSW.deferred) return true;
+
+    int count = RLSW.binning.enabled? RLSW.binning.threadCount : 1;
+
+    sw_binning_flush();
+    sw_binning_stop();
+
+    RLSW.deferred = enabled;
+
+    if ((count == 1) && !enabled) return true;
+
+    if (!sw_binning_start(count))
+    {
+        SW_LOG("WARNING: RLSW: Failed to start binned rasterization, using immediate mode\n");
+        RLSW.deferred = false;
+        return false;
+    }
+
+    return true;
+#else
+    return !enabled;
+#endif
+}
+
+int swGetThreadCount(void)
+{
+#if defined(SW_SUPPORT_MULTITHREADING)
+    if (RLSW.binning.enabled) return RLSW.binning.threadCount;
+#endif
+    return 1;
+}
+
+void swFlush(void)
+{
+    SW_BINNING_FLUSH();
+}
+
 bool swResizeFramebuffer(int w, int h)
 {
-    return sw_framebuffer_resize(w, h);
+    SW_BINNING_FLUSH();
+
+    if (!sw_framebuffer_resize(w, h)) return false;
+    if (!sw_hiz_resize(w, h)) return false;
+
+#if defined(SW_SUPPORT_MULTITHREADING)
+    if (RLSW.binning.enabled && !sw_binning_resize_bins(h))
+    {
+        sw_binning_stop();
+        return false;
+    }
+#endif
+
+    return true;
 }
 
 void swCopyFramebuffer(int x, int y, int w, int h, SWformat format, SWtype type, void *pixels)
 {
+    SW_BINNING_FLUSH();
+
     sw_pixelformat_t pFormat = (sw_pixelformat_t)sw_get_pixel_format(format, type);
 
     if (w <= 0) { RLSW.errCode = SW_INVALID_VALUE; return; }
@@ -3707,6 +5275,8 @@ void swCopyFramebuffer(int x, int y, int w, int h, SWformat format, SWtype type,
 
 void swBlitFramebuffer(int xDst, int yDst, int wDst, int hDst, int xSrc, int ySrc, int wSrc, int hSrc, SWformat format, SWtype type, void *pixels)
 {
+    SW_BINNING_FLUSH();
+
     sw_pixelformat_t pFormat = (sw_pixelformat_t)sw_get_pixel_format(format, type);
 
     if (wSrc <= 0) { RLSW.errCode = SW_INVALID_VALUE; return; }
@@ -3747,6 +5317,51 @@ void swBlitFramebuffer(int xDst, int yDst, int wDst, int hDst, int xSrc, int ySr
     }
 }
 
+bool swBindColorBuffer(int w, int h, SWformat format, SWtype type, void *pixels)
+{
+    SW_BINNING_FLUSH();
+
+    sw_color_t *internal = RLSW.framebuffer.colorInternal;
+
+    if (pixels == NULL)
+    {
+        // Restore the internal color buffer, keeping the current content
+        if (RLSW.framebuffer.color != internal)
+        {
+            int size = RLSW.framebuffer.width*RLSW.framebuffer.height;
+            for (int i = 0; i < size; i++) internal[i] = RLSW.framebuffer.color[i];
+            RLSW.framebuffer.color = internal;
+        }
+
+        return true;
+    }
+
+    // External memory must match the framebuffer dimensions and the color storage format
+    // (the layout a full swCopyFramebuffer() to this format produces), it is then the
+    // destination of the rasterization and the copies to it become no-op
+    sw_pixelformat_t pFormat = (sw_pixelformat_t)sw_get_pixel_format(format, type);
+
+#if SW_COLOR_BUFFER_BITS == 32
+    bool isStorageFormat = (pFormat == SW_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+#elif SW_COLOR_BUFFER_BITS == 16
+    bool isStorageFormat = (pFormat == SW_PIXELFORMAT_UNCOMPRESSED_R5G6B5);
+#else
+    bool isStorageFormat = false;
+    (void)pFormat;
+#endif
+
+    if (!isStorageFormat) { RLSW.errCode = SW_INVALID_ENUM; return false; }
+    if ((w != RLSW.framebuffer.width) || (h != RLSW.framebuffer.height)) { RLSW.errCode = SW_INVALID_VALUE; return false; }
+
+    if (RLSW.framebuffer.color != (sw_color_t *)pixels)
+    {
+        sw_framebuffer_copy_fast(pixels);
+        RLSW.framebuffer.color = (sw_color_t *)pixels;
+    }
+
+    return true;
+}
+
 void swEnable(SWstate state)
 {
     switch (state)
@@ -3790,11 +5405,11 @@ void swGetFloatv(SWget name, float *v)
     {
         case SW_COLOR_CLEAR_VALUE:
         {
-            sw_framebuffer_read_color(v, &RLSW.clearValue);
+            sw_framebuffer_read_color(v, &RLSW.clearColor);
         } break;
         case SW_DEPTH_CLEAR_VALUE:
         {
-            v[0] = sw_framebuffer_read_depth(&RLSW.clearValue);
+            v[0] = sw_framebuffer_read_depth(&RLSW.clearDepth);
         } break;
         case SW_CURRENT_COLOR:
         {
@@ -3866,6 +5481,8 @@ void swViewport(int x, int y, int width, int height)
         return;
     }
 
+    SW_BINNING_FLUSH();
+
     RLSW.vpSize[0] = width;
     RLSW.vpSize[1] = height;
 
@@ -3889,6 +5506,8 @@ void swScissor(int x, int y, int width, int height)
         return;
     }
 
+    SW_BINNING_FLUSH();
+
     RLSW.scMin[0] = sw_clampi(x, 0, RLSW.framebuffer.width - 1);
     RLSW.scMin[1] = sw_clampi(y, 0, RLSW.framebuffer.height - 1);
     RLSW.scMax[0] = sw_clampi(x + width, 0, RLSW.framebuffer.width - 1);
@@ -3903,29 +5522,31 @@ void swScissor(int x, int y, int width, int height)
 void swClearColor(float r, float g, float b, float a)
 {
     float v[4] = { r, g, b, a };
-    sw_framebuffer_write_color(&RLSW.clearValue, v);
+    sw_framebuffer_write_color(&RLSW.clearColor, v);
 }
 
 void swClearDepth(float depth)
 {
-    sw_framebuffer_write_depth(&RLSW.clearValue, depth);
+    sw_framebuffer_write_depth(&RLSW.clearDepth, depth);
 }
 
 void swClear(uint32_t bitmask)
 {
+    SW_BINNING_FLUSH();
+
     int size = RLSW.framebuffer.width*RLSW.framebuffer.height;
 
-    if ((bitmask & (SW_COLOR_BUFFER_BIT | SW_DEPTH_BUFFER_BIT)) == (SW_COLOR_BUFFER_BIT | SW_DEPTH_BUFFER_BIT))
-    {
-        sw_framebuffer_fill(RLSW.framebuffer.pixels, size, RLSW.clearValue);
-    }
-    else if (bitmask & (SW_COLOR_BUFFER_BIT))
+    if (bitmask & SW_COLOR_BUFFER_BIT)
     {
-        sw_framebuffer_fill_color(RLSW.framebuffer.pixels, size, RLSW.clearValue.color);
+        sw_framebuffer_fill_color(RLSW.framebuffer.color, size, RLSW.clearColor);
     }
-    else if (bitmask & SW_DEPTH_BUFFER_BIT)
+
+    if (bitmask & SW_DEPTH_BUFFER_BIT)
     {
-        sw_framebuffer_fill_depth(RLSW.framebuffer.pixels, size, RLSW.clearValue.depth);
+        sw_framebuffer_fill_depth(RLSW.framebuffer.depth, size, RLSW.clearDepth);
+
+        if (RLSW.stateFlags & SW_STATE_SCISSOR_TEST) sw_hiz_invalidate_rect(RLSW.scMin[0], RLSW.scMin[1], RLSW.scMax[0] + 1, RLSW.scMax[1] + 1);
+        else sw_hiz_set_rect(0, 0, RLSW.framebuffer.width, RLSW.framebuffer.height, sw_framebuffer_read_depth(&RLSW.clearDepth));
     }
 }
 
@@ -3938,6 +5559,10 @@ void swBlendFunc(SWfactor sfactor, SWfactor dfactor)
         return;
     }
 
+    if ((sfactor == RLSW.srcFactor) && (dfactor == RLSW.dstFactor)) return;
+
+    SW_BINNING_FLUSH();
+
     RLSW.srcFactor = sfactor;
     RLSW.dstFactor = dfactor;
 
@@ -3972,6 +5597,19 @@ void swBlendFunc(SWfactor sfactor, SWfactor dfactor)
         case SW_SRC_ALPHA_SATURATE: break;
         default: break;
     }
+
+    RLSW.blendMode = SW_BLEND_MODE_GENERIC;
+    if (dfactor == SW_ONE_MINUS_SRC_ALPHA)
+    {
+        if (sfactor == SW_SRC_ALPHA) RLSW.blendMode = SW_BLEND_MODE_ALPHA;
+        else if (sfactor == SW_DST_COLOR) RLSW.blendMode = SW_BLEND_MODE_MULTIPLIED;
+        else if (sfactor == SW_ONE) RLSW.blendMode = SW_BLEND_MODE_PREMULTIPLIED;
+    }
+    else if (dfactor == SW_ONE)
+    {
+        if (sfactor == SW_SRC_ALPHA) RLSW.blendMode = SW_BLEND_MODE_ADDITIVE;
+        else if (sfactor == SW_ONE) RLSW.blendMode = SW_BLEND_MODE_ADD_COLORS;
+    }
 }
 
 void swPolygonMode(SWpoly mode)
@@ -3998,11 +5636,13 @@ void swCullFace(SWface face)
 
 void swPointSize(float size)
 {
+    SW_BINNING_FLUSH();
     RLSW.pointRadius = floorf(size*0.5f);
 }
 
 void swLineWidth(float width)
 {
+    SW_BINNING_FLUSH();
     RLSW.lineWidth = roundf(width);
 }
 
@@ -4484,59 +6124,13 @@ void swDrawArrays(SWdraw mode, int offset, int count)
     swBegin(mode);
     {
         const float *texMatrix = RLSW.stackTexture[RLSW.stackTextureCounter - 1];
-        const float *defaultTexcoord = RLSW.current.texcoord;
-        const float *defaultColor = RLSW.current.color;
-        
-        const float *positions = RLSW.array.positions;
-        const float *texcoords = RLSW.array.texcoords;
-        const uint8_t *colors = RLSW.array.colors;
-
         int end = offset + count;
-        
+
+        // Vertices are fetched and transformed directly into the vertex buffer
         for (int i = offset; i < end; i++)
         {
-            float u, v;
-            if (texcoords)
-            {
-                int idx = 2*i;
-                u = texcoords[idx];
-                v = texcoords[idx + 1];
-            }
-            else
-            {
-                u = defaultTexcoord[0];
-                v = defaultTexcoord[1];
-            }
-
-            float texcoord[2];
-            texcoord[0] = texMatrix[0]*u + texMatrix[4]*v + texMatrix[12];
-            texcoord[1] = texMatrix[1]*u + texMatrix[5]*v + texMatrix[13];
-
-            float color[4] = {
-                defaultColor[0],
-                defaultColor[1],
-                defaultColor[2],
-                defaultColor[3]
-            };
-
-            if (colors)
-            {
-                int idx = 4*i;
-                color[0] *= (float)colors[idx]*SW_INV_255;
-                color[1] *= (float)colors[idx + 1]*SW_INV_255;
-                color[2] *= (float)colors[idx + 2]*SW_INV_255;
-                color[3] *= (float)colors[idx + 3]*SW_INV_255;
-            }
-
-            int idx = 3*i;
-            float position[4] = {
-                positions[idx],
-                positions[idx + 1],
-                positions[idx + 2],
-                1.0f
-            };
-
-            sw_immediate_push_vertex(position, color, texcoord);
+            sw_array_fetch_vertex(&RLSW.vertexBuffer[RLSW.vertexCounter], i, texMatrix);
+            sw_immediate_emit_vertex();
         }
     }
     swEnd();
@@ -4556,83 +6150,37 @@ void swDrawElements(SWdraw mode, int count, int type, const void *indices)
         return;
     }
 
-    const uint8_t *indicesUb = NULL;
-    const uint16_t *indicesUs = NULL;
-    const uint32_t *indicesUi = NULL;
-
-    switch (type)
+    if ((type != SW_UNSIGNED_BYTE) && (type != SW_UNSIGNED_SHORT) && (type != SW_UNSIGNED_INT))
     {
-        case SW_UNSIGNED_BYTE:
-            indicesUb = (const uint8_t *)indices;
-            break;
-        case SW_UNSIGNED_SHORT:
-            indicesUs = (const uint16_t *)indices;
-            break;
-        case SW_UNSIGNED_INT:
-            indicesUi = (const uint32_t *)indices;
-            break;
-        default:
-            RLSW.errCode = SW_INVALID_ENUM;
-            return;
+        RLSW.errCode = SW_INVALID_ENUM;
+        return;
     }
 
     swBegin(mode);
     {
         const float *texMatrix = RLSW.stackTexture[RLSW.stackTextureCounter - 1];
-        const float *defaultTexcoord = RLSW.current.texcoord;
-        const float *defaultColor = RLSW.current.color;
-        
-        const float *positions = RLSW.array.positions;
-        const float *texcoords = RLSW.array.texcoords;
-        const uint8_t *colors = RLSW.array.colors;
-        
-        for (int i = 0; i < count; i++)
+
+        // Cached vertices depend on the arrays, matrices and current attributes, only valid for this call
+        for (int i = 0; i < SW_VERTEX_CACHE_SIZE; i++) RLSW.vertexCacheTags[i] = UINT32_MAX;
+
+        switch (type)
         {
-            int index = indicesUb ? indicesUb[i] : 
-                       (indicesUs ? indicesUs[i] : indicesUi[i]);
-            
-            float u, v;
-            if (texcoords)
+            case SW_UNSIGNED_BYTE:
             {
-                int idx = 2*index;
-                u = texcoords[idx];
-                v = texcoords[idx + 1];
-            }
-            else
+                const uint8_t *indicesUb = (const uint8_t *)indices;
+                for (int i = 0; i < count; i++) sw_array_push_indexed(indicesUb[i], texMatrix);
+            } break;
+            case SW_UNSIGNED_SHORT:
             {
-                u = defaultTexcoord[0];
-                v = defaultTexcoord[1];
-            }
-
-            float texcoord[2];
-            texcoord[0] = texMatrix[0]*u + texMatrix[4]*v + texMatrix[12];
-            texcoord[1] = texMatrix[1]*u + texMatrix[5]*v + texMatrix[13];
-
-            float color[4] = {
-                defaultColor[0],
-                defaultColor[1],
-                defaultColor[2],
-                defaultColor[3]
-            };
-
-            if (colors)
+                const uint16_t *indicesUs = (const uint16_t *)indices;
+                for (int i = 0; i < count; i++) sw_array_push_indexed(indicesUs[i], texMatrix);
+            } break;
+            case SW_UNSIGNED_INT:
             {
-                int idx = 4*index;
-                color[0] *= (float)colors[idx]*SW_INV_255;
-                color[1] *= (float)colors[idx + 1]*SW_INV_255;
-                color[2] *= (float)colors[idx + 2]*SW_INV_255;
-                color[3] *= (float)colors[idx + 3]*SW_INV_255;
-            }
-
-            int idx = 3*index;
-            float position[4] = {
-                positions[idx],
-                positions[idx + 1],
-                positions[idx + 2],
-                1.0f
-            };
-
-            sw_immediate_push_vertex(position, color, texcoord);
+                const uint32_t *indicesUi = (const uint32_t *)indices;
+                for (int i = 0; i < count; i++) sw_array_push_indexed(indicesUi[i], texMatrix);
+            } break;
+            default: break;
         }
     }
     swEnd();
@@ -4663,6 +6211,8 @@ void swDeleteTextures(int count, uint32_t *textures)
 {
     if ((count == 0) || (textures == NULL)) return;
 
+    SW_BINNING_FLUSH();
+
     for (int i = 0; i < count; i++)
     {
         if (!sw_is_texture_valid(textures[i]))
@@ -4671,18 +6221,22 @@ void swDeleteTextures(int count, uint32_t *textures)
             continue;
         }
 
-        SW_FREE(RLSW.loadedTextures[textures[i]].pixels);
+        sw_texture_free(&RLSW.loadedTextures[textures[i]]);
 
-        RLSW.loadedTextures[textures[i]].pixels = NULL;
         RLSW.freeTextureIds[RLSW.freeTextureIdCount++] = textures[i];
     }
 }
 
 void swTexImage2D(int width, int height, SWformat format, SWtype type, const void *data)
+{
+    swTexImage2DLevel(0, width, height, format, type, data);
+}
+
+void swTexImage2DLevel(int level, int width, int height, SWformat format, SWtype type, const void *data)
 {
     uint32_t id = RLSW.currentTexture;
 
-    if (!sw_is_texture_valid(id))
+    if (!sw_is_texture_valid(id) || (id == 0))
     {
         RLSW.errCode = SW_INVALID_VALUE;
         return;
@@ -4698,27 +6252,117 @@ void swTexImage2D(int width, int height, SWformat format, SWtype type, const voi
 
     sw_texture_t *texture = &RLSW.loadedTextures[id];
 
-    int size = width*height;
-    texture->pixels = SW_MALLOC(4*size);
+    // Mipmap levels must be uploaded in order, after the base level, with matching dimensions
+    if ((level < 0) || (level >= SW_MAX_MIPMAP_LEVELS) || (width <= 0) || (height <= 0) ||
+        ((level > 0) && ((level > texture->mipmapCount) ||
+                         (width != sw_maxi(texture->width >> level, 1)) ||
+                         (height != sw_maxi(texture->height >> level, 1)))))
+    {
+        RLSW.errCode = SW_INVALID_VALUE;
+        return;
+    }
+
+    SW_BINNING_FLUSH();
 
-    if (texture->pixels == NULL)
+    uint8_t *pixels = (uint8_t *)SW_MALLOC(4*sw_texture_texel_count(width, height));
+
+    if (pixels == NULL)
     {
         RLSW.errCode = SW_STACK_OVERFLOW; // WARNING: Out of memory...
         return;
     }
 
-    for (int i = 0; i < size; i++)
+    sw_mipmap_t mip = { 0 };
+    sw_texture_init_mipmap(&mip, pixels, width, height);
+
+    for (int y = 0, i = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++, i++)
+        {
+            uint32_t *dst = &((uint32_t*)pixels)[sw_texture_texel_index(&mip, x, y)];
+            sw_get_pixel((uint8_t*)dst, data, i, pixelFormat);
+        }
+    }
+
+    if (level == 0)
+    {
+        // A new base level invalidates all the previous levels
+        sw_texture_free(texture);
+
+        texture->pixels = pixels;
+        texture->width = width;
+        texture->height = height;
+        texture->wMinus1 = width - 1;
+        texture->hMinus1 = height - 1;
+        texture->tx = 1.0f/width;
+        texture->ty = 1.0f/height;
+    }
+    else if (level < texture->mipmapCount) SW_FREE(texture->mipmaps[level].pixels);
+
+    texture->mipmaps[level] = mip;
+
+    if (level == texture->mipmapCount) texture->mipmapCount++;
+}
+
+void swGenerateMipmap(void)
+{
+    uint32_t id = RLSW.currentTexture;
+
+    if (!sw_is_texture_valid(id) || (id == 0) || (RLSW.loadedTextures[id].pixels == RLSW.loadedTextures[0].pixels))
     {
-        uint32_t *dst = &((uint32_t*)texture->pixels)[i];
-        sw_get_pixel((uint8_t*)dst, data, i, pixelFormat);
+        RLSW.errCode = SW_INVALID_OPERATION;
+        return;
     }
 
-    texture->width = width;
-    texture->height = height;
-    texture->wMinus1 = width - 1;
-    texture->hMinus1 = height - 1;
-    texture->tx = 1.0f/width;
-    texture->ty = 1.0f/height;
+    SW_BINNING_FLUSH();
+
+    sw_texture_t *texture = &RLSW.loadedTextures[id];
+
+    for (int i = 1; i < texture->mipmapCount; i++) SW_FREE(texture->mipmaps[i].pixels);
+    texture->mipmapCount = 1;
+
+    // Every level is a 2x2 box filter of the previous one, the last row/column
+    // is duplicated when the previous level has odd dimensions
+    for (int level = 1; level < SW_MAX_MIPMAP_LEVELS; level++)
+    {
+        const sw_mipmap_t *src = &texture->mipmaps[level - 1];
+        if ((src->width == 1) && (src->height == 1)) break;
+
+        int width = sw_maxi(src->width >> 1, 1);
+        int height = sw_maxi(src->height >> 1, 1);
+
+        uint8_t *pixels = (uint8_t *)SW_MALLOC(4*sw_texture_texel_count(width, height));
+        if (pixels == NULL)
+        {
+            RLSW.errCode = SW_STACK_OVERFLOW; // WARNING: Out of memory...
+            break;
+        }
+
+        sw_mipmap_t *mip = &texture->mipmaps[level];
+        sw_texture_init_mipmap(mip, pixels, width, height);
+
+        for (int y = 0; y < height; y++)
+        {
+            int y0 = sw_mini(2*y, src->hMinus1);
+            int y1 = sw_mini(2*y + 1, src->hMinus1);
+
+            for (int x = 0; x < width; x++)
+            {
+                int x0 = sw_mini(2*x, src->wMinus1);
+                int x1 = sw_mini(2*x + 1, src->wMinus1);
+
+                const uint8_t *p00 = &src->pixels[4*sw_texture_texel_index(src, x0, y0)];
+                const uint8_t *p10 = &src->pixels[4*sw_texture_texel_index(src, x1, y0)];
+                const uint8_t *p01 = &src->pixels[4*sw_texture_texel_index(src, x0, y1)];
+                const uint8_t *p11 = &src->pixels[4*sw_texture_texel_index(src, x1, y1)];
+                uint8_t *dst = &pixels[4*sw_texture_texel_index(mip, x, y)];
+
+                for (int c = 0; c < 4; c++) dst[c] = (uint8_t)((p00[c] + p10[c] + p01[c] + p11[c] + 2) >> 2);
+            }
+        }
+
+        texture->mipmapCount++;
+    }
 }
 
 void swTexParameteri(int param, int value)
@@ -4731,6 +6375,8 @@ void swTexParameteri(int param, int value)
         return;
     }
 
+    SW_BINNING_FLUSH();
+
     sw_texture_t *texture = &RLSW.loadedTextures[id];
 
     switch (param)
@@ -1267,7 +1267,16 @@ void SwapScreenBuffer(void)
 #if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
     // NOTE: We use a preprocessor condition here because `rlCopyFramebuffer` is only declared for software rendering
     SDL_Surface *surface = SDL_GetWindowSurface(platform.window);
-    rlCopyFramebuffer(0, 0, CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, surface->pixels);
+
+    // Render directly into the window surface when its memory layout matches the framebuffer,
+    // after the first frame no copy is required, otherwise the framebuffer is converted into it
+    bool surfaceBound = false;
+    if ((surface->w == CORE.Window.render.width) && (surface->h == CORE.Window.render.height) && (surface->pitch == surface->w*4))
+    {
+        surfaceBound = rlBindFramebufferColor(CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, surface->pixels);
+    }
+
+    if (!surfaceBound) rlCopyFramebuffer(0, 0, CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, surface->pixels);
     SDL_UpdateWindowSurface(platform.window);
 #else
     SDL_GL_SwapWindow(platform.window);
@@ -1480,6 +1489,10 @@ void PollInputEvents(void)
                     {
                         const int width = event.window.data1;
                         const int height = event.window.data2;
+                        #if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+                        // Window surface is recreated on resize, stop rendering into it
+                        rlBindFramebufferColor(CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, NULL);
+                        #endif
                         SetupViewport(width, height);
                         // if we are doing automatic DPI scaling, then the "screen" size is divided by the window scale
                         if (IsWindowState(FLAG_WINDOW_HIGHDPI))
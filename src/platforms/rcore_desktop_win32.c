@@ -1210,7 +1210,14 @@ void SwapScreenBuffer(void)
 
 #if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
     // Update framebuffer
-    rlCopyFramebuffer(0, 0, CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, platform.pixels);
+    // NOTE: Rendering is done directly into the DIB section once bound, only the first frame
+    // (or any frame with mismatching dimensions) requires a framebuffer copy
+    // WARNING: DIB section is released on window destruction, nothing to update then
+    if ((platform.pixels != NULL) &&
+        !rlBindFramebufferColor(CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, platform.pixels))
+    {
+        rlCopyFramebuffer(0, 0, CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, platform.pixels);
+    }
 
     // Force redraw
     InvalidateRect(platform.hwnd, NULL, FALSE);
@@ -1702,6 +1709,11 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lpara
             // Clean up for window destruction
             if (rlGetVersion() == RL_OPENGL_11_SOFTWARE) // Using software renderer
             {
+#if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+                // Restore internal color buffer before releasing the DIB section it could be bound to
+                // NOTE: No-op if rlgl has already been closed
+                rlBindFramebufferColor(CORE.Window.render.width, CORE.Window.render.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, NULL);
+#endif
                 if (platform.hdcmem)
                 {
                     DeleteDC(platform.hdcmem);
@@ -1898,8 +1910,8 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lpara
                 PAINTSTRUCT ps = { 0 };
                 HDC hdc = BeginPaint(hwnd, &ps);
 
-                // Blit from memory DC to window DC
-                BitBlt(hdc, 0, 0, platform.appScreenWidth, platform.appScreenHeight, platform.hdcmem, 0, 0, SRCCOPY);
+                // Blit from memory DC to window DC, if not released yet
+                if (platform.hdcmem != NULL) BitBlt(hdc, 0, 0, platform.appScreenWidth, platform.appScreenHeight, platform.hdcmem, 0, 0, SRCCOPY);
 
                 EndPaint(hwnd, &ps);
             }
@@ -341,6 +341,10 @@ typedef struct Camera2D {
     float zoom;             // Camera zoom (scaling), should be 1.0f by default
 } Camera2D;
 
+// Opaque mesh bounding volume hierarchy declaration
+// NOTE: Actual struct is defined internally in rmodels module
+typedef struct rMeshBVH rMeshBVH;
+
 // Mesh, vertex data and vao/vbo
 typedef struct Mesh {
     int vertexCount;        // Number of vertices stored in arrays
@@ -354,6 +358,7 @@ typedef struct Mesh {
     float *tangents;        // Vertex tangents (XYZW - 4 components per vertex) (shader-location = 4)
     unsigned char *colors;      // Vertex colors (RGBA - 4 components per vertex) (shader-location = 3)
     unsigned short *indices;    // Vertex indices (in case vertex data comes indexed)
+    unsigned int *indices32;    // Vertex indices 32-bit, used instead of indices for more than 65535 vertices (NULL if not required)
 
     // Animation vertex data
     float *animVertices;    // Animated vertex positions (after bones transformations)
@@ -366,6 +371,9 @@ typedef struct Mesh {
     // OpenGL identifiers
     unsigned int vaoId;     // OpenGL Vertex Array Object id
     unsigned int *vboId;    // OpenGL Vertex Buffer Objects id (default vertex data)
+
+    // Collision data
+    rMeshBVH *bvh;          // Triangles bounding volume hierarchy, ray collision acceleration (NULL if not generated)
 } Mesh;
 
 // Shader
@@ -417,13 +425,19 @@ typedef struct Model {
     Transform *bindPose;    // Bones base transformation (pose)
 } Model;
 
+// Opaque animation keyframes declaration
+// NOTE: Actual struct is defined internally in rmodels module
+typedef struct rAnimationCurves rAnimationCurves;
+
 // ModelAnimation
 typedef struct ModelAnimation {
     int boneCount;          // Number of bones
     int frameCount;         // Number of animation frames
     BoneInfo *bones;        // Bones information (skeleton)
-    Transform **framePoses; // Poses array by frame
+    Transform **framePoses; // Poses array by frame (NULL for glTF animations if SUPPORT_GLTF_BAKED_POSES is disabled)
     char name[32];          // Animation name
+    float frameRate;        // Animation frames per second (frame index to time)
+    rAnimationCurves *curves; // Animation keyframes by bone, sampled at any time (NULL if poses baked by frame)
 } ModelAnimation;
 
 // Ray, ray for raycasting
@@ -446,6 +460,16 @@ typedef struct BoundingBox {
     Vector3 max;            // Maximum vertex box-corner
 } BoundingBox;
 
+// Terrain, heightmap split in chunks with multiple levels of detail
+typedef struct Terrain {
+    int chunkCountX;        // Number of chunks along X axis
+    int chunkCountZ;        // Number of chunks along Z axis
+    int lodCount;           // Number of levels of detail by chunk
+    float lodDistance;      // Camera distance to chunk drawn with full detail, doubled by every level of detail
+    Mesh *meshes;           // Chunks meshes array, lodCount meshes by chunk (highest detail first)
+    BoundingBox *bounds;    // Chunks bounding boxes array (terrain space)
+} Terrain;
+
 // Wave, audio wave data
 typedef struct Wave {
     unsigned int frameCount;    // Total number of frames (considering channels)
@@ -1439,6 +1463,8 @@ RLAPI void UpdateTextureRec(Texture2D texture, Rectangle rec, const void *pixels
 RLAPI void GenTextureMipmaps(Texture2D *texture);                                                        // Generate GPU mipmaps for a texture
 RLAPI void SetTextureFilter(Texture2D texture, int filter);                                              // Set texture scaling filter mode
 RLAPI void SetTextureWrap(Texture2D texture, int wrap);                                                  // Set texture wrapping mode
+RLAPI void EnableTextureAtlas(int pageSize, int maxTextureSize);                                         // Enable automatic packing of small textures into shared atlas pages (textures loaded afterwards)
+RLAPI void DisableTextureAtlas(void);                                                                    // Disable automatic texture atlas packing, unload atlas pages
 
 // Texture drawing functions
 RLAPI void DrawTexture(Texture2D texture, int posX, int posY, Color tint);                               // Draw a Texture2D
@@ -1446,6 +1472,7 @@ RLAPI void DrawTextureV(Texture2D texture, Vector2 position, Color tint);
 RLAPI void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint);  // Draw a Texture2D with extended parameters
 RLAPI void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint);            // Draw a part of a texture defined by a rectangle
 RLAPI void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint); // Draw a part of a texture defined by a rectangle with 'pro' parameters
+RLAPI void DrawTextureBatch(Texture2D texture, const Rectangle *sources, const Rectangle *dests, int count, Vector2 origin, float rotation, Color tint); // Draw multiple parts of a texture with shared 'pro' parameters, submitted in bulk
 RLAPI void DrawTextureNPatch(Texture2D texture, NPatchInfo nPatchInfo, Rectangle dest, Vector2 origin, float rotation, Color tint); // Draws a texture (or part of it) that stretches or shrinks nicely
 
 // Color/pixel related functions
@@ -1596,6 +1623,9 @@ RLAPI void DrawMesh(Mesh mesh, Material material, Matrix transform);
 RLAPI void DrawMeshInstanced(Mesh mesh, Material material, const Matrix *transforms, int instances); // Draw multiple mesh instances with material and different transforms
 RLAPI BoundingBox GetMeshBoundingBox(Mesh mesh);                                            // Compute mesh bounding box limits
 RLAPI void GenMeshTangents(Mesh *mesh);                                                     // Compute mesh tangents
+RLAPI void GenMeshBVH(Mesh *mesh);                                                          // Compute mesh triangles bounding volume hierarchy (ray collision acceleration)
+RLAPI void UnloadMeshBVH(Mesh *mesh);                                                       // Unload mesh triangles bounding volume hierarchy
+RLAPI void OptimizeMesh(Mesh *mesh);                                                        // Weld duplicated vertices, generate indices and reorder triangles for vertex cache
 RLAPI bool ExportMesh(Mesh mesh, const char *fileName);                                     // Export mesh data to file, returns true on success
 RLAPI bool ExportMeshAsCode(Mesh mesh, const char *fileName);                               // Export mesh as code file (.h) defining multiple arrays of vertex attributes
 
@@ -1612,6 +1642,11 @@ RLAPI Mesh GenMeshKnot(float radius, float size, int radSeg, int sides);
 RLAPI Mesh GenMeshHeightmap(Image heightmap, Vector3 size);                                 // Generate heightmap mesh from image data
 RLAPI Mesh GenMeshCubicmap(Image cubicmap, Vector3 cubeSize);                               // Generate cubes-based map mesh from image data
 
+// Terrain management functions
+RLAPI Terrain LoadTerrain(Image heightmap, Vector3 size, int chunkSize, int lodCount);      // Load terrain from heightmap image data, split in chunks with levels of detail
+RLAPI void UnloadTerrain(Terrain terrain);                                                  // Unload terrain chunks meshes from memory (RAM and/or VRAM)
+RLAPI void DrawTerrain(Camera camera, Terrain terrain, Material material, Vector3 position); // Draw terrain chunks visible by camera, level of detail selected by camera distance
+
 // Material loading/unloading functions
 RLAPI Material *LoadMaterials(const char *fileName, int *materialCount);                    // Load materials from model file
 RLAPI Material LoadMaterialDefault(void);                                                   // Load default material (Supports: DIFFUSE, SPECULAR, NORMAL maps)
@@ -1624,6 +1659,16 @@ RLAPI void SetModelMeshMaterial(Model *model, int meshId, int materialId);
 RLAPI ModelAnimation *LoadModelAnimations(const char *fileName, int *animCount);            // Load model animations from file
 RLAPI void UpdateModelAnimation(Model model, ModelAnimation anim, int frame);               // Update model animation pose (CPU)
 RLAPI void UpdateModelAnimationBones(Model model, ModelAnimation anim, int frame);          // Update model animation mesh bone matrices (GPU skinning)
+RLAPI void SampleModelAnimation(Model model, ModelAnimation anim, float time);              // Update model animation pose at any time, interpolated (CPU)
+RLAPI void SampleModelAnimationBones(Model model, ModelAnimation anim, float time);         // Update model animation mesh bone matrices at any time, interpolated (GPU skinning)
+RLAPI void GetModelAnimationPose(ModelAnimation anim, float time, Transform *pose);         // Get model animation bones transforms at any time (model space)
+RLAPI Transform *LoadModelAnimationPose(Model model);                                       // Load model animation pose buffer, bind pose (local space)
+RLAPI void UnloadModelAnimationPose(Transform *pose);                                      // Unload model animation pose buffer
+RLAPI float *LoadModelAnimationMask(Model model, const char *boneName);                    // Load model animation bones mask, bone and its children
+RLAPI void UnloadModelAnimationMask(float *mask);                                          // Unload model animation bones mask
+RLAPI void BlendModelAnimationPose(Model model, ModelAnimation anim, float time, float weight, const float *boneMask, Transform *pose); // Blend model animation at any time into pose buffer (local space)
+RLAPI void UpdateModelAnimationPose(Model model, const Transform *pose);                   // Update model animation from pose buffer (CPU)
+RLAPI void UpdateModelAnimationPoseBones(Model model, const Transform *pose);              // Update model animation mesh bone matrices from pose buffer (GPU skinning)
 RLAPI void UnloadModelAnimation(ModelAnimation anim);                                       // Unload animation data
 RLAPI void UnloadModelAnimations(ModelAnimation *animations, int animCount);                // Unload animation array data
 RLAPI bool IsModelAnimationValid(Model model, ModelAnimation anim);                         // Check model animation skeleton match
@@ -1635,6 +1680,7 @@ RLAPI bool CheckCollisionBoxSphere(BoundingBox box, Vector3 center, float radius
 RLAPI RayCollision GetRayCollisionSphere(Ray ray, Vector3 center, float radius);            // Get collision info between ray and sphere
 RLAPI RayCollision GetRayCollisionBox(Ray ray, BoundingBox box);                            // Get collision info between ray and box
 RLAPI RayCollision GetRayCollisionMesh(Ray ray, Mesh mesh, Matrix transform);               // Get collision info between ray and mesh
+RLAPI void GetRaysCollisionMesh(const Ray *rays, int rayCount, Mesh mesh, Matrix transform, RayCollision *collisions); // Get collision info between multiple rays and mesh
 RLAPI RayCollision GetRayCollisionTriangle(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3);    // Get collision info between ray and triangle
 RLAPI RayCollision GetRayCollisionQuad(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4); // Get collision info between ray and quad
 
@@ -771,6 +771,10 @@ void CloseWindow(void)
     UnloadFontDefault();        // WARNING: Module required: rtext
 #endif
 
+#if defined(SUPPORT_MODULE_RTEXTURES) && defined(SUPPORT_TEXTURE_ATLAS)
+    DisableTextureAtlas();      // Unload texture atlas pages, if any
+#endif
+
     rlglClose();                // De-init rlgl
 
     // De-initialize platform
@@ -47,12 +47,18 @@
 *       #define RLGL_ENABLE_OPENGL_DEBUG_CONTEXT
 *           Enable debug context (only available on OpenGL 4.3)
 *
+*       #define RLGL_ENABLE_THREADED_RECORDING
+*           Keep rlgl internal state thread-local, so worker threads can record draw calls
+*           into their own render batches (rlBeginRecording()), submitted later on render thread
+*
 *       rlgl capabilities could be customized just defining some internal
 *       values before library inclusion (default values listed):
 *
 *       #define RL_DEFAULT_BATCH_BUFFER_ELEMENTS   8192    // Default internal render batch elements limits
 *       #define RL_DEFAULT_BATCH_BUFFERS              1    // Default number of batch buffers (multi-buffering)
 *       #define RL_DEFAULT_BATCH_DRAWCALLS          256    // Default number of batch draw calls (by state changes: mode, texture)
+*       #define RL_DEFAULT_BATCH_FLAGS                0    // Default render batch flags (rlRenderBatchFlags: RL_RENDER_BATCH_STREAMING...)
+*       #define RL_DEFAULT_BATCH_SORT_WINDOW         32    // Default number of previous draw calls checked to merge a draw call (RL_RENDER_BATCH_SORTED)
 *       #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS    4    // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 *
 *       #define RL_MAX_MATRIX_STACK_SIZE             32    // Maximum size of internal Matrix stack
@@ -225,6 +231,15 @@
 #ifndef RL_DEFAULT_BATCH_DRAWCALLS
     #define RL_DEFAULT_BATCH_DRAWCALLS             256      // Default number of batch draw calls (by state changes: mode, texture)
 #endif
+#ifndef RL_DEFAULT_BATCH_FLAGS
+    #define RL_DEFAULT_BATCH_FLAGS                   0      // Default render batch flags (rlRenderBatchFlags)
+#endif
+#ifndef RL_DEFAULT_BATCH_STREAM_BUFFERS
+    #define RL_DEFAULT_BATCH_STREAM_BUFFERS          3      // Minimum number of batch buffers in the ring when persistently mapped (RL_RENDER_BATCH_STREAMING)
+#endif
+#ifndef RL_DEFAULT_BATCH_SORT_WINDOW
+    #define RL_DEFAULT_BATCH_SORT_WINDOW            32      // Maximum number of previous draw calls checked to merge a draw call (RL_RENDER_BATCH_SORTED)
+#endif
 #ifndef RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS
     #define RL_DEFAULT_BATCH_MAX_TEXTURE_UNITS       4      // Maximum number of textures units that can be activated on batch drawing (SetShaderValueTexture())
 #endif
@@ -279,6 +294,8 @@
 
 // GL equivalent data types
 #define RL_UNSIGNED_BYTE                        0x1401      // GL_UNSIGNED_BYTE
+#define RL_UNSIGNED_SHORT                       0x1403      // GL_UNSIGNED_SHORT
+#define RL_UNSIGNED_INT                         0x1405      // GL_UNSIGNED_INT
 #define RL_FLOAT                                0x1406      // GL_FLOAT
 
 // GL buffer usage hint
@@ -387,6 +404,13 @@ typedef struct Matrix {
 #define RL_MATRIX_TYPE
 #endif
 
+// Compact vertex, interleaved in a single stream (RL_RENDER_BATCH_COMPACT)
+typedef struct rlVertexCompact {
+    float position[2];          // Vertex position (XY - 2 components) (shader-location = 0)
+    unsigned short texcoord[2]; // Vertex texture coordinates (UV - 2 components, unorm16) (shader-location = 1)
+    unsigned char color[4];     // Vertex color (RGBA - 4 components) (shader-location = 3)
+} rlVertexCompact;
+
 // Dynamic vertex buffers (position + texcoords + colors + indices arrays)
 typedef struct rlVertexBuffer {
     int elementCount;           // Number of elements in the buffer (QUADS)
@@ -395,6 +419,7 @@ typedef struct rlVertexBuffer {
     float *texcoords;           // Vertex texture coordinates (UV - 2 components per vertex) (shader-location = 1)
     float *normals;             // Vertex normal (XYZ - 3 components per vertex) (shader-location = 2)
     unsigned char *colors;      // Vertex colors (RGBA - 4 components per vertex) (shader-location = 3)
+    rlVertexCompact *compactVertices; // Vertex data interleaved, replaces previous arrays (RL_RENDER_BATCH_COMPACT)
 #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
     unsigned int *indices;      // Vertex indices (in case vertex data comes indexed) (6 indices per quad)
 #endif
@@ -403,6 +428,9 @@ typedef struct rlVertexBuffer {
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
     unsigned int vboId[5];      // OpenGL Vertex Buffer Objects id (5 types of vertex data)
+    bool immutable;             // Vertex buffers use immutable storage, they can not be orphaned (RL_RENDER_BATCH_STREAMING)
+    bool mapped;                // Vertex data arrays point to persistently mapped GPU memory (RL_RENDER_BATCH_STREAMING)
+    void *fence;                // Sync object signaled once the GPU is done with the buffer (RL_RENDER_BATCH_STREAMING)
 } rlVertexBuffer;
 
 // Draw call type
@@ -421,6 +449,15 @@ typedef struct rlDrawCall {
     //Matrix modelview;         // Modelview matrix for this draw -> Using RLGL.modelview by default
 } rlDrawCall;
 
+// Quad type, used for bulk submission with rlPushQuads()
+// NOTE: Vertex are provided in the same order as RL_QUADS drawing:
+// top-left, bottom-left, bottom-right, top-right
+typedef struct rlQuad {
+    float positions[8];         // Vertex position (XY - 2 components per vertex)
+    float texcoords[8];         // Vertex texture coordinates (UV - 2 components per vertex)
+    unsigned char color[4];     // Quad color (RGBA - 4 components, shared by the 4 vertex)
+} rlQuad;
+
 // rlRenderBatch type
 typedef struct rlRenderBatch {
     int bufferCount;            // Number of vertex buffers (multi-buffering support)
@@ -430,6 +467,9 @@ typedef struct rlRenderBatch {
     rlDrawCall *draws;          // Draw calls array, depends on textureId
     int drawCounter;            // Draw calls counter
     float currentDepth;         // Current depth value for next draw
+    int drawCapacity;           // Draw calls array size, RL_DEFAULT_BATCH_DRAWCALLS (RL_RENDER_BATCH_RECORDING grows it)
+    int flags;                  // Render batch flags (rlRenderBatchFlags)
+    void *sortBuffer;           // Scratch vertex data used to reorder draw calls (RL_RENDER_BATCH_SORTED)
 } rlRenderBatch;
 
 // OpenGL version
@@ -600,6 +640,14 @@ typedef enum {
     RL_CULL_FACE_BACK
 } rlCullMode;
 
+// Render batch flags
+typedef enum {
+    RL_RENDER_BATCH_COMPACT = 1,        // Vertex data in a single interleaved stream (rlVertexCompact): XY position, unorm16 UV, RGBA color, no normals
+    RL_RENDER_BATCH_STREAMING = 2,      // Vertex data streamed: persistently mapped ring of buffers (GL 4.4/GL_ARB_buffer_storage) or buffer orphaning
+    RL_RENDER_BATCH_SORTED = 4,         // Draw calls sharing mode and texture merged on draw, reordered only where they do not overlap
+    RL_RENDER_BATCH_RECORDING = 8       // Vertex data recorded in CPU memory only, growing as required, submitted to the active batch later
+} rlRenderBatchFlags;
+
 //------------------------------------------------------------------------------------
 // Functions Declaration - Matrix operations
 //------------------------------------------------------------------------------------
@@ -636,6 +684,7 @@ RLAPI void rlNormal3f(float x, float y, float z);       // Define one vertex (no
 RLAPI void rlColor4ub(unsigned char r, unsigned char g, unsigned char b, unsigned char a); // Define one vertex (color) - 4 byte
 RLAPI void rlColor3f(float x, float y, float z);        // Define one vertex (color) - 3 float
 RLAPI void rlColor4f(float x, float y, float z, float w); // Define one vertex (color) - 4 float
+RLAPI void rlPushQuads(const rlQuad *quads, int count, unsigned int textureId); // Push an array of quads with a texture (0 for default), bypassing per-vertex calls
 
 //------------------------------------------------------------------------------------
 // Functions Declaration - OpenGL style functions (common to 1.1, 3.3+, ES2)
@@ -733,11 +782,15 @@ RLAPI int *rlGetShaderLocsDefault(void);                // Get default shader lo
 // NOTE: rlgl provides a default render batch to behave like OpenGL 1.1 immediate mode
 // but this render batch API is exposed in case of custom batches are required
 RLAPI rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements); // Load a render batch system
+RLAPI rlRenderBatch rlLoadRenderBatchEx(int numBuffers, int bufferElements, int flags); // Load a render batch system with flags (rlRenderBatchFlags)
 RLAPI void rlUnloadRenderBatch(rlRenderBatch batch);    // Unload render batch system
 RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);     // Draw render batch data (Update->Draw->Reset)
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch); // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);               // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);         // Check internal buffer overflow for a given number of vertex
+RLAPI void rlBeginRecording(rlRenderBatch *batch);      // Begin recording draw calls into a render batch (RL_RENDER_BATCH_RECORDING) on calling thread
+RLAPI void rlEndRecording(void);                        // End recording draw calls, calling thread rlgl state is restored
+RLAPI void rlSubmitRenderBatch(const rlRenderBatch *batch); // Submit a recorded render batch into the active render batch (render thread)
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
@@ -756,8 +809,10 @@ RLAPI void rlSetVertexAttributeDivisor(unsigned int index, int divisor); // Set
 RLAPI void rlSetVertexAttributeDefault(int locIndex, const void *value, int attribType, int count); // Set vertex attribute default value, when attribute to provided
 RLAPI void rlDrawVertexArray(int offset, int count);    // Draw vertex array (currently active vao)
 RLAPI void rlDrawVertexArrayElements(int offset, int count, const void *buffer); // Draw vertex array elements
+RLAPI void rlDrawVertexArrayElementsEx(int offset, int count, const void *buffer, int type); // Draw vertex array elements, indices type: RL_UNSIGNED_SHORT or RL_UNSIGNED_INT
 RLAPI void rlDrawVertexArrayInstanced(int offset, int count, int instances); // Draw vertex array (currently active vao) with instancing
 RLAPI void rlDrawVertexArrayElementsInstanced(int offset, int count, const void *buffer, int instances); // Draw vertex array elements with instancing
+RLAPI void rlDrawVertexArrayElementsInstancedEx(int offset, int count, const void *buffer, int instances, int type); // Draw vertex array elements with instancing, indices type: RL_UNSIGNED_SHORT or RL_UNSIGNED_INT
 
 // Textures management
 RLAPI unsigned int rlLoadTexture(const void *data, int width, int height, int format, int mipmapCount); // Load texture data
@@ -779,6 +834,7 @@ RLAPI void rlUnloadFramebuffer(unsigned int id);                          // Del
 #if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
 RLAPI void rlCopyFramebuffer(int x, int y, int width, int height, int format, void *pixels); // Copy framebuffer pixel data to internal buffer
 RLAPI void rlResizeFramebuffer(int width, int height);                    // Resize internal framebuffer
+RLAPI bool rlBindFramebufferColor(int width, int height, int format, void *pixels); // Render into external color memory (zero-copy), NULL restores internal buffer
 #endif
 
 // Shaders management
@@ -914,6 +970,15 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
 #include <string.h>                     // Required for: strcmp(), strlen() [Used in rlglInit(), on extensions loading]
 #include <math.h>                       // Required for: sqrtf(), sinf(), cosf(), floor(), log()
 
+// SIMD support, used to transform batch quads
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define RL_SIMD_SSE2
+    #include <emmintrin.h>              // Required for: _mm_loadu_ps(), _mm_shuffle_ps(), _mm_mul_ps(), _mm_add_ps()
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    #define RL_SIMD_NEON
+    #include <arm_neon.h>               // Required for: vld1q_f32(), vtrnq_f32(), vmulq_f32(), vaddq_f32()
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -999,6 +1064,17 @@ RLAPI void rlLoadDrawQuad(void);     // Load and draw a quad
     #endif
 #endif
 
+// Thread-local storage specifier for rlgl internal state
+#if defined(RLGL_ENABLE_THREADED_RECORDING)
+    #if defined(_MSC_VER)
+        #define RLGL_THREAD_LOCAL __declspec(thread)
+    #else
+        #define RLGL_THREAD_LOCAL __thread
+    #endif
+#else
+    #define RLGL_THREAD_LOCAL
+#endif
+
 // Default shader vertex attribute names to set location points
 #ifndef RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION
     #define RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION     "vertexPosition"    // Bound by default to shader location: RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION
@@ -1135,6 +1211,8 @@ typedef struct rlglData {
         bool texAnisoFilter;                // Anisotropic texture filtering support (GL_EXT_texture_filter_anisotropic)
         bool computeShader;                 // Compute shaders support (GL_ARB_compute_shader)
         bool ssbo;                          // Shader storage buffer object support (GL_ARB_shader_storage_buffer_object)
+        bool bufferStorage;                 // Immutable buffer storage and persistent mapping support (GL_ARB_buffer_storage)
+        bool indexUint;                     // 32-bit vertex indices support (GL_OES_element_index_uint)
 
         float maxAnisotropyLevel;           // Maximum anisotropy level supported (minimum is 2.0f)
         int maxDepthBits;                   // Maximum bits for depth component
@@ -1151,7 +1229,10 @@ static double rlCullDistanceNear = RL_CULL_DISTANCE_NEAR;
 static double rlCullDistanceFar = RL_CULL_DISTANCE_FAR;
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-static rlglData RLGL = { 0 };
+static RLGL_THREAD_LOCAL rlglData RLGL = { 0 };
+static RLGL_THREAD_LOCAL rlglData RLGLRecording = { 0 };    // Calling thread state saved while recording (rlBeginRecording())
+static RLGL_THREAD_LOCAL bool rlRecording = false;          // Calling thread is recording into RLGL.currentBatch
+static rlglData *RLGLRender = NULL;                         // Render thread state (rlglInit()), default texture shared with recording threads
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
 #if defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_ES3)
@@ -1172,6 +1253,14 @@ static PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisor = NULL;
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static void rlLoadShaderDefault(void);      // Load default shader
 static void rlUnloadShaderDefault(void);    // Unload default shader
+static unsigned short rlFloatToUnorm16(float value); // Convert normalized float to unorm16, clamped to [0..1]
+static void rlLoadRenderBatchBufferData(int size, const void *data, bool persistent); // Load render batch vertex buffer data (bound GL_ARRAY_BUFFER)
+#if defined(GRAPHICS_API_OPENGL_33)
+static void rlMapRenderBatchBuffer(rlVertexBuffer *buffer, bool compact); // Map render batch vertex buffer persistently, replacing CPU arrays
+#endif
+static void rlSortRenderBatch(rlRenderBatch *batch);        // Merge render batch draw calls sharing mode and texture, keeping painter's order
+static void rlTransformQuad2D(const float *positions, const float *affine, float *result); // Transform quad positions by a 2D affine transform, 4 vertex at once
+static bool rlGrowRenderBatch(rlRenderBatch *batch, int vCount); // Grow recording render batch arrays to fit vCount more vertex and a new draw call
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 static const char *rlGetCompressedFormatName(int format); // Get compressed format official GL identifier name
 #endif  // RLGL_SHOW_GL_DETAILS_INFO
@@ -1561,6 +1650,26 @@ void rlVertex3f(float x, float y, float z)
         }
     }
 
+    if (RLGL.currentBatch->flags & RL_RENDER_BATCH_COMPACT)
+    {
+        // Add vertex data interleaved, depth and normal are not stored
+        rlVertexCompact *vertex = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].compactVertices[RLGL.State.vertexCounter];
+
+        vertex->position[0] = tx;
+        vertex->position[1] = ty;
+        vertex->texcoord[0] = rlFloatToUnorm16(RLGL.State.texcoordx);
+        vertex->texcoord[1] = rlFloatToUnorm16(RLGL.State.texcoordy);
+        vertex->color[0] = RLGL.State.colorr;
+        vertex->color[1] = RLGL.State.colorg;
+        vertex->color[2] = RLGL.State.colorb;
+        vertex->color[3] = RLGL.State.colora;
+
+        RLGL.State.vertexCounter++;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount++;
+
+        return;
+    }
+
     // Add vertices
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.State.vertexCounter] = tx;
     RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].vertices[3*RLGL.State.vertexCounter + 1] = ty;
@@ -1654,6 +1763,182 @@ void rlColor3f(float x, float y, float z)
 
 #endif
 
+// Push an array of quads to the render batch, bypassing per-vertex calls
+// NOTE: Every quad is equivalent to an rlBegin(RL_QUADS)/rlEnd() block with 4 vertex,
+// but data is written straight into the current vertex buffer, filled up to its limit
+void rlPushQuads(const rlQuad *quads, int count, unsigned int textureId)
+{
+    if ((quads == NULL) || (count <= 0)) return;
+
+    rlSetTexture(textureId);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);       // Normal vector pointing towards viewer
+
+#if defined(GRAPHICS_API_OPENGL_11)
+    for (int i = 0; i < count; i++)
+    {
+        rlColor4ub(quads[i].color[0], quads[i].color[1], quads[i].color[2], quads[i].color[3]);
+
+        for (int v = 0; v < 4; v++)
+        {
+            rlTexCoord2f(quads[i].texcoords[2*v], quads[i].texcoords[2*v + 1]);
+            rlVertex2f(quads[i].positions[2*v], quads[i].positions[2*v + 1]);
+        }
+    }
+#endif
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    const Matrix mat = RLGL.State.transform;
+    const float normal[3] = { RLGL.State.normalx, RLGL.State.normaly, RLGL.State.normalz };
+
+    // Transforms only rotating, scaling and translating XY (depth kept) are applied as 2x3
+    // affine transforms, all quad vertex at once; any other transform goes the full path
+    const bool transform2D = RLGL.State.transformRequired &&
+        (mat.m2 == 0.0f) && (mat.m6 == 0.0f) && (mat.m8 == 0.0f) && (mat.m9 == 0.0f) && (mat.m10 == 1.0f) && (mat.m14 == 0.0f);
+    const bool transformRequired = RLGL.State.transformRequired && !transform2D;
+    const float affine[6] = { mat.m0, mat.m1, mat.m4, mat.m5, mat.m12, mat.m13 };
+
+    int pushed = 0;
+
+    while (pushed < count)
+    {
+        // Number of quads fitting in current vertex buffer, a draw call is forced when full
+        // NOTE: Vertex counter is always aligned to 4 on RL_QUADS drawing
+        int available = (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4 - RLGL.State.vertexCounter)/4;
+
+        if (available <= 0)
+        {
+            rlCheckRenderBatchLimit(4);
+            continue;
+        }
+
+        int quadCount = ((count - pushed) < available)? (count - pushed) : available;
+
+        rlVertexBuffer *buffer = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer];
+        float depth = RLGL.currentBatch->currentDepth;
+
+        if (RLGL.currentBatch->flags & RL_RENDER_BATCH_COMPACT)
+        {
+            rlVertexCompact *vertex = buffer->compactVertices + RLGL.State.vertexCounter;
+
+            for (int i = 0; i < quadCount; i++)
+            {
+                const rlQuad *quad = &quads[pushed + i];
+                const float *positions = quad->positions;
+                float transformed[8];
+
+                if (transform2D)
+                {
+                    rlTransformQuad2D(quad->positions, affine, transformed);
+                    positions = transformed;
+                }
+
+                for (int v = 0; v < 4; v++, vertex++)
+                {
+                    float x = positions[2*v];
+                    float y = positions[2*v + 1];
+
+                    if (transformRequired)
+                    {
+                        vertex->position[0] = mat.m0*x + mat.m4*y + mat.m8*depth + mat.m12;
+                        vertex->position[1] = mat.m1*x + mat.m5*y + mat.m9*depth + mat.m13;
+                    }
+                    else
+                    {
+                        vertex->position[0] = x;
+                        vertex->position[1] = y;
+                    }
+
+                    vertex->texcoord[0] = rlFloatToUnorm16(quad->texcoords[2*v]);
+                    vertex->texcoord[1] = rlFloatToUnorm16(quad->texcoords[2*v + 1]);
+                    vertex->color[0] = quad->color[0];
+                    vertex->color[1] = quad->color[1];
+                    vertex->color[2] = quad->color[2];
+                    vertex->color[3] = quad->color[3];
+                }
+
+                if ((pushed + i) < (count - 1)) depth += (1.0f/20000.0f);
+            }
+        }
+        else
+        {
+            float *vertices = buffer->vertices + 3*RLGL.State.vertexCounter;
+            float *texcoords = buffer->texcoords + 2*RLGL.State.vertexCounter;
+            float *normals = buffer->normals + 3*RLGL.State.vertexCounter;
+            unsigned char *colors = buffer->colors + 4*RLGL.State.vertexCounter;
+
+            for (int i = 0; i < quadCount; i++)
+            {
+                const rlQuad *quad = &quads[pushed + i];
+                const float *positions = quad->positions;
+                float transformed[8];
+
+                if (transform2D)
+                {
+                    rlTransformQuad2D(quad->positions, affine, transformed);
+                    positions = transformed;
+                }
+
+                for (int v = 0; v < 4; v++)
+                {
+                    float x = positions[2*v];
+                    float y = positions[2*v + 1];
+
+                    if (transformRequired)
+                    {
+                        vertices[0] = mat.m0*x + mat.m4*y + mat.m8*depth + mat.m12;
+                        vertices[1] = mat.m1*x + mat.m5*y + mat.m9*depth + mat.m13;
+                        vertices[2] = mat.m2*x + mat.m6*y + mat.m10*depth + mat.m14;
+                    }
+                    else
+                    {
+                        vertices[0] = x;
+                        vertices[1] = y;
+                        vertices[2] = depth;
+                    }
+
+                    texcoords[0] = quad->texcoords[2*v];
+                    texcoords[1] = quad->texcoords[2*v + 1];
+
+                    normals[0] = normal[0];
+                    normals[1] = normal[1];
+                    normals[2] = normal[2];
+
+                    colors[0] = quad->color[0];
+                    colors[1] = quad->color[1];
+                    colors[2] = quad->color[2];
+                    colors[3] = quad->color[3];
+
+                    vertices += 3;
+                    texcoords += 2;
+                    normals += 3;
+                    colors += 4;
+                }
+
+                // Same depth increment as rlEnd(), once per quad, last quad increment done by rlEnd()
+                if ((pushed + i) < (count - 1)) depth += (1.0f/20000.0f);
+            }
+        }
+
+        RLGL.currentBatch->currentDepth = depth;
+        RLGL.State.vertexCounter += 4*quadCount;
+        RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount += 4*quadCount;
+        pushed += quadCount;
+    }
+
+    // Keep current vertex state as left by the last quad
+    const rlQuad *last = &quads[count - 1];
+    RLGL.State.texcoordx = last->texcoords[6];
+    RLGL.State.texcoordy = last->texcoords[7];
+    RLGL.State.colorr = last->color[0];
+    RLGL.State.colorg = last->color[1];
+    RLGL.State.colorb = last->color[2];
+    RLGL.State.colora = last->color[3];
+#endif
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
 //--------------------------------------------------------------------------------------
 // Module Functions Definition - OpenGL style functions (common to 1.1, 3.3+, ES2)
 //--------------------------------------------------------------------------------------
@@ -2316,9 +2601,10 @@ void rlglInit(int width, int height)
     // Init default vertex arrays buffers
     // Simulate that the default shader has the location RL_SHADER_LOC_VERTEX_NORMAL to bind the normal buffer for the default render batch
     RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL] = RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL;
-    RLGL.defaultBatch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+    RLGL.defaultBatch = rlLoadRenderBatchEx(RL_DEFAULT_BATCH_BUFFERS, RL_DEFAULT_BATCH_BUFFER_ELEMENTS, RL_DEFAULT_BATCH_FLAGS);
     RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL] = -1;
     RLGL.currentBatch = &RLGL.defaultBatch;
+    RLGLRender = &RLGL;
 
     // Init stack matrices (emulating OpenGL 1.1)
     for (int i = 0; i < RL_MAX_MATRIX_STACK_SIZE; i++) RLGL.State.stack[i] = rlMatrixIdentity();
@@ -2390,6 +2676,8 @@ void rlglClose(void)
 
     glDeleteTextures(1, &RLGL.State.defaultTextureId); // Unload default texture
     TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Default texture unloaded successfully", RLGL.State.defaultTextureId);
+
+    RLGLRender = NULL;
 #endif
 
 #if defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
@@ -2430,6 +2718,7 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.maxDepthBits = 32;
     RLGL.ExtSupported.texAnisoFilter = GLAD_GL_EXT_texture_filter_anisotropic;
     RLGL.ExtSupported.texMirrorClamp = GLAD_GL_EXT_texture_mirror_clamp;
+    RLGL.ExtSupported.indexUint = true;
 #else
     // Register supported extensions flags
     // OpenGL 3.3 extensions supported by default (core)
@@ -2442,6 +2731,7 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.maxDepthBits = 32;
     RLGL.ExtSupported.texAnisoFilter = true;
     RLGL.ExtSupported.texMirrorClamp = true;
+    RLGL.ExtSupported.indexUint = true;
 #endif
 
     // Optional OpenGL 3.3 extensions
@@ -2452,6 +2742,7 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.computeShader = GLAD_GL_ARB_compute_shader;
     RLGL.ExtSupported.ssbo = GLAD_GL_ARB_shader_storage_buffer_object;
     #endif
+    RLGL.ExtSupported.bufferStorage = GLAD_GL_ARB_buffer_storage && (glBufferStorage != NULL) && (glMapBufferRange != NULL) && (glFenceSync != NULL);
 
 #endif  // GRAPHICS_API_OPENGL_33
 
@@ -2468,6 +2759,7 @@ void rlLoadExtensions(void *loader)
     RLGL.ExtSupported.maxDepthBits = 24;
     RLGL.ExtSupported.texAnisoFilter = true;
     RLGL.ExtSupported.texMirrorClamp = true;
+    RLGL.ExtSupported.indexUint = true;
     // TODO: Check for additional OpenGL ES 3.0 supported extensions:
     //RLGL.ExtSupported.texCompDXT = true;
     //RLGL.ExtSupported.texCompETC1 = true;
@@ -2614,6 +2906,9 @@ void rlLoadExtensions(void *loader)
 
         // Check clamp mirror wrap mode support
         if (strcmp(extList[i], (const char *)"GL_EXT_texture_mirror_clamp") == 0) RLGL.ExtSupported.texMirrorClamp = true;
+
+        // Check 32-bit vertex indices support
+        if (strcmp(extList[i], (const char *)"GL_OES_element_index_uint") == 0) RLGL.ExtSupported.indexUint = true;
     }
 
     // Free extensions pointers
@@ -2678,6 +2973,7 @@ void rlLoadExtensions(void *loader)
     else TRACELOG(RL_LOG_WARNING, "GL: VAO extension not found, VAO not supported");
     if (RLGL.ExtSupported.texNPOT) TRACELOG(RL_LOG_INFO, "GL: NPOT textures extension detected, full NPOT textures supported");
     else TRACELOG(RL_LOG_WARNING, "GL: NPOT textures extension not found, limited NPOT support (no-mipmaps, no-repeat)");
+    if (!RLGL.ExtSupported.indexUint) TRACELOG(RL_LOG_WARNING, "GL: 32-bit vertex indices extension not found, meshes with 32-bit indices not drawn");
     if (RLGL.ExtSupported.texCompDXT) TRACELOG(RL_LOG_INFO, "GL: DXT compressed textures supported");
     if (RLGL.ExtSupported.texCompETC1) TRACELOG(RL_LOG_INFO, "GL: ETC1 compressed textures supported");
     if (RLGL.ExtSupported.texCompETC2) TRACELOG(RL_LOG_INFO, "GL: ETC2/EAC compressed textures supported");
@@ -2797,10 +3093,53 @@ int *rlGetShaderLocsDefault(void)
 //------------------------------------------------------------------------------------------------
 // Load render batch
 rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
+{
+    return rlLoadRenderBatchEx(numBuffers, bufferElements, 0);
+}
+
+// Load render batch with flags
+// NOTE: RL_RENDER_BATCH_COMPACT stores vertex data interleaved (rlVertexCompact), 16 bytes per vertex,
+// it is intended for 2D drawing: depth and normals are not stored and texcoords are clamped to [0..1]
+rlRenderBatch rlLoadRenderBatchEx(int numBuffers, int bufferElements, int flags)
 {
     rlRenderBatch batch = { 0 };
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (flags & RL_RENDER_BATCH_RECORDING)
+    {
+        // Recording batches only keep vertex data in CPU memory (RAM), no GPU resources are required,
+        // so they can be loaded and recorded from any thread, vertex data always uses the default layout
+        batch.vertexBuffer = (rlVertexBuffer *)RL_CALLOC(1, sizeof(rlVertexBuffer));
+        batch.vertexBuffer[0].elementCount = bufferElements;
+        batch.vertexBuffer[0].vertices = (float *)RL_CALLOC(bufferElements*3*4, sizeof(float));
+        batch.vertexBuffer[0].texcoords = (float *)RL_CALLOC(bufferElements*2*4, sizeof(float));
+        batch.vertexBuffer[0].normals = (float *)RL_CALLOC(bufferElements*3*4, sizeof(float));
+        batch.vertexBuffer[0].colors = (unsigned char *)RL_CALLOC(bufferElements*4*4, sizeof(unsigned char));
+
+        batch.draws = (rlDrawCall *)RL_CALLOC(RL_DEFAULT_BATCH_DRAWCALLS, sizeof(rlDrawCall));
+        for (int i = 0; i < RL_DEFAULT_BATCH_DRAWCALLS; i++) batch.draws[i].mode = RL_QUADS;
+
+        batch.bufferCount = 1;
+        batch.drawCounter = 1;
+        batch.drawCapacity = RL_DEFAULT_BATCH_DRAWCALLS;
+        batch.currentDepth = -1.0f;
+        batch.flags = RL_RENDER_BATCH_RECORDING;
+
+        return batch;
+    }
+
+    bool compact = ((flags & RL_RENDER_BATCH_COMPACT) != 0);
+    bool persistent = false;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Streaming uses persistently mapped buffers when supported, buffer orphaning otherwise
+    // NOTE: Sorting reads vertex data back, not possible with write-only mapped buffers
+    persistent = ((flags & RL_RENDER_BATCH_STREAMING) != 0) && ((flags & RL_RENDER_BATCH_SORTED) == 0) && RLGL.ExtSupported.bufferStorage;
+
+    // A ring of buffers keeps CPU writes away from the buffers the GPU could be still reading
+    if (persistent && (numBuffers < RL_DEFAULT_BATCH_STREAM_BUFFERS)) numBuffers = RL_DEFAULT_BATCH_STREAM_BUFFERS;
+#endif
+
     // Initialize CPU (RAM) vertex buffers (position, texcoord, color data and indexes)
     //--------------------------------------------------------------------------------------------
     batch.vertexBuffer = (rlVertexBuffer *)RL_CALLOC(numBuffers, sizeof(rlVertexBuffer));
@@ -2809,10 +3148,22 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
     {
         batch.vertexBuffer[i].elementCount = bufferElements;
 
-        batch.vertexBuffer[i].vertices = (float *)RL_CALLOC(bufferElements*3*4, sizeof(float));     // 3 float by vertex, 4 vertex by quad
-        batch.vertexBuffer[i].texcoords = (float *)RL_CALLOC(bufferElements*2*4, sizeof(float));    // 2 float by texcoord, 4 texcoord by quad
-        batch.vertexBuffer[i].normals = (float *)RL_CALLOC(bufferElements*3*4, sizeof(float));      // 3 float by vertex, 4 vertex by quad
-        batch.vertexBuffer[i].colors = (unsigned char *)RL_CALLOC(bufferElements*4*4, sizeof(unsigned char));   // 4 float by color, 4 colors by quad
+        if (compact)
+        {
+            batch.vertexBuffer[i].compactVertices = (rlVertexCompact *)RL_CALLOC(bufferElements*4, sizeof(rlVertexCompact)); // 4 vertex by quad
+        }
+        else
+        {
+            batch.vertexBuffer[i].vertices = (float *)RL_CALLOC(bufferElements*3*4, sizeof(float));     // 3 float by vertex, 4 vertex by quad
+            batch.vertexBuffer[i].texcoords = (float *)RL_CALLOC(bufferElements*2*4, sizeof(float));    // 2 float by texcoord, 4 texcoord by quad
+            batch.vertexBuffer[i].normals = (float *)RL_CALLOC(bufferElements*3*4, sizeof(float));      // 3 float by vertex, 4 vertex by quad
+            batch.vertexBuffer[i].colors = (unsigned char *)RL_CALLOC(bufferElements*4*4, sizeof(unsigned char));   // 4 float by color, 4 colors by quad
+
+            for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].vertices[j] = 0.0f;
+            for (int j = 0; j < (2*4*bufferElements); j++) batch.vertexBuffer[i].texcoords[j] = 0.0f;
+            for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].normals[j] = 0.0f;
+            for (int j = 0; j < (4*4*bufferElements); j++) batch.vertexBuffer[i].colors[j] = 0;
+        }
 #if defined(GRAPHICS_API_OPENGL_33)
         batch.vertexBuffer[i].indices = (unsigned int *)RL_CALLOC(bufferElements*6, sizeof(unsigned int));      // 6 int by quad (indices)
 #endif
@@ -2820,11 +3171,6 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
         batch.vertexBuffer[i].indices = (unsigned short *)RL_CALLOC(bufferElements*6, sizeof(unsigned short));  // 6 int by quad (indices)
 #endif
 
-        for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].vertices[j] = 0.0f;
-        for (int j = 0; j < (2*4*bufferElements); j++) batch.vertexBuffer[i].texcoords[j] = 0.0f;
-        for (int j = 0; j < (3*4*bufferElements); j++) batch.vertexBuffer[i].normals[j] = 0.0f;
-        for (int j = 0; j < (4*4*bufferElements); j++) batch.vertexBuffer[i].colors[j] = 0;
-
         int k = 0;
 
         // Indices can be initialized right now
@@ -2857,34 +3203,58 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
             glBindVertexArray(batch.vertexBuffer[i].vaoId);
         }
 
-        // Quads - Vertex buffers binding and attributes enable
-        // Vertex position buffer (shader-location = 0)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-
-        // Vertex texcoord buffer (shader-location = 1)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-
-        // Vertex normal buffer (shader-location = 2)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].normals, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL], 3, GL_FLOAT, 0, 0, 0);
-
-        // Vertex color buffer (shader-location = 3)
-        glGenBuffers(1, &batch.vertexBuffer[i].vboId[3]);
-        glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[3]);
-        glBufferData(GL_ARRAY_BUFFER, bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
-        glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+        if (compact)
+        {
+            // Quads - Single interleaved vertex buffer, normals are not provided
+            // Vertex position, texcoord and color (shader-location = 0, 1, 3)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
+            rlLoadRenderBatchBufferData(bufferElements*4*sizeof(rlVertexCompact), batch.vertexBuffer[i].compactVertices, persistent);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 2, GL_FLOAT, 0, sizeof(rlVertexCompact), 0);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(rlVertexCompact), (void *)(2*sizeof(float)));
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(rlVertexCompact), (void *)(2*sizeof(float) + 2*sizeof(unsigned short)));
+        }
+        else
+        {
+            // Quads - Vertex buffers binding and attributes enable
+            // Vertex position buffer (shader-location = 0)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[0]);
+            rlLoadRenderBatchBufferData(bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].vertices, persistent);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+
+            // Vertex texcoord buffer (shader-location = 1)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[1]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[1]);
+            rlLoadRenderBatchBufferData(bufferElements*2*4*sizeof(float), batch.vertexBuffer[i].texcoords, persistent);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+
+            // Vertex normal buffer (shader-location = 2)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[2]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[2]);
+            rlLoadRenderBatchBufferData(bufferElements*3*4*sizeof(float), batch.vertexBuffer[i].normals, persistent);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL], 3, GL_FLOAT, 0, 0, 0);
+
+            // Vertex color buffer (shader-location = 3)
+            glGenBuffers(1, &batch.vertexBuffer[i].vboId[3]);
+            glBindBuffer(GL_ARRAY_BUFFER, batch.vertexBuffer[i].vboId[3]);
+            rlLoadRenderBatchBufferData(bufferElements*4*4*sizeof(unsigned char), batch.vertexBuffer[i].colors, persistent);
+            glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+            glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+        }
+
+        batch.vertexBuffer[i].immutable = persistent;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+        // Vertex data is written straight into GPU memory from now on
+        if (persistent) rlMapRenderBatchBuffer(&batch.vertexBuffer[i], compact);
+#endif
 
         // Fill index buffer
         glGenBuffers(1, &batch.vertexBuffer[i].vboId[4]);
@@ -2897,7 +3267,8 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 #endif
     }
 
-    TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
+    if (persistent) TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU), persistently mapped");
+    else TRACELOG(RL_LOG_INFO, "RLGL: Render batch vertex buffers loaded successfully in VRAM (GPU)");
 
     // Unbind the current VAO
     if (RLGL.ExtSupported.vao) glBindVertexArray(0);
@@ -2907,6 +3278,9 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
     //--------------------------------------------------------------------------------------------
     batch.draws = (rlDrawCall *)RL_CALLOC(RL_DEFAULT_BATCH_DRAWCALLS, sizeof(rlDrawCall));
 
+    // Scratch buffer to reorder vertex data, one stream at a time
+    if (flags & RL_RENDER_BATCH_SORTED) batch.sortBuffer = RL_MALLOC(bufferElements*4*(compact? sizeof(rlVertexCompact) : 3*sizeof(float)));
+
     for (int i = 0; i < RL_DEFAULT_BATCH_DRAWCALLS; i++)
     {
         batch.draws[i].mode = RL_QUADS;
@@ -2921,7 +3295,9 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 
     batch.bufferCount = numBuffers;    // Record buffer count
     batch.drawCounter = 1;             // Reset draws counter
+    batch.drawCapacity = RL_DEFAULT_BATCH_DRAWCALLS; // Record draws array size
     batch.currentDepth = -1.0f;         // Reset depth value
+    batch.flags = flags;                // Record batch flags
     //--------------------------------------------------------------------------------------------
 #endif
 
@@ -2932,45 +3308,69 @@ rlRenderBatch rlLoadRenderBatch(int numBuffers, int bufferElements)
 void rlUnloadRenderBatch(rlRenderBatch batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // NOTE: Recording batches have no GPU resources, they can be unloaded from any thread
+    bool recording = ((batch.flags & RL_RENDER_BATCH_RECORDING) != 0);
+
     // Unbind everything
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    if (!recording)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
 
     // Unload all vertex buffers data
     for (int i = 0; i < batch.bufferCount; i++)
     {
-        // Unbind VAO attribs data
-        if (RLGL.ExtSupported.vao)
+        if (!recording)
         {
-            glBindVertexArray(batch.vertexBuffer[i].vaoId);
-            glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
-            glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
-            glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL);
-            glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
-            glBindVertexArray(0);
-        }
+            // Unbind VAO attribs data
+            if (RLGL.ExtSupported.vao)
+            {
+                glBindVertexArray(batch.vertexBuffer[i].vaoId);
+                glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+                glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+                glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL);
+                glDisableVertexAttribArray(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+                glBindVertexArray(0);
+            }
+
+            // Delete VBOs from GPU (VRAM)
+            glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[0]);
+            glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[1]);
+            glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[2]);
+            glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[3]);
+            glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[4]);
 
-        // Delete VBOs from GPU (VRAM)
-        glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[0]);
-        glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[1]);
-        glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[2]);
-        glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[3]);
-        glDeleteBuffers(1, &batch.vertexBuffer[i].vboId[4]);
+            // Delete VAOs from GPU (VRAM)
+            if (RLGL.ExtSupported.vao) glDeleteVertexArrays(1, &batch.vertexBuffer[i].vaoId);
 
-        // Delete VAOs from GPU (VRAM)
-        if (RLGL.ExtSupported.vao) glDeleteVertexArrays(1, &batch.vertexBuffer[i].vaoId);
+#if defined(GRAPHICS_API_OPENGL_33)
+            // Delete sync object, mapped storage is released with the buffers
+            if (batch.vertexBuffer[i].fence != NULL) glDeleteSync((GLsync)batch.vertexBuffer[i].fence);
+#endif
+            if (batch.vertexBuffer[i].mapped)
+            {
+                batch.vertexBuffer[i].vertices = NULL;
+                batch.vertexBuffer[i].texcoords = NULL;
+                batch.vertexBuffer[i].normals = NULL;
+                batch.vertexBuffer[i].colors = NULL;
+                batch.vertexBuffer[i].compactVertices = NULL;
+            }
+        }
 
         // Free vertex arrays memory from CPU (RAM)
         RL_FREE(batch.vertexBuffer[i].vertices);
         RL_FREE(batch.vertexBuffer[i].texcoords);
         RL_FREE(batch.vertexBuffer[i].normals);
         RL_FREE(batch.vertexBuffer[i].colors);
+        RL_FREE(batch.vertexBuffer[i].compactVertices);
         RL_FREE(batch.vertexBuffer[i].indices);
     }
 
     // Unload arrays
     RL_FREE(batch.vertexBuffer);
     RL_FREE(batch.draws);
+    RL_FREE(batch.sortBuffer);
 #endif
 }
 
@@ -2979,34 +3379,67 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
 void rlDrawRenderBatch(rlRenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    // Recording batches are not drawn when full, they grow to keep all vertex data until submitted
+    if (batch->flags & RL_RENDER_BATCH_RECORDING)
+    {
+        rlGrowRenderBatch(batch, 4 + 1);
+        return;
+    }
+
     // Update batch vertex buffers
     //------------------------------------------------------------------------------------------------------------
     // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
     // TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (use a change detector flag?)
     if (RLGL.State.vertexCounter > 0)
     {
+        // Merge draw calls before upload, screen bounds are not valid for stereo rendering
+        if ((batch->flags & RL_RENDER_BATCH_SORTED) && (batch->drawCounter > 1) && !RLGL.State.stereoRender) rlSortRenderBatch(batch);
+
         // Activate elements VAO
         if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
 
-        // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
-
-        // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
+        // Streaming buffers are orphaned before upload, avoiding a stall if the GPU is still reading them
+        // NOTE: Immutable storage (buffer storage) can not be orphaned, mapped buffers need no upload
+        bool orphan = ((batch->flags & RL_RENDER_BATCH_STREAMING) != 0) && !batch->vertexBuffer[batch->currentBuffer].immutable;
+        int vertexCapacity = batch->vertexBuffer[batch->currentBuffer].elementCount*4;
 
-        // Normals buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].normals);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].normals, GL_DYNAMIC_DRAW); // Update all buffer
-
-        // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
+        if (batch->vertexBuffer[batch->currentBuffer].mapped)
+        {
+            // Vertex data already written into GPU memory (coherent mapping), nothing to upload
+        }
+        else if (batch->flags & RL_RENDER_BATCH_COMPACT)
+        {
+            // Interleaved vertex buffer, a single upload
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+            if (orphan) glBufferData(GL_ARRAY_BUFFER, vertexCapacity*sizeof(rlVertexCompact), NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*sizeof(rlVertexCompact), batch->vertexBuffer[batch->currentBuffer].compactVertices);
+        }
+        else
+        {
+            // Vertex positions buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+            if (orphan) glBufferData(GL_ARRAY_BUFFER, vertexCapacity*3*sizeof(float), NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].vertices);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
+
+            // Texture coordinates buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+            if (orphan) glBufferData(GL_ARRAY_BUFFER, vertexCapacity*2*sizeof(float), NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*2*sizeof(float), batch->vertexBuffer[batch->currentBuffer].texcoords);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
+
+            // Normals buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+            if (orphan) glBufferData(GL_ARRAY_BUFFER, vertexCapacity*3*sizeof(float), NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*3*sizeof(float), batch->vertexBuffer[batch->currentBuffer].normals);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].normals, GL_DYNAMIC_DRAW); // Update all buffer
+
+            // Colors buffer
+            glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
+            if (orphan) glBufferData(GL_ARRAY_BUFFER, vertexCapacity*4*sizeof(unsigned char), NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, RLGL.State.vertexCounter*4*sizeof(unsigned char), batch->vertexBuffer[batch->currentBuffer].colors);
+            //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*batch->vertexBuffer[batch->currentBuffer].elementCount, batch->vertexBuffer[batch->currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
+        }
 
         // NOTE: glMapBuffer() causes sync issue
         // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job
@@ -3085,29 +3518,50 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
             if (RLGL.ExtSupported.vao) glBindVertexArray(batch->vertexBuffer[batch->currentBuffer].vaoId);
             else
             {
-                // Bind vertex attrib: position (shader-location = 0)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
-
-                // Bind vertex attrib: texcoord (shader-location = 1)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
-
-                // Bind vertex attrib: normal (shader-location = 2)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL], 3, GL_FLOAT, 0, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL]);
-
-                // Bind vertex attrib: color (shader-location = 3)
-                glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
-                glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
-                glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+                if (batch->flags & RL_RENDER_BATCH_COMPACT)
+                {
+                    // Bind vertex attribs: position, texcoord and color (shader-location = 0, 1, 3), interleaved
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 2, GL_FLOAT, 0, sizeof(rlVertexCompact), 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(rlVertexCompact), (void *)(2*sizeof(float)));
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(rlVertexCompact), (void *)(2*sizeof(float) + 2*sizeof(unsigned short)));
+                    glDisableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL]);
+                }
+                else
+                {
+                    // Bind vertex attrib: position (shader-location = 0)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[0]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+                    // Bind vertex attrib: texcoord (shader-location = 1)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[1]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+
+                    // Bind vertex attrib: normal (shader-location = 2)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[2]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL], 3, GL_FLOAT, 0, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL]);
+
+                    // Bind vertex attrib: color (shader-location = 3)
+                    glBindBuffer(GL_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[3]);
+                    glVertexAttribPointer(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+                    glEnableVertexAttribArray(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+                }
 
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->vertexBuffer[batch->currentBuffer].vboId[4]);
             }
 
+            // Compact vertex data has no normals, a constant one pointing towards viewer is used
+            if ((batch->flags & RL_RENDER_BATCH_COMPACT) && (RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL] != -1))
+            {
+                glVertexAttrib3f(RLGL.State.currentShaderLocs[RL_SHADER_LOC_VERTEX_NORMAL], 0.0f, 0.0f, 1.0f);
+            }
+
             // Setup some default shader values
             glUniform4f(RLGL.State.currentShaderLocs[RL_SHADER_LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
             glUniform1i(RLGL.State.currentShaderLocs[RL_SHADER_LOC_MAP_DIFFUSE], 0);  // Active default sampler2D: texture0
@@ -3161,6 +3615,15 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
         if (RLGL.ExtSupported.vao) glBindVertexArray(0); // Unbind VAO
 
         glUseProgram(0);    // Unbind shader program
+
+#if defined(GRAPHICS_API_OPENGL_33)
+        // Fence mapped buffer, it can not be written again until the GPU is done reading it
+        if (batch->vertexBuffer[batch->currentBuffer].mapped)
+        {
+            if (batch->vertexBuffer[batch->currentBuffer].fence != NULL) glDeleteSync((GLsync)batch->vertexBuffer[batch->currentBuffer].fence);
+            batch->vertexBuffer[batch->currentBuffer].fence = (void *)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+#endif
     }
 
     // Restore viewport to default measures
@@ -3197,6 +3660,21 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
     // Change to next buffer in the list (in case of multi-buffering)
     batch->currentBuffer++;
     if (batch->currentBuffer >= batch->bufferCount) batch->currentBuffer = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Wait for the GPU to release next mapped buffer before writing into it
+    // NOTE: With enough buffers in the ring this fence is usually already signaled
+    if (batch->vertexBuffer[batch->currentBuffer].fence != NULL)
+    {
+        GLsync fence = (GLsync)batch->vertexBuffer[batch->currentBuffer].fence;
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);   // Timeout: 1 ms
+
+        while (result == GL_TIMEOUT_EXPIRED) result = glClientWaitSync(fence, 0, 1000000);
+
+        glDeleteSync(fence);
+        batch->vertexBuffer[batch->currentBuffer].fence = NULL;
+    }
+#endif
 #endif
 }
 
@@ -3226,7 +3704,10 @@ bool rlCheckRenderBatchLimit(int vCount)
     bool overflow = false;
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    if ((RLGL.State.vertexCounter + vCount) >=
+    // Recording batches never overflow, primitives are kept in the same draw call
+    // NOTE: If batch can not grow, recorded data is dropped and reported as an overflow
+    if (RLGL.currentBatch->flags & RL_RENDER_BATCH_RECORDING) overflow = !rlGrowRenderBatch(RLGL.currentBatch, vCount);
+    else if ((RLGL.State.vertexCounter + vCount) >=
         (RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4))
     {
         overflow = true;
@@ -3246,6 +3727,180 @@ bool rlCheckRenderBatchLimit(int vCount)
     return overflow;
 }
 
+// Begin recording draw calls into a render batch on the calling thread
+// NOTE: Only vertex data functions are recorded (rlBegin(), rlVertex3f(), rlSetTexture(), matrix stack...),
+// state changes flushing the batch (shader, blending, scissor...) must be done on render thread;
+// recording restarts the batch with identity transform and default texture, calling thread state is
+// restored by rlEndRecording(), other threads can record concurrently with RLGL_ENABLE_THREADED_RECORDING
+void rlBeginRecording(rlRenderBatch *batch)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((batch == NULL) || ((batch->flags & RL_RENDER_BATCH_RECORDING) == 0))
+    {
+        TRACELOG(RL_LOG_WARNING, "RLGL: Render batch can not be recorded, requires RL_RENDER_BATCH_RECORDING flag");
+        return;
+    }
+
+    if (rlRecording) rlEndRecording();
+
+    unsigned int defaultTextureId = (RLGLRender != NULL)? RLGLRender->State.defaultTextureId : RLGL.State.defaultTextureId;
+
+    RLGLRecording = RLGL;
+    rlRecording = true;
+
+    // Reset calling thread vertex state
+    memset(&RLGL.State, 0, sizeof(RLGL.State));
+    RLGL.State.defaultTextureId = defaultTextureId;
+    RLGL.State.currentTextureId = defaultTextureId;
+    RLGL.State.currentMatrixMode = RL_MODELVIEW;
+    RLGL.State.modelview = rlMatrixIdentity();
+    RLGL.State.projection = rlMatrixIdentity();
+    RLGL.State.transform = rlMatrixIdentity();
+    RLGL.State.currentMatrix = &RLGL.State.modelview;
+    RLGL.currentBatch = batch;
+
+    // Reset batch recorded draw calls
+    for (int i = 0; i < batch->drawCapacity; i++)
+    {
+        batch->draws[i].mode = RL_QUADS;
+        batch->draws[i].vertexCount = 0;
+        batch->draws[i].vertexAlignment = 0;
+        batch->draws[i].textureId = defaultTextureId;
+    }
+
+    batch->drawCounter = 1;
+    batch->currentDepth = -1.0f;
+#endif
+}
+
+// End recording draw calls, calling thread rlgl state is restored
+// NOTE: Recorded vertex count is kept by the draw calls (vertexCount + vertexAlignment)
+void rlEndRecording(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!rlRecording) return;
+
+    RLGL = RLGLRecording;
+    rlRecording = false;
+#endif
+}
+
+// Submit a recorded render batch into the active render batch
+// NOTE: Recorded draw calls are appended in order, after any previous vertex data, using the current
+// transform matrix, so submitting several recordings in a fixed order gives the same result every frame;
+// the recording is not modified, it can be submitted again until next rlBeginRecording()
+void rlSubmitRenderBatch(const rlRenderBatch *batch)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((batch == NULL) || ((batch->flags & RL_RENDER_BATCH_RECORDING) == 0) || (batch == RLGL.currentBatch)) return;
+
+    const rlVertexBuffer *source = &batch->vertexBuffer[0];
+    const Matrix *mat = &RLGL.State.transform;
+    int first = 0;
+
+    for (int i = 0; i < batch->drawCounter; i++)
+    {
+        const rlDrawCall *draw = &batch->draws[i];
+        int primitive = (draw->mode == RL_LINES)? 2 : ((draw->mode == RL_TRIANGLES)? 3 : 4);
+        int offset = first;
+        int remaining = draw->vertexCount - draw->vertexCount%primitive;   // Incomplete primitives are dropped
+
+        first += (draw->vertexCount + draw->vertexAlignment);
+        if (remaining == 0) continue;
+
+        rlSetTexture(draw->textureId);
+        rlBegin(draw->mode);
+
+        while (remaining > 0)
+        {
+            rlVertexBuffer *buffer = &RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer];
+            int available = buffer->elementCount*4 - RLGL.State.vertexCounter;
+            int count = (remaining < available)? remaining : (available - available%primitive);
+
+            // Primitives are never split between batches
+            if (count <= 0)
+            {
+                rlCheckRenderBatchLimit(primitive);
+                continue;
+            }
+
+            int start = RLGL.State.vertexCounter;
+
+            if (RLGL.currentBatch->flags & RL_RENDER_BATCH_COMPACT)
+            {
+                for (int v = 0; v < count; v++)
+                {
+                    const float *position = &source->vertices[3*(offset + v)];
+                    rlVertexCompact *vertex = &buffer->compactVertices[start + v];
+
+                    if (RLGL.State.transformRequired)
+                    {
+                        vertex->position[0] = mat->m0*position[0] + mat->m4*position[1] + mat->m8*position[2] + mat->m12;
+                        vertex->position[1] = mat->m1*position[0] + mat->m5*position[1] + mat->m9*position[2] + mat->m13;
+                    }
+                    else
+                    {
+                        vertex->position[0] = position[0];
+                        vertex->position[1] = position[1];
+                    }
+
+                    vertex->texcoord[0] = rlFloatToUnorm16(source->texcoords[2*(offset + v)]);
+                    vertex->texcoord[1] = rlFloatToUnorm16(source->texcoords[2*(offset + v) + 1]);
+                    memcpy(vertex->color, &source->colors[4*(offset + v)], 4);
+                }
+            }
+            else
+            {
+                if (RLGL.State.transformRequired)
+                {
+                    for (int v = 0; v < count; v++)
+                    {
+                        const float *position = &source->vertices[3*(offset + v)];
+                        const float *normal = &source->normals[3*(offset + v)];
+                        float *tposition = &buffer->vertices[3*(start + v)];
+                        float *tnormal = &buffer->normals[3*(start + v)];
+
+                        tposition[0] = mat->m0*position[0] + mat->m4*position[1] + mat->m8*position[2] + mat->m12;
+                        tposition[1] = mat->m1*position[0] + mat->m5*position[1] + mat->m9*position[2] + mat->m13;
+                        tposition[2] = mat->m2*position[0] + mat->m6*position[1] + mat->m10*position[2] + mat->m14;
+
+                        // Normals rotated and normalized as rlNormal3f() does
+                        float nx = mat->m0*normal[0] + mat->m4*normal[1] + mat->m8*normal[2];
+                        float ny = mat->m1*normal[0] + mat->m5*normal[1] + mat->m9*normal[2];
+                        float nz = mat->m2*normal[0] + mat->m6*normal[1] + mat->m10*normal[2];
+                        float length = sqrtf(nx*nx + ny*ny + nz*nz);
+                        if (length != 0.0f) length = 1.0f/length;
+
+                        tnormal[0] = nx*length;
+                        tnormal[1] = ny*length;
+                        tnormal[2] = nz*length;
+                    }
+                }
+                else
+                {
+                    memcpy(&buffer->vertices[3*start], &source->vertices[3*offset], count*3*sizeof(float));
+                    memcpy(&buffer->normals[3*start], &source->normals[3*offset], count*3*sizeof(float));
+                }
+
+                memcpy(&buffer->texcoords[2*start], &source->texcoords[2*offset], count*2*sizeof(float));
+                memcpy(&buffer->colors[4*start], &source->colors[4*offset], count*4*sizeof(unsigned char));
+            }
+
+            RLGL.State.vertexCounter += count;
+            RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount += count;
+            offset += count;
+            remaining -= count;
+        }
+    }
+
+    // Advance depth by the recorded rlEnd() increments, following draws keep in front of submitted ones
+    // NOTE: Recording always starts at depth -1.0f and never draws, so the recorded increment is kept entirely
+    RLGL.currentBatch->currentDepth += (batch->currentDepth + 1.0f);
+
+    rlSetTexture(0);
+#endif
+}
+
 // Textures data management
 //-----------------------------------------------------------------------------------------
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
@@ -3388,6 +4043,13 @@ unsigned int rlLoadTexture(const void *data, int width, int height, int format,
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipmapCount); // Required for user-defined mip count
     }
+#elif defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    if (mipmapCount > 1)
+    {
+        // Activate Trilinear filtering if mipmaps are available
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
 #endif
 
     // At this point we have the texture loaded in GPU and texture parameters configured
@@ -3653,7 +4315,7 @@ void rlUnloadTexture(unsigned int id)
 }
 
 // Generate mipmap data for selected texture
-// NOTE: Only supports GPU mipmap generation
+// NOTE: Only supports GPU mipmap generation, or CPU generation on software renderer
 void rlGenTextureMipmaps(unsigned int id, int width, int height, int format, int *mipmaps)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
@@ -3678,6 +4340,15 @@ void rlGenTextureMipmaps(unsigned int id, int width, int height, int format, int
     }
     else TRACELOG(RL_LOG_WARNING, "TEXTURE: [ID %i] Failed to generate mipmaps", id);
 
+    glBindTexture(GL_TEXTURE_2D, 0);
+#elif defined(GRAPHICS_API_OPENGL_11_SOFTWARE)
+    glBindTexture(GL_TEXTURE_2D, id);
+
+    glGenerateMipmap(GL_TEXTURE_2D);    // Generate mipmaps on CPU, any texture size supported
+
+    *mipmaps = 1 + (int)floor(log((width > height)? width : height)/log(2));
+    TRACELOG(RL_LOG_INFO, "TEXTURE: [ID %i] Mipmaps generated automatically, total: %i", id, *mipmaps);
+
     glBindTexture(GL_TEXTURE_2D, 0);
 #else
     TRACELOG(RL_LOG_WARNING, "TEXTURE: [ID %i] GPU mipmap generation not supported", id);
@@ -3762,6 +4433,16 @@ void rlResizeFramebuffer(int width, int height)
 {
     swResizeFramebuffer(width, height);
 }
+
+// Render into external color memory (zero-copy)
+// NOTE: Memory layout must be the one rlCopyFramebuffer() produces for the full framebuffer,
+// on success current content is moved to it and copying the framebuffer to it becomes a no-op
+bool rlBindFramebufferColor(int width, int height, int format, void *pixels)
+{
+    unsigned int glInternalFormat, glFormat, glType;
+    rlGetGlTextureFormats(format, &glInternalFormat, &glFormat, &glType); // Get OpenGL texture format
+    return swBindColorBuffer(width, height, glFormat, glType, pixels);
+}
 #endif
 
 // Read screen pixel data (color buffer)
@@ -4045,12 +4726,23 @@ void rlDrawVertexArray(int offset, int count)
 
 // Draw vertex array elements
 void rlDrawVertexArrayElements(int offset, int count, const void *buffer)
+{
+    rlDrawVertexArrayElementsEx(offset, count, buffer, RL_UNSIGNED_SHORT);
+}
+
+// Draw vertex array elements, indices type: RL_UNSIGNED_SHORT or RL_UNSIGNED_INT
+// NOTE: 32-bit indices require GL_OES_element_index_uint on OpenGL ES 2.0, elements are not drawn if not supported
+void rlDrawVertexArrayElementsEx(int offset, int count, const void *buffer, int type)
 {
     // NOTE: Added pointer math separately from function to avoid UBSAN complaining
-    unsigned short *bufferPtr = (unsigned short *)buffer;
-    if (offset > 0) bufferPtr += offset;
+    unsigned char *bufferPtr = (unsigned char *)buffer;
+    if (offset > 0) bufferPtr += offset*((type == RL_UNSIGNED_INT)? sizeof(unsigned int) : sizeof(unsigned short));
+
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    if ((type == RL_UNSIGNED_INT) && !RLGL.ExtSupported.indexUint) return;
+#endif
 
-    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (const unsigned short *)bufferPtr);
+    glDrawElements(GL_TRIANGLES, count, (type == RL_UNSIGNED_INT)? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, (const void *)bufferPtr);
 }
 
 // Draw vertex array instanced
@@ -4063,13 +4755,23 @@ void rlDrawVertexArrayInstanced(int offset, int count, int instances)
 
 // Draw vertex array elements instanced
 void rlDrawVertexArrayElementsInstanced(int offset, int count, const void *buffer, int instances)
+{
+    rlDrawVertexArrayElementsInstancedEx(offset, count, buffer, instances, RL_UNSIGNED_SHORT);
+}
+
+// Draw vertex array elements instanced, indices type: RL_UNSIGNED_SHORT or RL_UNSIGNED_INT
+void rlDrawVertexArrayElementsInstancedEx(int offset, int count, const void *buffer, int instances, int type)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     // NOTE: Added pointer math separately from function to avoid UBSAN complaining
-    unsigned short *bufferPtr = (unsigned short *)buffer;
-    if (offset > 0) bufferPtr += offset;
+    unsigned char *bufferPtr = (unsigned char *)buffer;
+    if (offset > 0) bufferPtr += offset*((type == RL_UNSIGNED_INT)? sizeof(unsigned int) : sizeof(unsigned short));
+
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    if ((type == RL_UNSIGNED_INT) && !RLGL.ExtSupported.indexUint) return;
+#endif
 
-    glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_SHORT, (const unsigned short *)bufferPtr, instances);
+    glDrawElementsInstanced(GL_TRIANGLES, count, (type == RL_UNSIGNED_INT)? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, (const void *)bufferPtr, instances);
 #endif
 }
 
@@ -5099,6 +5801,395 @@ static void rlUnloadShaderDefault(void)
     TRACELOG(RL_LOG_INFO, "SHADER: [ID %i] Default shader unloaded successfully", RLGL.State.defaultShaderId);
 }
 
+// Convert normalized float to unorm16, clamped to [0..1]
+// NOTE: Used for texcoords on RL_RENDER_BATCH_COMPACT render batches
+static unsigned short rlFloatToUnorm16(float value)
+{
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 65535;
+
+    return (unsigned short)(value*65535.0f + 0.5f);
+}
+
+// Load render batch vertex buffer data into currently bound GL_ARRAY_BUFFER
+// NOTE: Persistent buffers require immutable storage, dynamic storage is kept
+// so data can still be uploaded with glBufferSubData() if mapping fails
+static void rlLoadRenderBatchBufferData(int size, const void *data, bool persistent)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (persistent)
+    {
+        glBufferStorage(GL_ARRAY_BUFFER, size, data, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT | GL_DYNAMIC_STORAGE_BIT);
+        return;
+    }
+#endif
+    glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+}
+
+#if defined(GRAPHICS_API_OPENGL_33)
+// Map render batch vertex buffer persistently, vertex arrays point to GPU memory afterwards
+// NOTE: If any buffer fails to map, CPU arrays are kept and uploaded on draw
+static void rlMapRenderBatchBuffer(rlVertexBuffer *buffer, bool compact)
+{
+    int vertexCount = buffer->elementCount*4;
+    int bufferCount = compact? 1 : 4;
+    int sizes[4] = {
+        compact? vertexCount*(int)sizeof(rlVertexCompact) : vertexCount*3*(int)sizeof(float),
+        vertexCount*2*(int)sizeof(float),
+        vertexCount*3*(int)sizeof(float),
+        vertexCount*4*(int)sizeof(unsigned char)
+    };
+    void *data[4] = { 0 };
+    bool success = true;
+
+    for (int i = 0; i < bufferCount; i++)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer->vboId[i]);
+        data[i] = glMapBufferRange(GL_ARRAY_BUFFER, 0, sizes[i], GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        if (data[i] == NULL) success = false;
+    }
+
+    if (success)
+    {
+        RL_FREE(buffer->vertices);
+        RL_FREE(buffer->texcoords);
+        RL_FREE(buffer->normals);
+        RL_FREE(buffer->colors);
+        RL_FREE(buffer->compactVertices);
+        buffer->vertices = NULL;
+        buffer->texcoords = NULL;
+        buffer->normals = NULL;
+        buffer->colors = NULL;
+        buffer->compactVertices = NULL;
+
+        if (compact) buffer->compactVertices = (rlVertexCompact *)data[0];
+        else
+        {
+            buffer->vertices = (float *)data[0];
+            buffer->texcoords = (float *)data[1];
+            buffer->normals = (float *)data[2];
+            buffer->colors = (unsigned char *)data[3];
+        }
+
+        buffer->mapped = true;
+    }
+    else
+    {
+        for (int i = 0; i < bufferCount; i++)
+        {
+            if (data[i] == NULL) continue;
+            glBindBuffer(GL_ARRAY_BUFFER, buffer->vboId[i]);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+
+        TRACELOG(RL_LOG_WARNING, "RLGL: Failed to map render batch vertex buffers, using buffer uploads");
+    }
+}
+#endif
+
+// Merge render batch draw calls sharing mode and texture, vertex data is reordered
+// NOTE: A draw call is only moved back over draw calls it does not overlap on screen,
+// so blending and painter's order results are kept; lines are never moved (width not known)
+// WARNING: Screen bounds expect the shader to transform vertex positions by mvp
+static void rlSortRenderBatch(rlRenderBatch *batch)
+{
+    rlVertexBuffer *buffer = &batch->vertexBuffer[batch->currentBuffer];
+    bool compact = ((batch->flags & RL_RENDER_BATCH_COMPACT) != 0);
+    Matrix mvp = rlMatrixMultiply(RLGL.State.modelview, RLGL.State.projection);
+
+    float drawBounds[RL_DEFAULT_BATCH_DRAWCALLS][4] = { 0 };  // Draw screen bounds: min x, min y, max x, max y (NDC)
+    float groupBounds[RL_DEFAULT_BATCH_DRAWCALLS][4] = { 0 }; // Group screen bounds, all draws in the group
+    int drawOffsets[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };      // Draw first vertex
+    int drawNext[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };         // Next draw in the same group, -1 for last one
+    int groupFirst[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };       // First draw of the group
+    int groupLast[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };        // Last draw of the group
+    int groupCount = 0;
+    int drawCount = 0;
+    int offset = 0;
+
+    for (int i = 0; i < batch->drawCounter; i++)
+    {
+        rlDrawCall *draw = &batch->draws[i];
+
+        drawOffsets[i] = offset;
+        drawNext[i] = -1;
+        offset += (draw->vertexCount + draw->vertexAlignment);
+
+        if (draw->vertexCount == 0) continue;   // Empty draw calls are dropped
+        drawCount++;
+
+        // Get draw screen bounds, unbounded if any vertex is behind the camera
+        float *bounds = drawBounds[i];
+        bounds[0] = 1e30f; bounds[1] = 1e30f; bounds[2] = -1e30f; bounds[3] = -1e30f;
+
+        for (int v = drawOffsets[i]; (v < (drawOffsets[i] + draw->vertexCount)) && (draw->mode != RL_LINES); v++)
+        {
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+
+            if (compact) { x = buffer->compactVertices[v].position[0]; y = buffer->compactVertices[v].position[1]; }
+            else { x = buffer->vertices[3*v]; y = buffer->vertices[3*v + 1]; z = buffer->vertices[3*v + 2]; }
+
+            float w = mvp.m3*x + mvp.m7*y + mvp.m11*z + mvp.m15;
+            if (w <= 0.000001f) { bounds[0] = -1e30f; bounds[2] = 1e30f; break; }
+
+            float ndcX = (mvp.m0*x + mvp.m4*y + mvp.m8*z + mvp.m12)/w;
+            float ndcY = (mvp.m1*x + mvp.m5*y + mvp.m9*z + mvp.m13)/w;
+
+            if (ndcX < bounds[0]) bounds[0] = ndcX;
+            if (ndcY < bounds[1]) bounds[1] = ndcY;
+            if (ndcX > bounds[2]) bounds[2] = ndcX;
+            if (ndcY > bounds[3]) bounds[3] = ndcY;
+        }
+
+        if ((draw->mode == RL_LINES) || (bounds[0] > bounds[2]))
+        {
+            bounds[0] = -1e30f; bounds[1] = -1e30f; bounds[2] = 1e30f; bounds[3] = 1e30f;
+        }
+
+        // Look back for a group with same mode and texture, stop on first overlapping group
+        // NOTE: Bounds only touching do not overlap, rasterization rules do not draw shared edges twice
+        int target = -1;
+
+        for (int g = groupCount - 1; (g >= 0) && (g >= (groupCount - RL_DEFAULT_BATCH_SORT_WINDOW)); g--)
+        {
+            rlDrawCall *first = &batch->draws[groupFirst[g]];
+
+            if ((first->mode == draw->mode) && (first->textureId == draw->textureId) && (draw->mode != RL_LINES)) { target = g; break; }
+
+            // Group bounds discard most groups, then every draw of the group is checked
+            bool overlap = false;
+
+            if ((bounds[0] < groupBounds[g][2]) && (groupBounds[g][0] < bounds[2]) &&
+                (bounds[1] < groupBounds[g][3]) && (groupBounds[g][1] < bounds[3]))
+            {
+                for (int d = groupFirst[g]; (d != -1) && !overlap; d = drawNext[d])
+                {
+                    overlap = ((bounds[0] < drawBounds[d][2]) && (drawBounds[d][0] < bounds[2]) &&
+                        (bounds[1] < drawBounds[d][3]) && (drawBounds[d][1] < bounds[3]));
+                }
+            }
+
+            if (overlap) break;
+        }
+
+        if (target == -1)
+        {
+            target = groupCount;
+            groupFirst[target] = i;
+            groupBounds[target][0] = bounds[0];
+            groupBounds[target][1] = bounds[1];
+            groupBounds[target][2] = bounds[2];
+            groupBounds[target][3] = bounds[3];
+            groupCount++;
+        }
+        else
+        {
+            drawNext[groupLast[target]] = i;
+            if (bounds[0] < groupBounds[target][0]) groupBounds[target][0] = bounds[0];
+            if (bounds[1] < groupBounds[target][1]) groupBounds[target][1] = bounds[1];
+            if (bounds[2] > groupBounds[target][2]) groupBounds[target][2] = bounds[2];
+            if (bounds[3] > groupBounds[target][3]) groupBounds[target][3] = bounds[3];
+        }
+
+        groupLast[target] = i;
+    }
+
+    if ((groupCount == 0) || (groupCount == drawCount)) return;     // Nothing to merge
+
+    // Get merged draw calls, keeping vertex alignment for following quads
+    rlDrawCall groups[RL_DEFAULT_BATCH_DRAWCALLS] = { 0 };
+    int vertexCounter = 0;
+
+    for (int g = 0; g < groupCount; g++)
+    {
+        groups[g].mode = batch->draws[groupFirst[g]].mode;
+        groups[g].textureId = batch->draws[groupFirst[g]].textureId;
+
+        for (int d = groupFirst[g]; d != -1; d = drawNext[d]) groups[g].vertexCount += batch->draws[d].vertexCount;
+
+        if ((groups[g].mode != RL_QUADS) && (g < (groupCount - 1))) groups[g].vertexAlignment = (4 - groups[g].vertexCount%4)%4;
+        vertexCounter += (groups[g].vertexCount + groups[g].vertexAlignment);
+    }
+
+    if (vertexCounter > buffer->elementCount*4) return;
+
+    // Reorder vertex data, one stream at a time through the scratch buffer
+    unsigned char *streams[4] = { 0 };
+    int strides[4] = { 0 };
+    int streamCount = 0;
+
+    if (compact) { streams[0] = (unsigned char *)buffer->compactVertices; strides[0] = sizeof(rlVertexCompact); streamCount = 1; }
+    else
+    {
+        streams[0] = (unsigned char *)buffer->vertices; strides[0] = 3*sizeof(float);
+        streams[1] = (unsigned char *)buffer->texcoords; strides[1] = 2*sizeof(float);
+        streams[2] = (unsigned char *)buffer->normals; strides[2] = 3*sizeof(float);
+        streams[3] = (unsigned char *)buffer->colors; strides[3] = 4*sizeof(unsigned char);
+        streamCount = 4;
+    }
+
+    for (int s = 0; s < streamCount; s++)
+    {
+        unsigned char *scratch = (unsigned char *)batch->sortBuffer;
+        int stride = strides[s];
+        int vertex = 0;
+
+        memcpy(scratch, streams[s], RLGL.State.vertexCounter*stride);
+
+        for (int g = 0; g < groupCount; g++)
+        {
+            for (int d = groupFirst[g]; d != -1; d = drawNext[d])
+            {
+                memcpy(streams[s] + vertex*stride, scratch + drawOffsets[d]*stride, batch->draws[d].vertexCount*stride);
+                vertex += batch->draws[d].vertexCount;
+            }
+
+            vertex += groups[g].vertexAlignment;
+        }
+    }
+
+    for (int g = 0; g < groupCount; g++) batch->draws[g] = groups[g];
+    batch->drawCounter = groupCount;
+    RLGL.State.vertexCounter = vertexCounter;
+}
+
+// Transform quad positions (4 vertex, XY interleaved) by a 2D affine transform
+// NOTE: affine is { m0, m1, m4, m5, m12, m13 }, same operations order as the full transform
+static void rlTransformQuad2D(const float *positions, const float *affine, float *result)
+{
+#if defined(RL_SIMD_SSE2)
+    const __m128 col0 = _mm_setr_ps(affine[0], affine[1], affine[0], affine[1]);
+    const __m128 col1 = _mm_setr_ps(affine[2], affine[3], affine[2], affine[3]);
+    const __m128 col3 = _mm_setr_ps(affine[4], affine[5], affine[4], affine[5]);
+
+    for (int i = 0; i < 8; i += 4)
+    {
+        __m128 xy = _mm_loadu_ps(positions + i);                        // x0, y0, x1, y1
+        __m128 xx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0));    // x0, x0, x1, x1
+        __m128 yy = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1));    // y0, y0, y1, y1
+
+        _mm_storeu_ps(result + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, xx), _mm_mul_ps(col1, yy)), col3));
+    }
+#elif defined(RL_SIMD_NEON)
+    const float32x4_t col0 = { affine[0], affine[1], affine[0], affine[1] };
+    const float32x4_t col1 = { affine[2], affine[3], affine[2], affine[3] };
+    const float32x4_t col3 = { affine[4], affine[5], affine[4], affine[5] };
+
+    for (int i = 0; i < 8; i += 4)
+    {
+        float32x4_t xy = vld1q_f32(positions + i);                      // x0, y0, x1, y1
+        float32x4x2_t split = vtrnq_f32(xy, xy);                        // x0, x0, x1, x1 | y0, y0, y1, y1
+
+        vst1q_f32(result + i, vaddq_f32(vaddq_f32(vmulq_f32(col0, split.val[0]), vmulq_f32(col1, split.val[1])), col3));
+    }
+#else
+    for (int i = 0; i < 8; i += 2)
+    {
+        result[i] = affine[0]*positions[i] + affine[2]*positions[i + 1] + affine[4];
+        result[i + 1] = affine[1]*positions[i] + affine[3]*positions[i + 1] + affine[5];
+    }
+#endif
+}
+
+// Grow recording render batch arrays to fit vCount more vertex and a new draw call
+// NOTE: Arrays size is doubled, recorded data is kept, recording thread state refers to RLGL.currentBatch
+// WARNING: Arrays are only replaced if all allocations succeed, on failure recorded data is dropped
+// so next vertex are still written inside current arrays
+static bool rlGrowRenderBatch(rlRenderBatch *batch, int vCount)
+{
+    bool result = true;
+    rlVertexBuffer *buffer = &batch->vertexBuffer[0];
+    int elementCount = buffer->elementCount;
+
+    while ((RLGL.State.vertexCounter + vCount) >= elementCount*4) elementCount *= 2;
+
+    if (elementCount > buffer->elementCount)
+    {
+        float *vertices = (float *)RL_MALLOC(elementCount*3*4*sizeof(float));
+        float *texcoords = (float *)RL_MALLOC(elementCount*2*4*sizeof(float));
+        float *normals = (float *)RL_MALLOC(elementCount*3*4*sizeof(float));
+        unsigned char *colors = (unsigned char *)RL_MALLOC(elementCount*4*4*sizeof(unsigned char));
+
+        if ((vertices != NULL) && (texcoords != NULL) && (normals != NULL) && (colors != NULL))
+        {
+            memcpy(vertices, buffer->vertices, buffer->elementCount*3*4*sizeof(float));
+            memcpy(texcoords, buffer->texcoords, buffer->elementCount*2*4*sizeof(float));
+            memcpy(normals, buffer->normals, buffer->elementCount*3*4*sizeof(float));
+            memcpy(colors, buffer->colors, buffer->elementCount*4*4*sizeof(unsigned char));
+
+            RL_FREE(buffer->vertices);
+            RL_FREE(buffer->texcoords);
+            RL_FREE(buffer->normals);
+            RL_FREE(buffer->colors);
+
+            buffer->vertices = vertices;
+            buffer->texcoords = texcoords;
+            buffer->normals = normals;
+            buffer->colors = colors;
+            buffer->elementCount = elementCount;
+        }
+        else
+        {
+            RL_FREE(vertices);
+            RL_FREE(texcoords);
+            RL_FREE(normals);
+            RL_FREE(colors);
+
+            TRACELOG(RL_LOG_WARNING, "RLGL: Failed to grow recording render batch vertex data");
+            result = false;
+        }
+    }
+
+    if (result && ((batch->drawCounter + 1) >= batch->drawCapacity))
+    {
+        rlDrawCall *draws = (rlDrawCall *)RL_REALLOC(batch->draws, 2*batch->drawCapacity*sizeof(rlDrawCall));
+
+        if (draws != NULL)
+        {
+            for (int i = batch->drawCapacity; i < 2*batch->drawCapacity; i++)
+            {
+                draws[i].mode = RL_QUADS;
+                draws[i].vertexCount = 0;
+                draws[i].vertexAlignment = 0;
+                draws[i].textureId = RLGL.State.defaultTextureId;
+            }
+
+            batch->draws = draws;
+            batch->drawCapacity *= 2;
+        }
+        else
+        {
+            TRACELOG(RL_LOG_WARNING, "RLGL: Failed to grow recording render batch draw calls");
+            result = false;
+        }
+    }
+
+    if (!result)
+    {
+        // Drop recorded data, current draw call mode and texture are kept
+        TRACELOG(RL_LOG_WARNING, "RLGL: Recorded render batch data dropped");
+
+        int currentMode = batch->draws[batch->drawCounter - 1].mode;
+        int currentTexture = batch->draws[batch->drawCounter - 1].textureId;
+
+        for (int i = 0; i < batch->drawCounter; i++)
+        {
+            batch->draws[i].mode = RL_QUADS;
+            batch->draws[i].vertexCount = 0;
+            batch->draws[i].vertexAlignment = 0;
+            batch->draws[i].textureId = RLGL.State.defaultTextureId;
+        }
+
+        batch->drawCounter = 1;
+        batch->draws[0].mode = currentMode;
+        batch->draws[0].textureId = currentTexture;
+        batch->currentDepth = -1.0f;
+        RLGL.State.vertexCounter = 0;
+    }
+
+    return result;
+}
+
 #if defined(RLGL_SHOW_GL_DETAILS_INFO)
 // Get compressed format official GL identifier name
 static const char *rlGetCompressedFormatName(int format)
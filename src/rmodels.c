@@ -18,6 +18,15 @@
 *           Support procedural mesh generation functions, uses external par_shapes.h library
 *           NOTE: Some generated meshes DO NOT include generated texture coordinates
 *
+*       #define SUPPORT_THREADED_SKINNING
+*           Split CPU skinning of large meshes across multiple threads: UpdateModelAnimation()
+*
+*       #define SUPPORT_GLTF_FILE_MAPPING
+*           Map glTF/glb files in memory instead of loading them, tightly packed accessors read directly
+*
+*       #define SUPPORT_GLTF_BAKED_POSES
+*           Bake glTF animations poses by frame (ModelAnimation.framePoses), keyframes are always kept
+*
 *
 *   LICENSE: zlib/libpng
 *
@@ -57,6 +66,7 @@
 #include <stdlib.h>         // Required for: malloc(), calloc(), free()
 #include <string.h>         // Required for: memcmp(), strlen(), strncpy()
 #include <math.h>           // Required for: sinf(), cosf(), sqrtf(), fabsf()
+#include <float.h>          // Required for: FLT_MAX
 
 #if defined(SUPPORT_FILEFORMAT_OBJ) || defined(SUPPORT_FILEFORMAT_MTL)
     #define TINYOBJ_MALLOC RL_MALLOC
@@ -123,6 +133,33 @@
     #define CHDIR chdir
 #endif
 
+#if defined(SUPPORT_THREADED_SKINNING)
+    #if defined(_WIN32)
+        #include <process.h>    // Required for: _beginthreadex() [Used in UpdateModelAnimation()]
+
+        // NOTE: Declaring required Win32 symbols to avoid including windows.h (kernel32.lib linkage required)
+        #if defined(__cplusplus)
+        extern "C" {
+        #endif
+        __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *hHandle, unsigned long dwMilliseconds);
+        __declspec(dllimport) int __stdcall CloseHandle(void *hObject);
+        #if defined(__cplusplus)
+        }
+        #endif
+    #else
+        #include <pthread.h>    // Required for: pthread_create(), pthread_join() [Used in UpdateModelAnimation()]
+    #endif
+#endif
+
+// SIMD support, used on CPU skinning
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define MODELS_SIMD_SSE2
+    #include <emmintrin.h>      // Required for: _mm_loadu_ps(), _mm_mul_ps(), _mm_add_ps(), _mm_storel_pi()
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    #define MODELS_SIMD_NEON
+    #include <arm_neon.h>       // Required for: vld1q_f32(), vmlaq_n_f32(), vst1_f32()
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -132,11 +169,89 @@
 #ifndef MAX_MESH_VERTEX_BUFFERS
     #define MAX_MESH_VERTEX_BUFFERS  9    // Maximum vertex buffers (VBO) per mesh
 #endif
+#ifndef MAX_SKINNING_THREADS
+    #define MAX_SKINNING_THREADS     4    // Maximum threads skinning a mesh (SUPPORT_THREADED_SKINNING)
+#endif
+#ifndef SKINNING_THREAD_VERTICES
+    #define SKINNING_THREAD_VERTICES 8192 // Minimum vertex count skinned by every thread (SUPPORT_THREADED_SKINNING)
+#endif
+#ifndef MESH_BVH_LEAF_TRIANGLES
+    #define MESH_BVH_LEAF_TRIANGLES  4    // Maximum triangles by mesh BVH leaf node, unless not worth splitting
+#endif
+#ifndef MESH_BVH_BINS
+    #define MESH_BVH_BINS           16    // Mesh BVH build bins to evaluate splits (surface area heuristic)
+#endif
+#ifndef MESH_OPTIMIZE_CACHE_SIZE
+    #define MESH_OPTIMIZE_CACHE_SIZE 16   // Post-transform vertex cache size targeted by mesh triangles reordering: OptimizeMesh()
+#endif
+#ifndef ANIMATION_KEY_TOLERANCE
+    #define ANIMATION_KEY_TOLERANCE  0.0001f // Maximum error of animation keyframes removed on loading
+#endif
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+// Bone matrices packed by columns for CPU skinning
+typedef struct SkinningBone {
+    float transform[16];        // Bone transform: m0, m1, m2, 0 | m4, m5, m6, 0 | m8, m9, m10, 0 | m12, m13, m14, 0
+    float normal[12];           // Bone normal matrix, inverse transpose of transform 3x3 (padded columns)
+} SkinningBone;
+
+// CPU skinning job, vertex range of a mesh
+typedef struct SkinningJob {
+    Mesh mesh;                  // Mesh to skin, animVertices and animNormals updated
+    const SkinningBone *bones;  // Mesh bones skinning matrices
+    int first;                  // First vertex to skin
+    int last;                   // Last vertex to skin (not included)
+    bool updated;               // Some vertex has been transformed by bones
+} SkinningJob;
+
+// Mesh bounding volume hierarchy node
+typedef struct MeshBVHNode {
+    Vector3 min;                // Node bounds minimum
+    Vector3 max;                // Node bounds maximum
+    int first;                  // First triangle (leaf node) or first child node, second is next one (inner node)
+    int count;                  // Triangles count, 0 for inner nodes
+} MeshBVHNode;
+
+// Mesh bounding volume hierarchy
+struct rMeshBVH {
+    int nodeCount;              // Number of nodes, first one is root
+    int depth;                  // Maximum nodes depth, required for traversal
+    MeshBVHNode *nodes;         // Nodes array
+    int *triangles;             // Mesh triangles indices, ordered by leaf node
+};
+
+// Animation curve interpolation
+typedef enum {
+    ANIMATION_CURVE_STEP = 0,   // Keyframe value kept until next keyframe
+    ANIMATION_CURVE_LINEAR      // Keyframe values interpolated (Quaternion slerp)
+} AnimationCurveInterpolation;
+
+// Animation curve, keyframes of one bone transform component
+typedef struct AnimationCurve {
+    int keyCount;               // Number of keyframes
+    int interpolation;          // Keyframes interpolation (AnimationCurveInterpolation)
+    float *times;               // Keyframes time (seconds)
+    float *values;              // Keyframes Vector3 values, translation or scale (NULL for rotation)
+    unsigned short *rotations;  // Keyframes Quaternion values compressed, 3 per keyframe (NULL for translation or scale)
+} AnimationCurve;
+
+// Animation keyframes by bone
+struct rAnimationCurves {
+    float duration;             // Animation duration (seconds)
+    Transform root;             // Root transform, applied to first bone
+    AnimationCurve *curves;     // Bones curves, 3 per bone: translation, rotation, scale
+};
+
+#if defined(SUPPORT_FILEFORMAT_GLTF) && defined(SUPPORT_GLTF_FILE_MAPPING)
+// glTF files mapped in memory by cgltf file callbacks, size required to unmap them
+typedef struct GLTFMappedFiles {
+    int count;                  // Number of files mapped
+    unsigned char **data;       // Files mapped data
+    int *dataSize;              // Files mapped data size
+} GLTFMappedFiles;
+#endif
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -167,6 +282,28 @@ static ModelAnimation *LoadModelAnimationsM3D(const char *fileName, int *animCou
 #if defined(SUPPORT_FILEFORMAT_OBJ) || defined(SUPPORT_FILEFORMAT_MTL)
 static void ProcessMaterialsOBJ(Material *rayMaterials, tinyobj_material_t *materials, int materialCount);  // Process obj materials
 #endif
+static void GetMeshTriangle(Mesh mesh, int triangle, Vector3 *p1, Vector3 *p2, Vector3 *p3); // Get mesh triangle vertices
+static int GetRayCollisionMeshTriangle(Ray ray, Mesh mesh, float *distance); // Get closest mesh triangle hit by ray (mesh space)
+static void OptimizeMeshIndicesCache(unsigned int *indices, int indexCount, int vertexCount, int cacheSize); // Reorder triangles for vertex cache locality
+#if defined(SUPPORT_MESH_GENERATION)
+static Mesh GenTerrainChunkMesh(const float *heights, int mapX, int mapZ, Vector3 scale, int startX, int startZ, int quadsX, int quadsZ, int step, float skirtY); // Generate terrain chunk mesh for a level of detail
+#endif
+static void BuildPoseFromParentJoints(BoneInfo *bones, int boneCount, Transform *transforms); // Build pose from parent joints
+static void UpdateModelBoneMatrices(Model model, const Transform *pose, int boneCount); // Update model meshes bone matrices for a pose
+static void UpdateModelAnimationVertices(Model model); // Update model animated vertex data from bone matrices (CPU skinning)
+static void SampleAnimationCurve(const AnimationCurve *curve, float time, float *result); // Sample animation curve at any time
+static float WrapAnimationTime(ModelAnimation anim, float time); // Wrap time to animation duration
+static Transform GetParentRelativeTransform(Transform transform, Transform parent); // Get transform relative to parent transform
+static Transform GetAnimationBoneTransform(ModelAnimation anim, float time, int bone); // Get animation bone transform at time (local space)
+static AnimationCurve LoadAnimationCurve(const float *times, const float *values, int keyCount, int components, int interpolation); // Load animation curve from keyframes
+static void SkinMeshVertices(SkinningJob *job); // Skin mesh vertex range positions and normals (CPU skinning)
+#if defined(SUPPORT_THREADED_SKINNING)
+#if defined(_WIN32)
+static unsigned int __stdcall SkinMeshVerticesThread(void *job); // Skin mesh vertex range, thread entry point
+#else
+static void *SkinMeshVerticesThread(void *job); // Skin mesh vertex range, thread entry point
+#endif
+#endif
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -1182,7 +1319,7 @@ bool IsModelValid(Model model)
         if ((model.meshes[i].colors != NULL) && (model.meshes[i].vboId[3] == 0)) { result = false; break; }  // Vertex colors buffer not uploaded to GPU
         if ((model.meshes[i].tangents != NULL) && (model.meshes[i].vboId[4] == 0)) { result = false; break; }  // Vertex tangents buffer not uploaded to GPU
         if ((model.meshes[i].texcoords2 != NULL) && (model.meshes[i].vboId[5] == 0)) { result = false; break; }  // Vertex texcoords2 buffer not uploaded to GPU
-        if ((model.meshes[i].indices != NULL) && (model.meshes[i].vboId[6] == 0)) { result = false; break; }  // Vertex indices buffer not uploaded to GPU
+        if (((model.meshes[i].indices != NULL) || (model.meshes[i].indices32 != NULL)) && (model.meshes[i].vboId[6] == 0)) { result = false; break; }  // Vertex indices buffer not uploaded to GPU
         if ((model.meshes[i].boneIds != NULL) && (model.meshes[i].vboId[7] == 0)) { result = false; break; }  // Vertex boneIds buffer not uploaded to GPU
         if ((model.meshes[i].boneWeights != NULL) && (model.meshes[i].vboId[8] == 0)) { result = false; break; }  // Vertex boneWeights buffer not uploaded to GPU
 
@@ -1408,7 +1545,12 @@ void UploadMesh(Mesh *mesh, bool dynamic)
     }
 #endif
 
-    if (mesh->indices != NULL)
+    if (mesh->indices32 != NULL)
+    {
+        // NOTE: On OpenGL ES 2.0, 32-bit indices require GL_OES_element_index_uint, checked by rlgl on init
+        mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES] = rlLoadVertexBufferElement(mesh->indices32, mesh->triangleCount*3*sizeof(unsigned int), dynamic);
+    }
+    else if (mesh->indices != NULL)
     {
         mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES] = rlLoadVertexBufferElement(mesh->indices, mesh->triangleCount*3*sizeof(unsigned short), dynamic);
     }
@@ -1454,7 +1596,8 @@ void DrawMesh(Mesh mesh, Material material, Matrix transform)
                    material.maps[MATERIAL_MAP_DIFFUSE].color.b,
                    material.maps[MATERIAL_MAP_DIFFUSE].color.a);
 
-        if (mesh.indices != NULL) rlDrawVertexArrayElements(0, mesh.triangleCount*3, mesh.indices);
+        if (mesh.indices32 != NULL) rlDrawVertexArrayElementsEx(0, mesh.triangleCount*3, mesh.indices32, RL_UNSIGNED_INT);
+        else if (mesh.indices != NULL) rlDrawVertexArrayElements(0, mesh.triangleCount*3, mesh.indices);
         else rlDrawVertexArray(0, mesh.vertexCount);
     rlPopMatrix();
 
@@ -1630,7 +1773,7 @@ void DrawMesh(Mesh mesh, Material material, Matrix transform)
         }
 #endif
 
-        if (mesh.indices != NULL) rlEnableVertexBufferElement(mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES]);
+        if ((mesh.indices != NULL) || (mesh.indices32 != NULL)) rlEnableVertexBufferElement(mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES]);
     }
 
     int eyeCount = 1;
@@ -1652,7 +1795,8 @@ void DrawMesh(Mesh mesh, Material material, Matrix transform)
         rlSetUniformMatrix(material.shader.locs[SHADER_LOC_MATRIX_MVP], matModelViewProjection);
 
         // Draw mesh
-        if (mesh.indices != NULL) rlDrawVertexArrayElements(0, mesh.triangleCount*3, 0);
+        if (mesh.indices32 != NULL) rlDrawVertexArrayElementsEx(0, mesh.triangleCount*3, 0, RL_UNSIGNED_INT);
+        else if (mesh.indices != NULL) rlDrawVertexArrayElements(0, mesh.triangleCount*3, 0);
         else rlDrawVertexArray(0, mesh.vertexCount);
     }
 
@@ -1875,7 +2019,7 @@ void DrawMeshInstanced(Mesh mesh, Material material, const Matrix *transforms, i
         }
 #endif
 
-        if (mesh.indices != NULL) rlEnableVertexBufferElement(mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES]);
+        if ((mesh.indices != NULL) || (mesh.indices32 != NULL)) rlEnableVertexBufferElement(mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES]);
     }
 
     int eyeCount = 1;
@@ -1897,7 +2041,8 @@ void DrawMeshInstanced(Mesh mesh, Material material, const Matrix *transforms, i
         rlSetUniformMatrix(material.shader.locs[SHADER_LOC_MATRIX_MVP], matModelViewProjection);
 
         // Draw mesh instanced
-        if (mesh.indices != NULL) rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount*3, 0, instances);
+        if (mesh.indices32 != NULL) rlDrawVertexArrayElementsInstancedEx(0, mesh.triangleCount*3, 0, instances, RL_UNSIGNED_INT);
+        else if (mesh.indices != NULL) rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount*3, 0, instances);
         else rlDrawVertexArrayInstanced(0, mesh.vertexCount, instances);
     }
 
@@ -1947,12 +2092,15 @@ void UnloadMesh(Mesh mesh)
     RL_FREE(mesh.tangents);
     RL_FREE(mesh.texcoords2);
     RL_FREE(mesh.indices);
+    RL_FREE(mesh.indices32);
 
     RL_FREE(mesh.animVertices);
     RL_FREE(mesh.animNormals);
     RL_FREE(mesh.boneWeights);
     RL_FREE(mesh.boneIds);
     RL_FREE(mesh.boneMatrices);
+
+    UnloadMeshBVH(&mesh);
 }
 
 // Export mesh data to file
@@ -2003,14 +2151,15 @@ bool ExportMesh(Mesh mesh, const char *fileName)
             byteCount += sprintf(txtData + byteCount, "vn %.4f %.4f %.4f\n", mesh.normals[v], mesh.normals[v + 1], mesh.normals[v + 2]);
         }
 
-        if (mesh.indices != NULL)
+        if ((mesh.indices != NULL) || (mesh.indices32 != NULL))
         {
             for (int i = 0, v = 0; i < mesh.triangleCount; i++, v += 3)
             {
-                byteCount += sprintf(txtData + byteCount, "f %i/%i/%i %i/%i/%i %i/%i/%i\n",
-                    mesh.indices[v] + 1, mesh.indices[v] + 1, mesh.indices[v] + 1,
-                    mesh.indices[v + 1] + 1, mesh.indices[v + 1] + 1, mesh.indices[v + 1] + 1,
-                    mesh.indices[v + 2] + 1, mesh.indices[v + 2] + 1, mesh.indices[v + 2] + 1);
+                int i0 = (mesh.indices32 != NULL)? (int)mesh.indices32[v] + 1 : mesh.indices[v] + 1;
+                int i1 = (mesh.indices32 != NULL)? (int)mesh.indices32[v + 1] + 1 : mesh.indices[v + 1] + 1;
+                int i2 = (mesh.indices32 != NULL)? (int)mesh.indices32[v + 2] + 1 : mesh.indices[v + 2] + 1;
+
+                byteCount += sprintf(txtData + byteCount, "f %i/%i/%i %i/%i/%i %i/%i/%i\n", i0, i0, i0, i1, i1, i1, i2, i2, i2);
             }
         }
         else
@@ -2118,6 +2267,13 @@ bool ExportMeshAsCode(Mesh mesh, const char *fileName)
         for (int i = 0; i < mesh.triangleCount*3 - 1; i++) byteCount += sprintf(txtData + byteCount, ((i%TEXT_BYTES_PER_LINE == 0)? "%i,\n" : "%i, "), mesh.indices[i]);
         byteCount += sprintf(txtData + byteCount, "%i };\n", mesh.indices[mesh.triangleCount*3 - 1]);
     }
+
+    if (mesh.indices32 != NULL)     // Vertex indices 32-bit (3 index per triangle - unsigned int)
+    {
+        byteCount += sprintf(txtData + byteCount, "static unsigned int %s_INDEX32_DATA[%i] = { ", varFileName, mesh.triangleCount*3);
+        for (int i = 0; i < mesh.triangleCount*3 - 1; i++) byteCount += sprintf(txtData + byteCount, ((i%TEXT_BYTES_PER_LINE == 0)? "%u,\n" : "%u, "), mesh.indices32[i]);
+        byteCount += sprintf(txtData + byteCount, "%u };\n", mesh.indices32[mesh.triangleCount*3 - 1]);
+    }
     //-----------------------------------------------------------------------------------------
 
     // NOTE: Text data size exported is determined by '\0' (NULL) character
@@ -2241,7 +2397,7 @@ void UnloadMaterial(Material material)
     {
         for (int i = 0; i < MAX_MATERIAL_MAPS; i++)
         {
-            if (material.maps[i].texture.id != rlGetTextureIdDefault()) rlUnloadTexture(material.maps[i].texture.id);
+            if (material.maps[i].texture.id != rlGetTextureIdDefault()) UnloadTexture(material.maps[i].texture);
         }
     }
 
@@ -2286,129 +2442,203 @@ ModelAnimation *LoadModelAnimations(const char *fileName, int *animCount)
 // to be uploaded to shader at drawing, in case GPU skinning is enabled
 void UpdateModelAnimationBones(Model model, ModelAnimation anim, int frame)
 {
-    if ((anim.frameCount > 0) && (anim.bones != NULL) && (anim.framePoses != NULL))
+    if ((anim.frameCount > 0) && (anim.bones != NULL))
     {
         if (frame >= anim.frameCount) frame = frame%anim.frameCount;
 
-        // Get first mesh which have bones
-        int firstMeshWithBones = -1;
-
-        for (int i = 0; i < model.meshCount; i++)
+        if (anim.framePoses != NULL) UpdateModelBoneMatrices(model, anim.framePoses[frame], anim.boneCount);
+        else if (anim.curves != NULL)
         {
-            if (model.meshes[i].boneMatrices)
-            {
-                if (firstMeshWithBones == -1)
-                {
-                    firstMeshWithBones = i;
-                    break;
-                }
-            }
+            // Keyframes are sampled at frame time
+            Transform *pose = (Transform *)RL_MALLOC(anim.boneCount*sizeof(Transform));
+            GetModelAnimationPose(anim, (float)frame/anim.frameRate, pose);
+            UpdateModelBoneMatrices(model, pose, anim.boneCount);
+            RL_FREE(pose);
         }
+    }
+}
+
+// Update model animated vertex data (positions and normals) for a given frame
+// NOTE: Updated data is uploaded to GPU
+void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
+{
+    UpdateModelAnimationBones(model, anim, frame);
+    UpdateModelAnimationVertices(model);
+}
+
+// Update model animated bones transform matrices at any time, interpolating between keyframes
+// NOTE: Time is wrapped to animation duration, updated data is kept at model.meshes[i].boneMatrices[boneId]
+void SampleModelAnimationBones(Model model, ModelAnimation anim, float time)
+{
+    if ((anim.frameCount > 0) && (anim.bones != NULL) && ((anim.framePoses != NULL) || (anim.curves != NULL)) && IsModelAnimationValid(model, anim))
+    {
+        Transform *pose = (Transform *)RL_MALLOC(anim.boneCount*sizeof(Transform));
+        GetModelAnimationPose(anim, time, pose);
+        UpdateModelBoneMatrices(model, pose, anim.boneCount);
+        RL_FREE(pose);
+    }
+}
+
+// Update model animated vertex data (positions and normals) at any time, interpolating between keyframes
+// NOTE: Updated data is uploaded to GPU
+void SampleModelAnimation(Model model, ModelAnimation anim, float time)
+{
+    SampleModelAnimationBones(model, anim, time);
+    UpdateModelAnimationVertices(model);
+}
+
+// Get model animation bones transforms at any time, interpolating between keyframes
+// NOTE: Transforms are in model space, pose array must fit anim.boneCount transforms,
+// time is wrapped to animation duration: keyframes duration or frameCount/frameRate
+void GetModelAnimationPose(ModelAnimation anim, float time, Transform *pose)
+{
+    if ((pose == NULL) || (anim.bones == NULL)) return;
+
+    time = WrapAnimationTime(anim, time);
+
+    if (anim.curves != NULL)
+    {
+        for (int i = 0; i < anim.boneCount; i++) pose[i] = GetAnimationBoneTransform(anim, time, i);
+
+        BuildPoseFromParentJoints(anim.bones, anim.boneCount, pose);
+    }
+    else if ((anim.framePoses != NULL) && (anim.frameCount > 0))
+    {
+        // Poses baked by frame, interpolated between consecutive frames (looping)
+        float frame = time*((anim.frameRate > 0.0f)? anim.frameRate : 60.0f);
+        int frame0 = (int)frame%anim.frameCount;
+        int frame1 = (frame0 + 1)%anim.frameCount;
+        float t = frame - floorf(frame);
 
-        if (firstMeshWithBones != -1)
+        for (int i = 0; i < anim.boneCount; i++)
         {
-            // Update all bones and boneMatrices of first mesh with bones
-            for (int boneId = 0; boneId < anim.boneCount; boneId++)
-            {
-                Transform *bindTransform = &model.bindPose[boneId];
-                Matrix bindMatrix = MatrixMultiply(MatrixMultiply(
-                    MatrixScale(bindTransform->scale.x, bindTransform->scale.y, bindTransform->scale.z),
-                    QuaternionToMatrix(bindTransform->rotation)),
-                    MatrixTranslate(bindTransform->translation.x, bindTransform->translation.y, bindTransform->translation.z));
-
-                Transform *targetTransform = &anim.framePoses[frame][boneId];
-                Matrix targetMatrix = MatrixMultiply(MatrixMultiply(
-                    MatrixScale(targetTransform->scale.x, targetTransform->scale.y, targetTransform->scale.z),
-                    QuaternionToMatrix(targetTransform->rotation)),
-                    MatrixTranslate(targetTransform->translation.x, targetTransform->translation.y, targetTransform->translation.z));
-
-                model.meshes[firstMeshWithBones].boneMatrices[boneId] = MatrixMultiply(MatrixInvert(bindMatrix), targetMatrix);
-            }
+            Transform *pose0 = &anim.framePoses[frame0][i];
+            Transform *pose1 = &anim.framePoses[frame1][i];
 
-            // Update remaining meshes with bones
-            // NOTE: Using deep copy because shallow copy results in double free with 'UnloadModel()'
-            for (int i = firstMeshWithBones + 1; i < model.meshCount; i++)
-            {
-                if (model.meshes[i].boneMatrices)
-                {
-                    memcpy(model.meshes[i].boneMatrices,
-                        model.meshes[firstMeshWithBones].boneMatrices,
-                        model.meshes[i].boneCount*sizeof(model.meshes[i].boneMatrices[0]));
-                }
-            }
+            pose[i].translation = Vector3Lerp(pose0->translation, pose1->translation, t);
+            pose[i].rotation = QuaternionSlerp(pose0->rotation, pose1->rotation, t);
+            pose[i].scale = Vector3Lerp(pose0->scale, pose1->scale, t);
         }
     }
 }
 
-// at least 2x speed up vs the old method
-// Update model animated vertex data (positions and normals) for a given frame
-// NOTE: Updated data is uploaded to GPU
-void UpdateModelAnimation(Model model, ModelAnimation anim, int frame)
+// Load model animation pose buffer, initialized to model bind pose
+// NOTE: Pose buffer keeps model.boneCount transforms in local space (relative to parent bone),
+// animations are blended into it and model is updated once with UpdateModelAnimationPose()
+Transform *LoadModelAnimationPose(Model model)
 {
-    UpdateModelAnimationBones(model,anim,frame);
+    Transform *pose = NULL;
 
-    for (int m = 0; m < model.meshCount; m++)
+    if ((model.boneCount > 0) && (model.bindPose != NULL))
     {
-        Mesh mesh = model.meshes[m];
-        Vector3 animVertex = { 0 };
-        Vector3 animNormal = { 0 };
-        int boneId = 0;
-        int boneCounter = 0;
-        float boneWeight = 0.0;
-        bool updated = false; // Flag to check when anim vertex information is updated
-        const int vValues = mesh.vertexCount*3;
+        pose = (Transform *)RL_MALLOC(model.boneCount*sizeof(Transform));
 
-        // Skip if missing bone data, causes segfault without on some models
-        if ((mesh.boneWeights == NULL) || (mesh.boneIds == NULL)) continue;
+        for (int i = 0; i < model.boneCount; i++)
+        {
+            int parent = model.bones[i].parent;
+
+            if ((parent >= 0) && (parent < i)) pose[i] = GetParentRelativeTransform(model.bindPose[i], model.bindPose[parent]);
+            else pose[i] = model.bindPose[i];
+        }
+    }
+
+    return pose;
+}
+
+// Unload model animation pose buffer
+void UnloadModelAnimationPose(Transform *pose)
+{
+    RL_FREE(pose);
+}
+
+// Load model animation bones mask from a bone and all its children bones
+// NOTE: Mask keeps a weight by bone: 1.0f for masked bones, 0.0f otherwise
+float *LoadModelAnimationMask(Model model, const char *boneName)
+{
+    float *mask = NULL;
+
+    if ((model.boneCount > 0) && (model.bones != NULL))
+    {
+        mask = (float *)RL_CALLOC(model.boneCount, sizeof(float));
 
-        for (int vCounter = 0; vCounter < vValues; vCounter += 3)
+        // NOTE: Bones are topologically sorted, parents are checked before children
+        for (int i = 0; i < model.boneCount; i++)
         {
-            mesh.animVertices[vCounter] = 0;
-            mesh.animVertices[vCounter + 1] = 0;
-            mesh.animVertices[vCounter + 2] = 0;
-            if (mesh.animNormals != NULL)
-            {
-                mesh.animNormals[vCounter] = 0;
-                mesh.animNormals[vCounter + 1] = 0;
-                mesh.animNormals[vCounter + 2] = 0;
-            }
+            int parent = model.bones[i].parent;
 
-            // Iterates over 4 bones per vertex
-            for (int j = 0; j < 4; j++, boneCounter++)
-            {
-                boneWeight = mesh.boneWeights[boneCounter];
-                boneId = mesh.boneIds[boneCounter];
-
-                // Early stop when no transformation will be applied
-                if (boneWeight == 0.0f) continue;
-                animVertex = (Vector3){ mesh.vertices[vCounter], mesh.vertices[vCounter + 1], mesh.vertices[vCounter + 2] };
-                animVertex = Vector3Transform(animVertex,model.meshes[m].boneMatrices[boneId]);
-                mesh.animVertices[vCounter] += animVertex.x*boneWeight;
-                mesh.animVertices[vCounter+1] += animVertex.y*boneWeight;
-                mesh.animVertices[vCounter+2] += animVertex.z*boneWeight;
-                updated = true;
-
-                // Normals processing
-                // NOTE: We use meshes.baseNormals (default normal) to calculate meshes.normals (animated normals)
-                if ((mesh.normals != NULL) && (mesh.animNormals != NULL ))
-                {
-                    animNormal = (Vector3){ mesh.normals[vCounter], mesh.normals[vCounter + 1], mesh.normals[vCounter + 2] };
-                    animNormal = Vector3Transform(animNormal, MatrixTranspose(MatrixInvert(model.meshes[m].boneMatrices[boneId])));
-                    mesh.animNormals[vCounter] += animNormal.x*boneWeight;
-                    mesh.animNormals[vCounter + 1] += animNormal.y*boneWeight;
-                    mesh.animNormals[vCounter + 2] += animNormal.z*boneWeight;
-                }
-            }
+            if ((boneName != NULL) && (strcmp(model.bones[i].name, boneName) == 0)) mask[i] = 1.0f;
+            else if ((parent >= 0) && (parent < i)) mask[i] = mask[parent];
         }
+    }
 
-        if (updated)
+    return mask;
+}
+
+// Unload model animation bones mask
+void UnloadModelAnimationMask(float *mask)
+{
+    RL_FREE(mask);
+}
+
+// Blend model animation at any time into pose buffer
+// NOTE: Bones transforms are blended in local space: pose = lerp(pose, animation, weight*boneMask[boneId]),
+// weight 1.0f replaces masked bones transforms, boneMask can be NULL to blend all bones,
+// pose and boneMask must fit model.boneCount, animation skeleton must match model skeleton
+void BlendModelAnimationPose(Model model, ModelAnimation anim, float time, float weight, const float *boneMask, Transform *pose)
+{
+    if ((pose == NULL) || (anim.bones == NULL) || (weight <= 0.0f)) return;
+    if ((anim.framePoses == NULL) && (anim.curves == NULL)) return;
+
+    if (!IsModelAnimationValid(model, anim))
+    {
+        TRACELOG(LOG_WARNING, "MODEL: Animation skeleton does not match model skeleton, animation can not be blended");
+        return;
+    }
+
+    time = WrapAnimationTime(anim, time);
+
+    for (int i = 0; i < anim.boneCount; i++)
+    {
+        float boneWeight = (boneMask != NULL)? weight*boneMask[i] : weight;
+
+        // Only blended bones are sampled
+        if (boneWeight <= 0.0f) continue;
+
+        Transform transform = GetAnimationBoneTransform(anim, time, i);
+
+        if (boneWeight >= 1.0f) pose[i] = transform;
+        else
         {
-            rlUpdateVertexBuffer(mesh.vboId[0], mesh.animVertices, mesh.vertexCount*3*sizeof(float), 0); // Update vertex position
-            if (mesh.normals != NULL) rlUpdateVertexBuffer(mesh.vboId[2], mesh.animNormals, mesh.vertexCount*3*sizeof(float), 0); // Update vertex normals
+            pose[i].translation = Vector3Lerp(pose[i].translation, transform.translation, boneWeight);
+            pose[i].rotation = QuaternionSlerp(pose[i].rotation, transform.rotation, boneWeight);
+            pose[i].scale = Vector3Lerp(pose[i].scale, transform.scale, boneWeight);
         }
     }
 }
 
+// Update model animated vertex data (positions and normals) from pose buffer
+// NOTE: Pose is built from parent bones once and meshes are skinned once, updated data is uploaded to GPU
+void UpdateModelAnimationPose(Model model, const Transform *pose)
+{
+    UpdateModelAnimationPoseBones(model, pose);
+    UpdateModelAnimationVertices(model);
+}
+
+// Update model animated bones transform matrices from pose buffer
+// NOTE: Updated data is kept at model.meshes[i].boneMatrices[boneId], to be uploaded to shader at drawing
+void UpdateModelAnimationPoseBones(Model model, const Transform *pose)
+{
+    if ((pose == NULL) || (model.boneCount <= 0) || (model.bones == NULL)) return;
+
+    Transform *modelPose = (Transform *)RL_MALLOC(model.boneCount*sizeof(Transform));
+    memcpy(modelPose, pose, model.boneCount*sizeof(Transform));
+
+    BuildPoseFromParentJoints(model.bones, model.boneCount, modelPose);
+    UpdateModelBoneMatrices(model, modelPose, model.boneCount);
+
+    RL_FREE(modelPose);
+}
+
 // Unload animation array data
 void UnloadModelAnimations(ModelAnimation *animations, int animCount)
 {
@@ -2419,7 +2649,23 @@ void UnloadModelAnimations(ModelAnimation *animations, int animCount)
 // Unload animation data
 void UnloadModelAnimation(ModelAnimation anim)
 {
-    for (int i = 0; i < anim.frameCount; i++) RL_FREE(anim.framePoses[i]);
+    if (anim.framePoses != NULL)
+    {
+        for (int i = 0; i < anim.frameCount; i++) RL_FREE(anim.framePoses[i]);
+    }
+
+    if (anim.curves != NULL)
+    {
+        for (int i = 0; i < 3*anim.boneCount; i++)
+        {
+            RL_FREE(anim.curves->curves[i].times);
+            RL_FREE(anim.curves->curves[i].values);
+            RL_FREE(anim.curves->curves[i].rotations);
+        }
+
+        RL_FREE(anim.curves->curves);
+        RL_FREE(anim.curves);
+    }
 
     RL_FREE(anim.bones);
     RL_FREE(anim.framePoses);
@@ -3233,6 +3479,36 @@ Mesh GenMeshHeightmap(Image heightmap, Vector3 size)
 
     UnloadImageColors(pixels);  // Unload pixels color data
 
+#if defined(SUPPORT_MESH_OPTIMIZATION)
+    // Smooth normals by height sample, vertices shared by adjacent triangles can be welded
+    // NOTE: Quad vertices are generated in order: (x, z), (x, z + 1), (x + 1, z), (x + 1, z), (x, z + 1), (x + 1, z + 1)
+    const int quadCornerX[6] = { 0, 0, 1, 1, 0, 1 };
+    const int quadCornerZ[6] = { 0, 1, 0, 0, 1, 1 };
+    Vector3 *sampleNormals = (Vector3 *)RL_CALLOC(mapX*mapZ, sizeof(Vector3));
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int v = 0; v < mesh.vertexCount; v++)
+        {
+            int quad = v/6;
+            int sample = (quad%(mapX - 1) + quadCornerX[v%6]) + (quad/(mapX - 1) + quadCornerZ[v%6])*mapX;
+
+            if (pass == 0) sampleNormals[sample] = Vector3Add(sampleNormals[sample], (Vector3){ mesh.normals[v*3], mesh.normals[v*3 + 1], mesh.normals[v*3 + 2] });
+            else
+            {
+                vN = Vector3Normalize(sampleNormals[sample]);
+                mesh.normals[v*3] = vN.x;
+                mesh.normals[v*3 + 1] = vN.y;
+                mesh.normals[v*3 + 2] = vN.z;
+            }
+        }
+    }
+
+    RL_FREE(sampleNormals);
+
+    OptimizeMesh(&mesh);        // Weld vertices shared by adjacent triangles
+#endif
+
     // Upload vertex data to GPU (static mesh)
     UploadMesh(&mesh, false);
 
@@ -3581,11 +3857,176 @@ Mesh GenMeshCubicmap(Image cubicmap, Vector3 cubeSize)
 
     UnloadImageColors(pixels);   // Unload pixels color data
 
+#if defined(SUPPORT_MESH_OPTIMIZATION)
+    OptimizeMesh(&mesh);        // Weld vertices shared by adjacent triangles
+#endif
+
     // Upload vertex data to GPU (static mesh)
     UploadMesh(&mesh, false);
 
     return mesh;
 }
+
+// Load terrain from heightmap image data, split in chunks with levels of detail
+// NOTE: Every chunk covers chunkSize*chunkSize height samples quads, every level of detail
+// doubles samples step, chunks skirts hide cracks between neighbour chunks levels of detail
+Terrain LoadTerrain(Image heightmap, Vector3 size, int chunkSize, int lodCount)
+{
+    #define GRAY_VALUE(c) ((float)(c.r + c.g + c.b)/3.0f)
+
+    Terrain terrain = { 0 };
+
+    int mapX = heightmap.width;
+    int mapZ = heightmap.height;
+
+    if ((mapX < 2) || (mapZ < 2) || (chunkSize < 1) || (lodCount < 1))
+    {
+        TRACELOG(LOG_WARNING, "TERRAIN: Failed to load terrain, invalid heightmap size or chunk parameters");
+        return terrain;
+    }
+
+    // Levels of detail are limited to a sampling step (1 << lod) not bigger than chunk size
+    int maxLodCount = 1;
+    while ((chunkSize >> maxLodCount) > 0) maxLodCount++;
+
+    if (lodCount > maxLodCount)
+    {
+        TRACELOG(LOG_WARNING, "TERRAIN: Levels of detail clamped to %i, chunk size %i does not allow more", maxLodCount, chunkSize);
+        lodCount = maxLodCount;
+    }
+
+    Color *pixels = LoadImageColors(heightmap);
+    if (pixels == NULL) return terrain;
+
+    Vector3 scale = { size.x/(mapX - 1), size.y/255.0f, size.z/(mapZ - 1) };
+
+    // Height samples in terrain space
+    float *heights = (float *)RL_MALLOC(mapX*mapZ*sizeof(float));
+    for (int i = 0; i < mapX*mapZ; i++) heights[i] = GRAY_VALUE(pixels[i])*scale.y;
+
+    UnloadImageColors(pixels);  // Unload pixels color data
+
+    terrain.chunkCountX = (mapX - 1 + chunkSize - 1)/chunkSize;
+    terrain.chunkCountZ = (mapZ - 1 + chunkSize - 1)/chunkSize;
+    terrain.lodCount = lodCount;
+    terrain.lodDistance = 2.0f*chunkSize*fmaxf(scale.x, scale.z);
+    terrain.meshes = (Mesh *)RL_CALLOC(terrain.chunkCountX*terrain.chunkCountZ*lodCount, sizeof(Mesh));
+    terrain.bounds = (BoundingBox *)RL_CALLOC(terrain.chunkCountX*terrain.chunkCountZ, sizeof(BoundingBox));
+
+    for (int cz = 0; cz < terrain.chunkCountZ; cz++)
+    {
+        for (int cx = 0; cx < terrain.chunkCountX; cx++)
+        {
+            int chunk = cx + cz*terrain.chunkCountX;
+            int startX = cx*chunkSize;
+            int startZ = cz*chunkSize;
+            int quadsX = ((mapX - 1 - startX) < chunkSize)? (mapX - 1 - startX) : chunkSize;
+            int quadsZ = ((mapZ - 1 - startZ) < chunkSize)? (mapZ - 1 - startZ) : chunkSize;
+
+            // Chunk bounds from full detail height samples, contains all levels of detail
+            float minHeight = heights[startX + startZ*mapX];
+            float maxHeight = minHeight;
+
+            for (int z = startZ; z <= (startZ + quadsZ); z++)
+            {
+                for (int x = startX; x <= (startX + quadsX); x++)
+                {
+                    minHeight = fminf(minHeight, heights[x + z*mapX]);
+                    maxHeight = fmaxf(maxHeight, heights[x + z*mapX]);
+                }
+            }
+
+            terrain.bounds[chunk].min = (Vector3){ startX*scale.x, minHeight, startZ*scale.z };
+            terrain.bounds[chunk].max = (Vector3){ (startX + quadsX)*scale.x, maxHeight, (startZ + quadsZ)*scale.z };
+
+            // NOTE: Skirts go down to chunk lowest height, enough to cover any crack with neighbour chunks
+            for (int lod = 0; lod < lodCount; lod++)
+            {
+                terrain.meshes[chunk*lodCount + lod] = GenTerrainChunkMesh(heights, mapX, mapZ, scale, startX, startZ, quadsX, quadsZ, 1 << lod, minHeight);
+            }
+        }
+    }
+
+    RL_FREE(heights);
+
+    TRACELOG(LOG_INFO, "TERRAIN: Terrain loaded successfully (%ix%i chunks, %i levels of detail)", terrain.chunkCountX, terrain.chunkCountZ, lodCount);
+
+    return terrain;
+}
+
+// Unload terrain chunks meshes from memory (RAM and/or VRAM)
+void UnloadTerrain(Terrain terrain)
+{
+    if (terrain.meshes != NULL)
+    {
+        for (int i = 0; i < terrain.chunkCountX*terrain.chunkCountZ*terrain.lodCount; i++) UnloadMesh(terrain.meshes[i]);
+    }
+
+    RL_FREE(terrain.meshes);
+    RL_FREE(terrain.bounds);
+}
+
+// Draw terrain chunks visible by camera, level of detail selected by camera distance
+// NOTE: Chunks are culled against the current view frustum, it should be called inside BeginMode3D()
+void DrawTerrain(Camera camera, Terrain terrain, Material material, Vector3 position)
+{
+    if (terrain.meshes == NULL) return;
+
+    Matrix transform = MatrixTranslate(position.x, position.y, position.z);
+
+    // Get view frustum planes from model-view-projection matrix rows (ax + by + cz + d >= 0 inside)
+    Matrix mvp = MatrixMultiply(MatrixMultiply(MatrixMultiply(transform, rlGetMatrixTransform()), rlGetMatrixModelview()), rlGetMatrixProjection());
+    Vector4 rows[4] = {
+        { mvp.m0, mvp.m4, mvp.m8, mvp.m12 },
+        { mvp.m1, mvp.m5, mvp.m9, mvp.m13 },
+        { mvp.m2, mvp.m6, mvp.m10, mvp.m14 },
+        { mvp.m3, mvp.m7, mvp.m11, mvp.m15 }
+    };
+    Vector4 planes[6] = { 0 };
+
+    for (int i = 0; i < 3; i++)
+    {
+        planes[i*2] = (Vector4){ rows[3].x + rows[i].x, rows[3].y + rows[i].y, rows[3].z + rows[i].z, rows[3].w + rows[i].w };
+        planes[i*2 + 1] = (Vector4){ rows[3].x - rows[i].x, rows[3].y - rows[i].y, rows[3].z - rows[i].z, rows[3].w - rows[i].w };
+    }
+
+    // Camera position in terrain space
+    Vector3 viewPosition = Vector3Subtract(camera.position, position);
+
+    for (int chunk = 0; chunk < terrain.chunkCountX*terrain.chunkCountZ; chunk++)
+    {
+        BoundingBox box = terrain.bounds[chunk];
+
+        // Chunk culled if its box corner farther along some plane normal is outside
+        bool visible = true;
+        for (int p = 0; (p < 6) && visible; p++)
+        {
+            Vector3 corner = {
+                (planes[p].x >= 0.0f)? box.max.x : box.min.x,
+                (planes[p].y >= 0.0f)? box.max.y : box.min.y,
+                (planes[p].z >= 0.0f)? box.max.z : box.min.z
+            };
+
+            if ((planes[p].x*corner.x + planes[p].y*corner.y + planes[p].z*corner.z + planes[p].w) < 0.0f) visible = false;
+        }
+
+        if (!visible) continue;
+
+        // Select level of detail by camera distance to chunk box
+        Vector3 closest = Vector3Clamp(viewPosition, box.min, box.max);
+        float distance = Vector3Distance(viewPosition, closest);
+        float lodDistance = terrain.lodDistance;
+        int lod = 0;
+
+        while ((lod < (terrain.lodCount - 1)) && (distance > lodDistance))
+        {
+            lodDistance *= 2.0f;
+            lod++;
+        }
+
+        DrawMesh(terrain.meshes[chunk*terrain.lodCount + lod], material, transform);
+    }
+}
 #endif      // SUPPORT_MESH_GENERATION
 
 // Compute mesh bounding box limits
@@ -3653,7 +4094,14 @@ void GenMeshTangents(Mesh *mesh)
         // Get triangle vertex indices
         int i0, i1, i2;
 
-        if (mesh->indices != NULL)
+        if (mesh->indices32 != NULL)
+        {
+            // Use 32-bit indices if available
+            i0 = (int)mesh->indices32[t*3 + 0];
+            i1 = (int)mesh->indices32[t*3 + 1];
+            i2 = (int)mesh->indices32[t*3 + 2];
+        }
+        else if (mesh->indices != NULL)
         {
             // Use indices if available
             i0 = mesh->indices[t*3 + 0];
@@ -3784,44 +4232,398 @@ void GenMeshTangents(Mesh *mesh)
     TRACELOG(LOG_INFO, "MESH: Tangents data computed and uploaded for provided mesh");
 }
 
-// Draw a model (with texture if set)
-void DrawModel(Model model, Vector3 position, float scale, Color tint)
+// Compute mesh triangles bounding volume hierarchy
+// NOTE: Used by GetRayCollisionMesh() for sub-linear ray queries, built from mesh.vertices (bind pose)
+// and must be generated again if vertex or index data changes
+void GenMeshBVH(Mesh *mesh)
 {
-    Vector3 vScale = { scale, scale, scale };
-    Vector3 rotationAxis = { 0.0f, 1.0f, 0.0f };
-
-    DrawModelEx(model, position, rotationAxis, 0.0f, vScale, tint);
-}
+    if ((mesh == NULL) || (mesh->vertices == NULL) || (mesh->triangleCount <= 0))
+    {
+        TRACELOG(LOG_WARNING, "MESH: BVH generation requires vertices and triangles data");
+        return;
+    }
 
-// Draw a model with extended parameters
-void DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
-{
-    // Calculate transformation matrix from function parameters
-    // Get transform matrix (rotation -> scale -> translation)
-    Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
-    Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle*DEG2RAD);
-    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+    UnloadMeshBVH(mesh);
 
-    Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+    int triangleCount = mesh->triangleCount;
+    rMeshBVH *bvh = (rMeshBVH *)RL_CALLOC(1, sizeof(rMeshBVH));
+    bvh->nodes = (MeshBVHNode *)RL_MALLOC((2*triangleCount - 1)*sizeof(MeshBVHNode));
+    bvh->triangles = (int *)RL_MALLOC(triangleCount*sizeof(int));
 
-    // Combine model transformation matrix (model.transform) with matrix generated by function parameters (matTransform)
-    model.transform = MatrixMultiply(model.transform, matTransform);
+    // Triangles bounds and centroids, used to split nodes
+    Vector3 *bounds = (Vector3 *)RL_MALLOC(triangleCount*3*sizeof(Vector3));
 
-    for (int i = 0; i < model.meshCount; i++)
+    for (int i = 0; i < triangleCount; i++)
     {
-        Color color = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color;
-
-        Color colorTint = WHITE;
-        colorTint.r = (unsigned char)(((int)color.r*(int)tint.r)/255);
-        colorTint.g = (unsigned char)(((int)color.g*(int)tint.g)/255);
-        colorTint.b = (unsigned char)(((int)color.b*(int)tint.b)/255);
-        colorTint.a = (unsigned char)(((int)color.a*(int)tint.a)/255);
+        Vector3 p1, p2, p3;
+        GetMeshTriangle(*mesh, i, &p1, &p2, &p3);
 
-        model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = colorTint;
-        DrawMesh(model.meshes[i], model.materials[model.meshMaterial[i]], model.transform);
-        model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = color;
+        bounds[3*i] = Vector3Min(Vector3Min(p1, p2), p3);
+        bounds[3*i + 1] = Vector3Max(Vector3Max(p1, p2), p3);
+        bounds[3*i + 2] = Vector3Scale(Vector3Add(bounds[3*i], bounds[3*i + 1]), 0.5f);
+        bvh->triangles[i] = i;
     }
-}
+
+    // Nodes are split breadth-first by node index, children are appended
+    bvh->nodes[0].first = 0;
+    bvh->nodes[0].count = triangleCount;
+    bvh->nodeCount = 1;
+
+    int *depths = (int *)RL_CALLOC(2*triangleCount - 1, sizeof(int));
+
+    for (int n = 0; n < bvh->nodeCount; n++)
+    {
+        MeshBVHNode *node = &bvh->nodes[n];
+        int *triangles = &bvh->triangles[node->first];
+        Vector3 centroidMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+        Vector3 centroidMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+        node->min = centroidMin;
+        node->max = centroidMax;
+
+        for (int i = 0; i < node->count; i++)
+        {
+            node->min = Vector3Min(node->min, bounds[3*triangles[i]]);
+            node->max = Vector3Max(node->max, bounds[3*triangles[i] + 1]);
+            centroidMin = Vector3Min(centroidMin, bounds[3*triangles[i] + 2]);
+            centroidMax = Vector3Max(centroidMax, bounds[3*triangles[i] + 2]);
+        }
+
+        if (depths[n] > bvh->depth) bvh->depth = depths[n];
+        if (node->count <= MESH_BVH_LEAF_TRIANGLES) continue;
+
+        // Split axis is the longest centroids bounds axis
+        Vector3 extent = Vector3Subtract(centroidMax, centroidMin);
+        int axis = ((extent.x >= extent.y) && (extent.x >= extent.z))? 0 : ((extent.y >= extent.z)? 1 : 2);
+        float axisMin = (&centroidMin.x)[axis];
+        float axisExtent = (&extent.x)[axis];
+        int split = node->count/2;
+
+        if (axisExtent > 0.0f)
+        {
+            // Binned surface area heuristic: split cost is triangles count by bounds area on every side
+            int binCount[MESH_BVH_BINS] = { 0 };
+            Vector3 binMin[MESH_BVH_BINS];
+            Vector3 binMax[MESH_BVH_BINS];
+            float binScale = MESH_BVH_BINS/axisExtent;
+
+            for (int b = 0; b < MESH_BVH_BINS; b++)
+            {
+                binMin[b] = (Vector3){ FLT_MAX, FLT_MAX, FLT_MAX };
+                binMax[b] = (Vector3){ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            }
+
+            for (int i = 0; i < node->count; i++)
+            {
+                int b = (int)(((&bounds[3*triangles[i] + 2].x)[axis] - axisMin)*binScale);
+                if (b >= MESH_BVH_BINS) b = MESH_BVH_BINS - 1;
+
+                binCount[b]++;
+                binMin[b] = Vector3Min(binMin[b], bounds[3*triangles[i]]);
+                binMax[b] = Vector3Max(binMax[b], bounds[3*triangles[i] + 1]);
+            }
+
+            // Sweep bins from the right side to get right side areas, then from the left side evaluating splits
+            float rightArea[MESH_BVH_BINS] = { 0 };
+            Vector3 sideMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+            Vector3 sideMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+            for (int b = MESH_BVH_BINS - 1; b > 0; b--)
+            {
+                sideMin = Vector3Min(sideMin, binMin[b]);
+                sideMax = Vector3Max(sideMax, binMax[b]);
+                Vector3 size = Vector3Subtract(sideMax, sideMin);
+                rightArea[b] = (sideMin.x <= sideMax.x)? size.x*size.y + size.y*size.z + size.z*size.x : 0.0f;
+            }
+
+            Vector3 nodeSize = Vector3Subtract(node->max, node->min);
+            float bestCost = node->count*(nodeSize.x*nodeSize.y + nodeSize.y*nodeSize.z + nodeSize.z*nodeSize.x);
+            int bestBin = -1;
+            int leftCount = 0;
+
+            sideMin = (Vector3){ FLT_MAX, FLT_MAX, FLT_MAX };
+            sideMax = (Vector3){ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+            for (int b = 0; b < (MESH_BVH_BINS - 1); b++)
+            {
+                leftCount += binCount[b];
+                if (binCount[b] > 0)
+                {
+                    sideMin = Vector3Min(sideMin, binMin[b]);
+                    sideMax = Vector3Max(sideMax, binMax[b]);
+                }
+
+                if ((leftCount == 0) || (leftCount == node->count)) continue;
+
+                Vector3 size = Vector3Subtract(sideMax, sideMin);
+                float cost = leftCount*(size.x*size.y + size.y*size.z + size.z*size.x) + (node->count - leftCount)*rightArea[b + 1];
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestBin = b;
+                }
+            }
+
+            if (bestBin >= 0)
+            {
+                // Partition triangles by split bin
+                int left = 0;
+
+                for (int i = 0; i < node->count; i++)
+                {
+                    int b = (int)(((&bounds[3*triangles[i] + 2].x)[axis] - axisMin)*binScale);
+                    if (b >= MESH_BVH_BINS) b = MESH_BVH_BINS - 1;
+
+                    if (b <= bestBin)
+                    {
+                        int triangle = triangles[i];
+                        triangles[i] = triangles[left];
+                        triangles[left] = triangle;
+                        left++;
+                    }
+                }
+
+                split = left;
+            }
+            else if (node->count <= 4*MESH_BVH_LEAF_TRIANGLES) continue;    // Not worth splitting, kept as leaf
+        }
+
+        // Create children nodes, first one keeps triangles before split
+        int child = bvh->nodeCount;
+
+        bvh->nodes[child].first = node->first;
+        bvh->nodes[child].count = split;
+        bvh->nodes[child + 1].first = node->first + split;
+        bvh->nodes[child + 1].count = node->count - split;
+        depths[child] = depths[n] + 1;
+        depths[child + 1] = depths[n] + 1;
+        bvh->nodeCount += 2;
+
+        node->first = child;
+        node->count = 0;
+    }
+
+    bvh->nodes = (MeshBVHNode *)RL_REALLOC(bvh->nodes, bvh->nodeCount*sizeof(MeshBVHNode));
+
+    RL_FREE(depths);
+    RL_FREE(bounds);
+
+    mesh->bvh = bvh;
+}
+
+// Unload mesh triangles bounding volume hierarchy
+void UnloadMeshBVH(Mesh *mesh)
+{
+    if ((mesh != NULL) && (mesh->bvh != NULL))
+    {
+        RL_FREE(mesh->bvh->nodes);
+        RL_FREE(mesh->bvh->triangles);
+        RL_FREE(mesh->bvh);
+        mesh->bvh = NULL;
+    }
+}
+
+// Weld duplicated mesh vertices, generate indices and reorder triangles for vertex cache locality
+// NOTE: Only bitwise identical vertices (all available attributes) are welded,
+// mesh must be optimized before uploading it to GPU
+void OptimizeMesh(Mesh *mesh)
+{
+    if ((mesh == NULL) || (mesh->vertices == NULL) || (mesh->triangleCount <= 0)) return;
+
+    if (mesh->vaoId > 0)
+    {
+        TRACELOG(LOG_WARNING, "MESH: [ID %i] Mesh already uploaded to GPU, it can not be optimized", mesh->vaoId);
+        return;
+    }
+
+    bool indexed = (mesh->indices != NULL) || (mesh->indices32 != NULL);
+    int indexCount = mesh->triangleCount*3;
+
+    if (!indexed && (mesh->vertexCount < indexCount))
+    {
+        TRACELOG(LOG_WARNING, "MESH: Not enough vertices for triangle count, mesh can not be optimized");
+        return;
+    }
+
+    // Vertex attributes considered for welding, not available attributes are skipped
+    struct { unsigned char **data; int size; } attribs[] = {
+        { (unsigned char **)&mesh->vertices, 3*sizeof(float) },
+        { (unsigned char **)&mesh->texcoords, 2*sizeof(float) },
+        { (unsigned char **)&mesh->texcoords2, 2*sizeof(float) },
+        { (unsigned char **)&mesh->normals, 3*sizeof(float) },
+        { (unsigned char **)&mesh->tangents, 4*sizeof(float) },
+        { (unsigned char **)&mesh->colors, 4*sizeof(unsigned char) },
+        { (unsigned char **)&mesh->animVertices, 3*sizeof(float) },
+        { (unsigned char **)&mesh->animNormals, 3*sizeof(float) },
+        { (unsigned char **)&mesh->boneIds, 4*sizeof(unsigned char) },
+        { (unsigned char **)&mesh->boneWeights, 4*sizeof(float) }
+    };
+    int attribCount = sizeof(attribs)/sizeof(attribs[0]);
+
+    // Weld vertices using a hash table (open addressing, linear probing)
+    // NOTE: Hash table stores the first source vertex found for every unique vertex
+    int tableSize = 1;
+    while (tableSize < 2*mesh->vertexCount) tableSize *= 2;
+
+    int *table = (int *)RL_MALLOC(tableSize*sizeof(int));
+    int *remap = (int *)RL_MALLOC(mesh->vertexCount*sizeof(int));           // Unique vertex for every source vertex
+    int *uniqueSource = (int *)RL_MALLOC(mesh->vertexCount*sizeof(int));    // Source vertex for every unique vertex
+    int uniqueCount = 0;
+
+    for (int i = 0; i < tableSize; i++) table[i] = -1;
+
+    for (int v = 0; v < mesh->vertexCount; v++)
+    {
+        // Hash all vertex attributes (FNV-1a)
+        unsigned int hash = 2166136261u;
+        for (int a = 0; a < attribCount; a++)
+        {
+            if (*attribs[a].data == NULL) continue;
+
+            const unsigned char *bytes = *attribs[a].data + v*attribs[a].size;
+            for (int b = 0; b < attribs[a].size; b++) hash = (hash ^ bytes[b])*16777619u;
+        }
+
+        for (int slot = hash & (tableSize - 1); ; slot = (slot + 1) & (tableSize - 1))
+        {
+            int other = table[slot];
+
+            if (other == -1)
+            {
+                table[slot] = v;
+                remap[v] = uniqueCount;
+                uniqueSource[uniqueCount] = v;
+                uniqueCount++;
+                break;
+            }
+
+            bool equal = true;
+            for (int a = 0; (a < attribCount) && equal; a++)
+            {
+                if (*attribs[a].data == NULL) continue;
+
+                int size = attribs[a].size;
+                equal = (memcmp(*attribs[a].data + v*size, *attribs[a].data + other*size, size) == 0);
+            }
+
+            if (equal)
+            {
+                remap[v] = remap[other];
+                break;
+            }
+        }
+    }
+
+    RL_FREE(table);
+
+    // Generate indices referencing unique vertices
+    unsigned int *indices = (unsigned int *)RL_MALLOC(indexCount*sizeof(unsigned int));
+
+    for (int i = 0; i < indexCount; i++)
+    {
+        int v = i;
+        if (mesh->indices32 != NULL) v = (int)mesh->indices32[i];
+        else if (mesh->indices != NULL) v = mesh->indices[i];
+
+        indices[i] = remap[v];
+    }
+
+    OptimizeMeshIndicesCache(indices, indexCount, uniqueCount, MESH_OPTIMIZE_CACHE_SIZE);
+
+    // Reorder vertices by first use for vertex fetch locality, unused vertices are removed
+    int *order = remap;     // Reuse buffer, final vertex for every unique vertex
+    int vertexCount = 0;
+
+    for (int i = 0; i < uniqueCount; i++) order[i] = -1;
+    for (int i = 0; i < indexCount; i++)
+    {
+        if (order[indices[i]] == -1) order[indices[i]] = vertexCount++;
+        indices[i] = order[indices[i]];
+    }
+
+    for (int a = 0; a < attribCount; a++)
+    {
+        if (*attribs[a].data == NULL) continue;
+
+        int size = attribs[a].size;
+        unsigned char *data = (unsigned char *)RL_MALLOC(vertexCount*size);
+
+        for (int i = 0; i < uniqueCount; i++)
+        {
+            if (order[i] >= 0) memcpy(data + order[i]*size, *attribs[a].data + uniqueSource[i]*size, size);
+        }
+
+        RL_FREE(*attribs[a].data);
+        *attribs[a].data = data;
+    }
+
+    RL_FREE(remap);
+    RL_FREE(uniqueSource);
+
+    TRACELOG(LOG_DEBUG, "MESH: Optimized mesh vertex count: %i -> %i", mesh->vertexCount, vertexCount);
+
+    RL_FREE(mesh->indices);
+    RL_FREE(mesh->indices32);
+    mesh->indices = NULL;
+    mesh->indices32 = NULL;
+    mesh->vertexCount = vertexCount;
+
+    // NOTE: 16-bit indices are used when possible
+    if (vertexCount > 65536) mesh->indices32 = indices;
+    else
+    {
+        mesh->indices = (unsigned short *)RL_MALLOC(indexCount*sizeof(unsigned short));
+        for (int i = 0; i < indexCount; i++) mesh->indices[i] = (unsigned short)indices[i];
+        RL_FREE(indices);
+    }
+
+    // Triangles have been reordered, bounding volume hierarchy must be rebuilt
+    if (mesh->bvh != NULL)
+    {
+        UnloadMeshBVH(mesh);
+        GenMeshBVH(mesh);
+    }
+}
+
+// Draw a model (with texture if set)
+void DrawModel(Model model, Vector3 position, float scale, Color tint)
+{
+    Vector3 vScale = { scale, scale, scale };
+    Vector3 rotationAxis = { 0.0f, 1.0f, 0.0f };
+
+    DrawModelEx(model, position, rotationAxis, 0.0f, vScale, tint);
+}
+
+// Draw a model with extended parameters
+void DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis, float rotationAngle, Vector3 scale, Color tint)
+{
+    // Calculate transformation matrix from function parameters
+    // Get transform matrix (rotation -> scale -> translation)
+    Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+    Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle*DEG2RAD);
+    Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
+
+    Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+
+    // Combine model transformation matrix (model.transform) with matrix generated by function parameters (matTransform)
+    model.transform = MatrixMultiply(model.transform, matTransform);
+
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        Color color = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color;
+
+        Color colorTint = WHITE;
+        colorTint.r = (unsigned char)(((int)color.r*(int)tint.r)/255);
+        colorTint.g = (unsigned char)(((int)color.g*(int)tint.g)/255);
+        colorTint.b = (unsigned char)(((int)color.b*(int)tint.b)/255);
+        colorTint.a = (unsigned char)(((int)color.a*(int)tint.a)/255);
+
+        model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = colorTint;
+        DrawMesh(model.meshes[i], model.materials[model.meshMaterial[i]], model.transform);
+        model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = color;
+    }
+}
 
 // Draw a model wires (with texture if set)
 void DrawModelWires(Model model, Vector3 position, float scale, Color tint)
@@ -4139,45 +4941,57 @@ RayCollision GetRayCollisionMesh(Ray ray, Mesh mesh, Matrix transform)
 {
     RayCollision collision = { 0 };
 
-    // Check if mesh vertex data on CPU for testing
-    if (mesh.vertices != NULL)
-    {
-        int triangleCount = mesh.triangleCount;
+    GetRaysCollisionMesh(&ray, 1, mesh, transform, &collision);
 
-        // Test against all triangles in mesh
-        for (int i = 0; i < triangleCount; i++)
-        {
-            Vector3 a, b, c;
-            Vector3 *vertdata = (Vector3 *)mesh.vertices;
+    return collision;
+}
 
-            if (mesh.indices)
-            {
-                a = vertdata[mesh.indices[i*3 + 0]];
-                b = vertdata[mesh.indices[i*3 + 1]];
-                c = vertdata[mesh.indices[i*3 + 2]];
-            }
-            else
-            {
-                a = vertdata[i*3 + 0];
-                b = vertdata[i*3 + 1];
-                c = vertdata[i*3 + 2];
-            }
+// Get collision info between multiple rays and mesh
+// NOTE: Rays are transformed to mesh space once, mesh BVH is used if available (GenMeshBVH())
+void GetRaysCollisionMesh(const Ray *rays, int rayCount, Mesh mesh, Matrix transform, RayCollision *collisions)
+{
+    if ((rays == NULL) || (collisions == NULL)) return;
 
-            a = Vector3Transform(a, transform);
-            b = Vector3Transform(b, transform);
-            c = Vector3Transform(c, transform);
+    // Check if mesh vertex data on CPU for testing and transform can be inverted
+    bool valid = (mesh.vertices != NULL) && (MatrixDeterminant(transform) != 0.0f);
+    Matrix invTransform = MatrixInvert(transform);
 
-            RayCollision triHitInfo = GetRayCollisionTriangle(ray, a, b, c);
+    for (int r = 0; r < rayCount; r++)
+    {
+        RayCollision collision = { 0 };
 
-            if (triHitInfo.hit)
+        if (valid)
+        {
+            // Transform ray to mesh space, direction is not normalized so hit distance is kept
+            Vector3 direction = rays[r].direction;
+            Ray meshRay = { 0 };
+            meshRay.position = Vector3Transform(rays[r].position, invTransform);
+            meshRay.direction.x = invTransform.m0*direction.x + invTransform.m4*direction.y + invTransform.m8*direction.z;
+            meshRay.direction.y = invTransform.m1*direction.x + invTransform.m5*direction.y + invTransform.m9*direction.z;
+            meshRay.direction.z = invTransform.m2*direction.x + invTransform.m6*direction.y + invTransform.m10*direction.z;
+
+            float distance = 0.0f;
+            int triangle = GetRayCollisionMeshTriangle(meshRay, mesh, &distance);
+
+            if (triangle >= 0)
             {
-                // Save the closest hit triangle
-                if ((!collision.hit) || (collision.distance > triHitInfo.distance)) collision = triHitInfo;
+                // Get hit point and normal in world space
+                Vector3 p1, p2, p3;
+                GetMeshTriangle(mesh, triangle, &p1, &p2, &p3);
+
+                p1 = Vector3Transform(p1, transform);
+                p2 = Vector3Transform(p2, transform);
+                p3 = Vector3Transform(p3, transform);
+
+                collision.hit = true;
+                collision.distance = distance;
+                collision.normal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(p2, p1), Vector3Subtract(p3, p1)));
+                collision.point = Vector3Add(rays[r].position, Vector3Scale(direction, distance));
             }
         }
-    }
 
-    return collision;
+        collisions[r] = collision;
+    }
 }
 
 // Get collision info between ray and triangle
@@ -4214,71 +5028,902 @@ RayCollision GetRayCollisionTriangle(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3
     // Calculate u parameter and test bound
     u = Vector3DotProduct(tv, p)*invDet;
 
-    // The intersection lies outside the triangle
-    if ((u < 0.0f) || (u > 1.0f)) return collision;
+    // The intersection lies outside the triangle
+    if ((u < 0.0f) || (u > 1.0f)) return collision;
+
+    // Prepare to test v parameter
+    q = Vector3CrossProduct(tv, edge1);
+
+    // Calculate V parameter and test bound
+    v = Vector3DotProduct(ray.direction, q)*invDet;
+
+    // The intersection lies outside the triangle
+    if ((v < 0.0f) || ((u + v) > 1.0f)) return collision;
+
+    t = Vector3DotProduct(edge2, q)*invDet;
+
+    if (t > EPSILON)
+    {
+        // Ray hit, get hit point and normal
+        collision.hit = true;
+        collision.distance = t;
+        collision.normal = Vector3Normalize(Vector3CrossProduct(edge1, edge2));
+        collision.point = Vector3Add(ray.position, Vector3Scale(ray.direction, t));
+    }
+
+    return collision;
+}
+
+// Get collision info between ray and quad
+// NOTE: The points are expected to be in counter-clockwise winding
+RayCollision GetRayCollisionQuad(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4)
+{
+    RayCollision collision = { 0 };
+
+    collision = GetRayCollisionTriangle(ray, p1, p2, p4);
+
+    if (!collision.hit) collision = GetRayCollisionTriangle(ray, p2, p3, p4);
+
+    return collision;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get mesh triangle vertices, indexed or not
+static void GetMeshTriangle(Mesh mesh, int triangle, Vector3 *p1, Vector3 *p2, Vector3 *p3)
+{
+    Vector3 *vertdata = (Vector3 *)mesh.vertices;
+
+    if (mesh.indices32)
+    {
+        *p1 = vertdata[mesh.indices32[triangle*3 + 0]];
+        *p2 = vertdata[mesh.indices32[triangle*3 + 1]];
+        *p3 = vertdata[mesh.indices32[triangle*3 + 2]];
+    }
+    else if (mesh.indices)
+    {
+        *p1 = vertdata[mesh.indices[triangle*3 + 0]];
+        *p2 = vertdata[mesh.indices[triangle*3 + 1]];
+        *p3 = vertdata[mesh.indices[triangle*3 + 2]];
+    }
+    else
+    {
+        *p1 = vertdata[triangle*3 + 0];
+        *p2 = vertdata[triangle*3 + 1];
+        *p3 = vertdata[triangle*3 + 2];
+    }
+}
+
+// Get closest mesh triangle hit by ray, ray in mesh space
+// NOTE: Returns triangle index or -1 if no hit, mesh BVH nodes are traversed closest first if available
+static int GetRayCollisionMeshTriangle(Ray ray, Mesh mesh, float *distance)
+{
+    int result = -1;
+    float closest = FLT_MAX;
+
+    if (mesh.bvh == NULL)
+    {
+        // Test against all triangles in mesh
+        for (int i = 0; i < mesh.triangleCount; i++)
+        {
+            Vector3 p1, p2, p3;
+            GetMeshTriangle(mesh, i, &p1, &p2, &p3);
+
+            RayCollision triHitInfo = GetRayCollisionTriangle(ray, p1, p2, p3);
+
+            // Save the closest hit triangle
+            if (triHitInfo.hit && (triHitInfo.distance < closest))
+            {
+                closest = triHitInfo.distance;
+                result = i;
+            }
+        }
+    }
+    else
+    {
+        const MeshBVHNode *nodes = mesh.bvh->nodes;
+        Vector3 invDirection = { 1.0f/ray.direction.x, 1.0f/ray.direction.y, 1.0f/ray.direction.z };
+
+        // Nodes pending to be checked, one by tree level is enough
+        int stackBuffer[64] = { 0 };
+        int *stack = (mesh.bvh->depth < 64)? stackBuffer : (int *)RL_MALLOC((mesh.bvh->depth + 1)*sizeof(int));
+        float entries[2] = { 0 };
+        int stackSize = 0;
+
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const MeshBVHNode *node = &nodes[stack[--stackSize]];
+
+            if (node->count > 0)
+            {
+                for (int i = 0; i < node->count; i++)
+                {
+                    int triangle = mesh.bvh->triangles[node->first + i];
+                    Vector3 p1, p2, p3;
+                    GetMeshTriangle(mesh, triangle, &p1, &p2, &p3);
+
+                    RayCollision triHitInfo = GetRayCollisionTriangle(ray, p1, p2, p3);
+
+                    if (triHitInfo.hit && (triHitInfo.distance < closest))
+                    {
+                        closest = triHitInfo.distance;
+                        result = triangle;
+                    }
+                }
+
+                continue;
+            }
+
+            // Check children bounds with slab test, closest child is checked first
+            for (int c = 0; c < 2; c++)
+            {
+                const MeshBVHNode *child = &nodes[node->first + c];
+                float t1 = (child->min.x - ray.position.x)*invDirection.x;
+                float t2 = (child->max.x - ray.position.x)*invDirection.x;
+                float tmin = fminf(t1, t2);
+                float tmax = fmaxf(t1, t2);
+
+                t1 = (child->min.y - ray.position.y)*invDirection.y;
+                t2 = (child->max.y - ray.position.y)*invDirection.y;
+                tmin = fmaxf(tmin, fminf(t1, t2));
+                tmax = fminf(tmax, fmaxf(t1, t2));
+
+                t1 = (child->min.z - ray.position.z)*invDirection.z;
+                t2 = (child->max.z - ray.position.z)*invDirection.z;
+                tmin = fmaxf(tmin, fminf(t1, t2));
+                tmax = fminf(tmax, fmaxf(t1, t2));
+
+                entries[c] = ((tmax >= fmaxf(tmin, 0.0f)) && (tmin < closest))? tmin : FLT_MAX;
+            }
+
+            int first = (entries[0] <= entries[1])? 0 : 1;
+
+            if (entries[1 - first] < FLT_MAX) stack[stackSize++] = node->first + 1 - first;
+            if (entries[first] < FLT_MAX) stack[stackSize++] = node->first + first;
+        }
+
+        if (stack != stackBuffer) RL_FREE(stack);
+    }
+
+    if (result >= 0) *distance = closest;
+
+    return result;
+}
+
+// Reorder triangles for post-transform vertex cache locality
+// NOTE: Tipsify algorithm, triangles are emitted as fans around vertices still in cache,
+// jumping to recently used vertices (dead-ends stack) when the fan vertex is exhausted
+// REF: Fast Triangle Reordering for Vertex Locality and Reduced Overdraw (Sander et al. 2007)
+static void OptimizeMeshIndicesCache(unsigned int *indices, int indexCount, int vertexCount, int cacheSize)
+{
+    int triangleCount = indexCount/3;
+
+    // Vertex-triangle adjacency
+    int *live = (int *)RL_CALLOC(vertexCount, sizeof(int));         // Triangles not emitted yet by vertex
+    int *offsets = (int *)RL_MALLOC((vertexCount + 1)*sizeof(int));
+    int *adjacency = (int *)RL_MALLOC(indexCount*sizeof(int));
+
+    for (int i = 0; i < indexCount; i++) live[indices[i]]++;
+
+    offsets[0] = 0;
+    for (int v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + live[v];
+
+    int *fill = (int *)RL_MALLOC(vertexCount*sizeof(int));
+    memcpy(fill, offsets, vertexCount*sizeof(int));
+    for (int i = 0; i < indexCount; i++) adjacency[fill[indices[i]]++] = i/3;
+    RL_FREE(fill);
+
+    int *cacheTime = (int *)RL_CALLOC(vertexCount, sizeof(int));
+    int *deadEnds = (int *)RL_MALLOC(indexCount*sizeof(int));
+    bool *emitted = (bool *)RL_CALLOC(triangleCount, sizeof(bool));
+    unsigned int *output = (unsigned int *)RL_MALLOC(indexCount*sizeof(unsigned int));
+
+    int deadEndCount = 0;
+    int outputCount = 0;
+    int time = cacheSize + 1;
+    int cursor = 0;
+    int fan = 0;
+
+    while ((fan < vertexCount) && (live[fan] == 0)) fan++;
+    if (fan == vertexCount) fan = -1;
+
+    while (fan >= 0)
+    {
+        int fanStart = outputCount;
+
+        // Emit all remaining triangles around fan vertex
+        for (int k = offsets[fan]; k < offsets[fan + 1]; k++)
+        {
+            int t = adjacency[k];
+            if (emitted[t]) continue;
+
+            for (int c = 0; c < 3; c++)
+            {
+                unsigned int v = indices[t*3 + c];
+
+                output[outputCount++] = v;
+                deadEnds[deadEndCount++] = v;
+                live[v]--;
+
+                if ((time - cacheTime[v]) > cacheSize) cacheTime[v] = time++;
+            }
+
+            emitted[t] = true;
+        }
+
+        // Select next fan vertex: the emitted vertex with remaining triangles
+        // that stays longer in cache after emitting them
+        int next = -1;
+        int best = 0;
+
+        for (int i = fanStart; i < outputCount; i++)
+        {
+            int v = output[i];
+            if (live[v] == 0) continue;
+
+            int priority = 0;
+            if ((time - cacheTime[v] + 2*live[v]) <= cacheSize) priority = time - cacheTime[v];
+
+            if (priority > best)
+            {
+                best = priority;
+                next = v;
+            }
+        }
+
+        // No candidate in cache, use the most recent dead-end or the next vertex in input order
+        while ((next == -1) && (deadEndCount > 0))
+        {
+            int v = deadEnds[--deadEndCount];
+            if (live[v] > 0) next = v;
+        }
+
+        while ((next == -1) && (cursor < vertexCount))
+        {
+            if (live[cursor] > 0) next = cursor;
+            else cursor++;
+        }
+
+        fan = next;
+    }
+
+    memcpy(indices, output, indexCount*sizeof(unsigned int));
+
+    RL_FREE(live);
+    RL_FREE(offsets);
+    RL_FREE(adjacency);
+    RL_FREE(cacheTime);
+    RL_FREE(deadEnds);
+    RL_FREE(emitted);
+    RL_FREE(output);
+}
+
+#if defined(SUPPORT_MESH_GENERATION)
+// Generate terrain chunk mesh for a level of detail
+// NOTE: Samples are taken every step quads, last row/column is clamped to chunk border,
+// vertex normals are computed from full detail height samples (central differences)
+static Mesh GenTerrainChunkMesh(const float *heights, int mapX, int mapZ, Vector3 scale, int startX, int startZ, int quadsX, int quadsZ, int step, float skirtY)
+{
+    Mesh mesh = { 0 };
+
+    int countX = (quadsX + step - 1)/step + 1;  // Grid vertices along X axis
+    int countZ = (quadsZ + step - 1)/step + 1;  // Grid vertices along Z axis
+    int gridCount = countX*countZ;
+
+    // NOTE: Skirts duplicate grid border vertices, lowered to skirt height
+    mesh.vertexCount = gridCount + 2*(countX + countZ);
+    mesh.triangleCount = 2*(countX - 1)*(countZ - 1) + 4*((countX - 1) + (countZ - 1));
+
+    mesh.vertices = (float *)RL_MALLOC(mesh.vertexCount*3*sizeof(float));
+    mesh.normals = (float *)RL_MALLOC(mesh.vertexCount*3*sizeof(float));
+    mesh.texcoords = (float *)RL_MALLOC(mesh.vertexCount*2*sizeof(float));
+
+    unsigned int *indices = (unsigned int *)RL_MALLOC(mesh.triangleCount*3*sizeof(unsigned int));
+    int iCounter = 0;
+
+    // Grid vertices
+    for (int j = 0; j < countZ; j++)
+    {
+        int z = startZ + (((j*step) < quadsZ)? j*step : quadsZ);
+
+        for (int i = 0; i < countX; i++)
+        {
+            int x = startX + (((i*step) < quadsX)? i*step : quadsX);
+            int v = i + j*countX;
+
+            mesh.vertices[v*3] = x*scale.x;
+            mesh.vertices[v*3 + 1] = heights[x + z*mapX];
+            mesh.vertices[v*3 + 2] = z*scale.z;
+
+            mesh.texcoords[v*2] = (float)x/(mapX - 1);
+            mesh.texcoords[v*2 + 1] = (float)z/(mapZ - 1);
+
+            int x0 = (x > 0)? x - 1 : x;
+            int x1 = (x < (mapX - 1))? x + 1 : x;
+            int z0 = (z > 0)? z - 1 : z;
+            int z1 = (z < (mapZ - 1))? z + 1 : z;
+
+            Vector3 normal = {
+                (heights[x0 + z*mapX] - heights[x1 + z*mapX])/((x1 - x0)*scale.x),
+                1.0f,
+                (heights[x + z0*mapX] - heights[x + z1*mapX])/((z1 - z0)*scale.z)
+            };
+            normal = Vector3Normalize(normal);
+
+            mesh.normals[v*3] = normal.x;
+            mesh.normals[v*3 + 1] = normal.y;
+            mesh.normals[v*3 + 2] = normal.z;
+        }
+    }
+
+    // Grid triangles, same winding than GenMeshHeightmap()
+    for (int j = 0; j < (countZ - 1); j++)
+    {
+        for (int i = 0; i < (countX - 1); i++)
+        {
+            unsigned int v = i + j*countX;
+
+            indices[iCounter++] = v;
+            indices[iCounter++] = v + countX;
+            indices[iCounter++] = v + 1;
+
+            indices[iCounter++] = v + 1;
+            indices[iCounter++] = v + countX;
+            indices[iCounter++] = v + countX + 1;
+        }
+    }
+
+    // Skirts along chunk borders: -Z, +Z, -X, +X
+    // NOTE: Border vertices are listed in increasing axis order, flip sets triangles facing outwards
+    int skirtStart[4] = { 0, (countZ - 1)*countX, 0, countX - 1 };
+    int skirtStride[4] = { 1, 1, countX, countX };
+    int skirtCount[4] = { countX, countX, countZ, countZ };
+    bool skirtFlip[4] = { false, true, true, false };
+    int vCounter = gridCount;
+
+    for (int e = 0; e < 4; e++)
+    {
+        int first = vCounter;
+
+        for (int k = 0; k < skirtCount[e]; k++)
+        {
+            int v = skirtStart[e] + k*skirtStride[e];
+
+            mesh.vertices[vCounter*3] = mesh.vertices[v*3];
+            mesh.vertices[vCounter*3 + 1] = skirtY;
+            mesh.vertices[vCounter*3 + 2] = mesh.vertices[v*3 + 2];
+            memcpy(&mesh.normals[vCounter*3], &mesh.normals[v*3], 3*sizeof(float));
+            memcpy(&mesh.texcoords[vCounter*2], &mesh.texcoords[v*2], 2*sizeof(float));
+            vCounter++;
+        }
+
+        for (int k = 0; k < (skirtCount[e] - 1); k++)
+        {
+            unsigned int a = skirtStart[e] + k*skirtStride[e];
+            unsigned int b = a + skirtStride[e];
+            unsigned int la = first + k;
+            unsigned int lb = la + 1;
+
+            if (skirtFlip[e])
+            {
+                indices[iCounter++] = a;
+                indices[iCounter++] = la;
+                indices[iCounter++] = b;
+
+                indices[iCounter++] = b;
+                indices[iCounter++] = la;
+                indices[iCounter++] = lb;
+            }
+            else
+            {
+                indices[iCounter++] = a;
+                indices[iCounter++] = b;
+                indices[iCounter++] = la;
+
+                indices[iCounter++] = b;
+                indices[iCounter++] = lb;
+                indices[iCounter++] = la;
+            }
+        }
+    }
+
+    // NOTE: 16-bit indices are used when possible
+    if (mesh.vertexCount > 65536) mesh.indices32 = indices;
+    else
+    {
+        mesh.indices = (unsigned short *)RL_MALLOC(mesh.triangleCount*3*sizeof(unsigned short));
+        for (int i = 0; i < mesh.triangleCount*3; i++) mesh.indices[i] = (unsigned short)indices[i];
+        RL_FREE(indices);
+    }
+
+    // Upload vertex data to GPU (static mesh)
+    UploadMesh(&mesh, false);
+
+    return mesh;
+}
+#endif
+
+// Build pose from parent joints
+// NOTE: Required for animations loading and keyframes sampling
+static void BuildPoseFromParentJoints(BoneInfo *bones, int boneCount, Transform *transforms)
+{
+    for (int i = 0; i < boneCount; i++)
+    {
+        if (bones[i].parent >= 0)
+        {
+            if (bones[i].parent > i)
+            {
+                TRACELOG(LOG_WARNING, "Assumes bones are toplogically sorted, but bone %d has parent %d. Skipping.", i, bones[i].parent);
+                continue;
+            }
+            transforms[i].rotation = QuaternionMultiply(transforms[bones[i].parent].rotation, transforms[i].rotation);
+            transforms[i].scale = Vector3Multiply(transforms[i].scale, transforms[bones[i].parent].scale);
+            transforms[i].translation = Vector3Multiply(transforms[i].translation, transforms[bones[i].parent].scale);
+            transforms[i].translation = Vector3RotateByQuaternion(transforms[i].translation, transforms[bones[i].parent].rotation);
+            transforms[i].translation = Vector3Add(transforms[i].translation, transforms[bones[i].parent].translation);
+        }
+    }
+}
+
+// Update model meshes bone matrices for a bones pose (model space)
+static void UpdateModelBoneMatrices(Model model, const Transform *pose, int boneCount)
+{
+    // NOTE: Bind pose and mesh bone matrices fit model.boneCount
+    if (boneCount > model.boneCount) boneCount = model.boneCount;
+
+    // Get first mesh which have bones
+    int firstMeshWithBones = -1;
+
+    for (int i = 0; i < model.meshCount; i++)
+    {
+        if (model.meshes[i].boneMatrices)
+        {
+            if (firstMeshWithBones == -1)
+            {
+                firstMeshWithBones = i;
+                break;
+            }
+        }
+    }
+
+    if (firstMeshWithBones != -1)
+    {
+        // Update all bones and boneMatrices of first mesh with bones
+        for (int boneId = 0; boneId < boneCount; boneId++)
+        {
+            Transform *bindTransform = &model.bindPose[boneId];
+            Matrix bindMatrix = MatrixMultiply(MatrixMultiply(
+                MatrixScale(bindTransform->scale.x, bindTransform->scale.y, bindTransform->scale.z),
+                QuaternionToMatrix(bindTransform->rotation)),
+                MatrixTranslate(bindTransform->translation.x, bindTransform->translation.y, bindTransform->translation.z));
+
+            const Transform *targetTransform = &pose[boneId];
+            Matrix targetMatrix = MatrixMultiply(MatrixMultiply(
+                MatrixScale(targetTransform->scale.x, targetTransform->scale.y, targetTransform->scale.z),
+                QuaternionToMatrix(targetTransform->rotation)),
+                MatrixTranslate(targetTransform->translation.x, targetTransform->translation.y, targetTransform->translation.z));
+
+            model.meshes[firstMeshWithBones].boneMatrices[boneId] = MatrixMultiply(MatrixInvert(bindMatrix), targetMatrix);
+        }
+
+        // Update remaining meshes with bones
+        // NOTE: Using deep copy because shallow copy results in double free with 'UnloadModel()'
+        for (int i = firstMeshWithBones + 1; i < model.meshCount; i++)
+        {
+            if (model.meshes[i].boneMatrices)
+            {
+                memcpy(model.meshes[i].boneMatrices,
+                    model.meshes[firstMeshWithBones].boneMatrices,
+                    model.meshes[i].boneCount*sizeof(model.meshes[i].boneMatrices[0]));
+            }
+        }
+    }
+}
+
+// Update model animated vertex data (positions and normals) from meshes bone matrices (CPU skinning)
+// NOTE: Bone transforms and normal matrices are computed once per mesh, every vertex blends
+// its weighted bone matrices and transforms position and normal once; updated data is uploaded to GPU
+static void UpdateModelAnimationVertices(Model model)
+{
+    SkinningBone *bones = NULL;
+    int bonesCapacity = 0;
+
+    for (int m = 0; m < model.meshCount; m++)
+    {
+        Mesh mesh = model.meshes[m];
+
+        // Skip if missing bone data, causes segfault without on some models
+        if ((mesh.boneWeights == NULL) || (mesh.boneIds == NULL) || (mesh.boneMatrices == NULL) || (mesh.animVertices == NULL)) continue;
+
+        if (mesh.boneCount > bonesCapacity)
+        {
+            SkinningBone *newBones = (SkinningBone *)RL_REALLOC(bones, mesh.boneCount*sizeof(SkinningBone));
+            if (newBones == NULL) break;
+
+            bones = newBones;
+            bonesCapacity = mesh.boneCount;
+        }
+
+        for (int i = 0; i < mesh.boneCount; i++)
+        {
+            Matrix mat = mesh.boneMatrices[i];
+            float *transform = bones[i].transform;
+            float *normal = bones[i].normal;
+
+            transform[0] = mat.m0; transform[1] = mat.m1; transform[2] = mat.m2; transform[3] = 0.0f;
+            transform[4] = mat.m4; transform[5] = mat.m5; transform[6] = mat.m6; transform[7] = 0.0f;
+            transform[8] = mat.m8; transform[9] = mat.m9; transform[10] = mat.m10; transform[11] = 0.0f;
+            transform[12] = mat.m12; transform[13] = mat.m13; transform[14] = mat.m14; transform[15] = 0.0f;
+
+            // Normal matrix from 3x3 cofactors, same as MatrixTranspose(MatrixInvert(mat)) for affine transforms
+            // NOTE: Degenerated transforms (zero scale) keep cofactors, avoiding NaN normals
+            float c00 = mat.m5*mat.m10 - mat.m9*mat.m6;
+            float c01 = mat.m9*mat.m2 - mat.m1*mat.m10;
+            float c02 = mat.m1*mat.m6 - mat.m5*mat.m2;
+            float det = mat.m0*c00 + mat.m4*c01 + mat.m8*c02;
+            float invDet = (det != 0.0f)? 1.0f/det : 1.0f;
+
+            normal[0] = c00*invDet;
+            normal[1] = (mat.m8*mat.m6 - mat.m4*mat.m10)*invDet;
+            normal[2] = (mat.m4*mat.m9 - mat.m8*mat.m5)*invDet;
+            normal[3] = 0.0f;
+            normal[4] = c01*invDet;
+            normal[5] = (mat.m0*mat.m10 - mat.m8*mat.m2)*invDet;
+            normal[6] = (mat.m8*mat.m1 - mat.m0*mat.m9)*invDet;
+            normal[7] = 0.0f;
+            normal[8] = c02*invDet;
+            normal[9] = (mat.m4*mat.m2 - mat.m0*mat.m6)*invDet;
+            normal[10] = (mat.m0*mat.m5 - mat.m4*mat.m1)*invDet;
+            normal[11] = 0.0f;
+        }
+
+        // Split vertex data in ranges, large meshes are skinned by multiple threads
+        SkinningJob jobs[MAX_SKINNING_THREADS] = { 0 };
+        int jobCount = 1;
+#if defined(SUPPORT_THREADED_SKINNING)
+        jobCount = mesh.vertexCount/SKINNING_THREAD_VERTICES;
+        if (jobCount > MAX_SKINNING_THREADS) jobCount = MAX_SKINNING_THREADS;
+        if (jobCount < 1) jobCount = 1;
+#endif
+        for (int i = 0; i < jobCount; i++)
+        {
+            jobs[i].mesh = mesh;
+            jobs[i].bones = bones;
+            jobs[i].first = (int)((long long)mesh.vertexCount*i/jobCount);
+            jobs[i].last = (int)((long long)mesh.vertexCount*(i + 1)/jobCount);
+        }
+
+#if defined(SUPPORT_THREADED_SKINNING)
+    #if defined(_WIN32)
+        uintptr_t threads[MAX_SKINNING_THREADS] = { 0 };
+        for (int i = 1; i < jobCount; i++) threads[i] = _beginthreadex(NULL, 0, SkinMeshVerticesThread, &jobs[i], 0, NULL);
+    #else
+        pthread_t threads[MAX_SKINNING_THREADS] = { 0 };
+        bool started[MAX_SKINNING_THREADS] = { 0 };
+        for (int i = 1; i < jobCount; i++) started[i] = (pthread_create(&threads[i], NULL, SkinMeshVerticesThread, &jobs[i]) == 0);
+    #endif
+#endif
+        SkinMeshVertices(&jobs[0]);
+
+        bool updated = jobs[0].updated; // Flag to check when anim vertex information is updated
+
+        for (int i = 1; i < jobCount; i++)
+        {
+#if defined(SUPPORT_THREADED_SKINNING)
+            // Job skinned on calling thread if its thread could not be started
+    #if defined(_WIN32)
+            if (threads[i] != 0)
+            {
+                WaitForSingleObject((void *)threads[i], 0xFFFFFFFF);  // INFINITE
+                CloseHandle((void *)threads[i]);
+            }
+            else SkinMeshVertices(&jobs[i]);
+    #else
+            if (started[i]) pthread_join(threads[i], NULL);
+            else SkinMeshVertices(&jobs[i]);
+    #endif
+#endif
+            updated |= jobs[i].updated;
+        }
+
+        if (updated)
+        {
+            rlUpdateVertexBuffer(mesh.vboId[0], mesh.animVertices, mesh.vertexCount*3*sizeof(float), 0); // Update vertex position
+            if (mesh.normals != NULL) rlUpdateVertexBuffer(mesh.vboId[2], mesh.animNormals, mesh.vertexCount*3*sizeof(float), 0); // Update vertex normals
+        }
+    }
+
+    RL_FREE(bones);
+}
+
+// Compress a quaternion into 3 unsigned short values (48 bit): smallest three components
+// NOTE: Largest component is dropped (made positive, q and -q are the same rotation) and rebuilt on decompression,
+// its index is stored in the high bit of first two values, remaining components quantized to 15 bit
+static void CompressQuaternion(Quaternion q, unsigned short *packed)
+{
+    float c[4] = { q.x, q.y, q.z, q.w };
+    float length = sqrtf(c[0]*c[0] + c[1]*c[1] + c[2]*c[2] + c[3]*c[3]);
+    int largest = 0;
+
+    if (length == 0.0f) { c[3] = 1.0f; length = 1.0f; }
+    for (int i = 1; i < 4; i++) if (fabsf(c[i]) > fabsf(c[largest])) largest = i;
+
+    float scale = ((c[largest] < 0.0f)? -1.0f : 1.0f)/length;
+
+    for (int i = 0, k = 0; i < 4; i++)
+    {
+        if (i == largest) continue;
+
+        // Smallest components range is [-1/sqrt(2)..1/sqrt(2)]
+        float value = (c[i]*scale*1.41421356f + 1.0f)*0.5f;
+        value = (value < 0.0f)? 0.0f : ((value > 1.0f)? 1.0f : value);
+        packed[k++] = (unsigned short)(value*32767.0f + 0.5f);
+    }
+
+    packed[0] |= (unsigned short)((largest >> 1) << 15);
+    packed[1] |= (unsigned short)((largest & 1) << 15);
+}
+
+// Decompress a quaternion from 3 unsigned short values: smallest three components
+static Quaternion DecompressQuaternion(const unsigned short *packed)
+{
+    float c[4] = { 0 };
+    int largest = ((packed[0] >> 15) << 1) | (packed[1] >> 15);
+    float sum = 0.0f;
+
+    for (int i = 0, k = 0; i < 4; i++)
+    {
+        if (i == largest) continue;
+
+        c[i] = ((packed[k++] & 0x7fff)/32767.0f*2.0f - 1.0f)*0.70710678f;
+        sum += c[i]*c[i];
+    }
+
+    c[largest] = (sum < 1.0f)? sqrtf(1.0f - sum) : 0.0f;
+
+    return (Quaternion){ c[0], c[1], c[2], c[3] };
+}
+
+// Get animation curve keyframe value: Vector3 or Quaternion
+static void GetAnimationCurveKey(const AnimationCurve *curve, int key, float *result)
+{
+    if (curve->rotations != NULL)
+    {
+        Quaternion q = DecompressQuaternion(&curve->rotations[3*key]);
+        result[0] = q.x; result[1] = q.y; result[2] = q.z; result[3] = q.w;
+    }
+    else
+    {
+        result[0] = curve->values[3*key];
+        result[1] = curve->values[3*key + 1];
+        result[2] = curve->values[3*key + 2];
+    }
+}
+
+// Interpolate animation curve values: Vector3 linear interpolation or Quaternion slerp
+static void InterpolateAnimationCurve(int components, const float *value1, const float *value2, float amount, float *result)
+{
+    if (components == 4)
+    {
+        Quaternion q = QuaternionSlerp((Quaternion){ value1[0], value1[1], value1[2], value1[3] }, (Quaternion){ value2[0], value2[1], value2[2], value2[3] }, amount);
+        result[0] = q.x; result[1] = q.y; result[2] = q.z; result[3] = q.w;
+    }
+    else
+    {
+        for (int i = 0; i < 3; i++) result[i] = value1[i] + amount*(value2[i] - value1[i]);
+    }
+}
+
+// Sample animation curve at any time
+// NOTE: Time is clamped to curve keyframes range
+static void SampleAnimationCurve(const AnimationCurve *curve, float time, float *result)
+{
+    int last = curve->keyCount - 1;
+
+    if ((last <= 0) || (time <= curve->times[0])) GetAnimationCurveKey(curve, 0, result);
+    else if (time >= curve->times[last]) GetAnimationCurveKey(curve, last, result);
+    else
+    {
+        // Binary search of keyframes surrounding time
+        int key1 = 0;
+        int key2 = last;
+
+        while ((key2 - key1) > 1)
+        {
+            int mid = (key1 + key2)/2;
+
+            if (curve->times[mid] <= time) key1 = mid;
+            else key2 = mid;
+        }
+
+        if (curve->interpolation == ANIMATION_CURVE_STEP) GetAnimationCurveKey(curve, key1, result);
+        else
+        {
+            float value1[4] = { 0 };
+            float value2[4] = { 0 };
+            float amount = (time - curve->times[key1])/(curve->times[key2] - curve->times[key1]);
+
+            GetAnimationCurveKey(curve, key1, value1);
+            GetAnimationCurveKey(curve, key2, value2);
+            InterpolateAnimationCurve((curve->rotations != NULL)? 4 : 3, value1, value2, amount, result);
+        }
+    }
+}
+
+// Wrap time to animation duration: keyframes duration or frameCount/frameRate
+static float WrapAnimationTime(ModelAnimation anim, float time)
+{
+    float duration = 0.0f;
+
+    if (anim.curves != NULL) duration = anim.curves->duration;
+    else if (anim.frameCount > 0) duration = anim.frameCount/((anim.frameRate > 0.0f)? anim.frameRate : 60.0f);
+
+    if (duration > 0.0f)
+    {
+        time = fmodf(time, duration);
+        if (time < 0.0f) time += duration;
+
+        // Avoid rounding up to duration on negative times
+        if (time >= duration) time = 0.0f;
+    }
+    else time = 0.0f;
+
+    return time;
+}
+
+// Get transform relative to parent transform, both transforms in model space
+// NOTE: Inverse of parent transform applied by BuildPoseFromParentJoints()
+static Transform GetParentRelativeTransform(Transform transform, Transform parent)
+{
+    Transform result = { 0 };
+    Quaternion invRotation = QuaternionInvert(parent.rotation);
 
-    // Prepare to test v parameter
-    q = Vector3CrossProduct(tv, edge1);
+    result.rotation = QuaternionMultiply(invRotation, transform.rotation);
+    result.scale = Vector3Divide(transform.scale, parent.scale);
+    result.translation = Vector3RotateByQuaternion(Vector3Subtract(transform.translation, parent.translation), invRotation);
+    result.translation = Vector3Divide(result.translation, parent.scale);
 
-    // Calculate V parameter and test bound
-    v = Vector3DotProduct(ray.direction, q)*invDet;
+    return result;
+}
 
-    // The intersection lies outside the triangle
-    if ((v < 0.0f) || ((u + v) > 1.0f)) return collision;
+// Get animation bone transform at time (already wrapped), in local space
+// NOTE: Root transform of keyframes is included on first bone, baked frames are interpolated (looping)
+static Transform GetAnimationBoneTransform(ModelAnimation anim, float time, int bone)
+{
+    Transform result = { 0 };
 
-    t = Vector3DotProduct(edge2, q)*invDet;
+    if (anim.curves != NULL)
+    {
+        const AnimationCurve *curves = &anim.curves->curves[3*bone];
+        float value[4] = { 0 };
 
-    if (t > EPSILON)
+        SampleAnimationCurve(&curves[0], time, value);
+        result.translation = (Vector3){ value[0], value[1], value[2] };
+        SampleAnimationCurve(&curves[1], time, value);
+        result.rotation = (Quaternion){ value[0], value[1], value[2], value[3] };
+        SampleAnimationCurve(&curves[2], time, value);
+        result.scale = (Vector3){ value[0], value[1], value[2] };
+
+        if (bone == 0)
+        {
+            // Root transform is applied to first bone
+            Transform root = anim.curves->root;
+            result.rotation = QuaternionMultiply(root.rotation, result.rotation);
+            result.scale = Vector3Multiply(result.scale, root.scale);
+            result.translation = Vector3Multiply(result.translation, root.scale);
+            result.translation = Vector3RotateByQuaternion(result.translation, root.rotation);
+            result.translation = Vector3Add(result.translation, root.translation);
+        }
+    }
+    else if ((anim.framePoses != NULL) && (anim.frameCount > 0))
     {
-        // Ray hit, get hit point and normal
-        collision.hit = true;
-        collision.distance = t;
-        collision.normal = Vector3Normalize(Vector3CrossProduct(edge1, edge2));
-        collision.point = Vector3Add(ray.position, Vector3Scale(ray.direction, t));
+        float frame = time*((anim.frameRate > 0.0f)? anim.frameRate : 60.0f);
+        int frame0 = (int)frame%anim.frameCount;
+        int frame1 = (frame0 + 1)%anim.frameCount;
+        float t = frame - floorf(frame);
+        int parent = anim.bones[bone].parent;
+
+        // Baked frames keep model space transforms, made relative to parent bone
+        Transform pose0 = anim.framePoses[frame0][bone];
+        Transform pose1 = anim.framePoses[frame1][bone];
+
+        if ((parent >= 0) && (parent < bone))
+        {
+            pose0 = GetParentRelativeTransform(pose0, anim.framePoses[frame0][parent]);
+            pose1 = GetParentRelativeTransform(pose1, anim.framePoses[frame1][parent]);
+        }
+
+        result.translation = Vector3Lerp(pose0.translation, pose1.translation, t);
+        result.rotation = QuaternionSlerp(pose0.rotation, pose1.rotation, t);
+        result.scale = Vector3Lerp(pose0.scale, pose1.scale, t);
     }
 
-    return collision;
+    return result;
 }
 
-// Get collision info between ray and quad
-// NOTE: The points are expected to be in counter-clockwise winding
-RayCollision GetRayCollisionQuad(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4)
+// Check animation curve value error against expected value, quaternions sign is ignored
+static bool AnimationCurveValueEquals(int components, const float *value, const float *expected)
 {
-    RayCollision collision = { 0 };
+    float sign = 1.0f;
 
-    collision = GetRayCollisionTriangle(ray, p1, p2, p4);
+    if (components == 4)
+    {
+        float dot = value[0]*expected[0] + value[1]*expected[1] + value[2]*expected[2] + value[3]*expected[3];
+        if (dot < 0.0f) sign = -1.0f;
+    }
 
-    if (!collision.hit) collision = GetRayCollisionTriangle(ray, p2, p3, p4);
+    for (int i = 0; i < components; i++)
+    {
+        if (fabsf(sign*value[i] - expected[i]) > ANIMATION_KEY_TOLERANCE) return false;
+    }
 
-    return collision;
+    return true;
 }
 
-//----------------------------------------------------------------------------------
-// Module Internal Functions Definition
-//----------------------------------------------------------------------------------
-#if defined(SUPPORT_FILEFORMAT_IQM) || defined(SUPPORT_FILEFORMAT_GLTF)
-// Build pose from parent joints
-// NOTE: Required for animations loading (required by IQM and GLTF)
-static void BuildPoseFromParentJoints(BoneInfo *bones, int boneCount, Transform *transforms)
+// Load animation curve from keyframes, Vector3 (3 components) or Quaternion (4 components) values
+// NOTE: Keyframes reproduced by interpolation of the kept ones (ANIMATION_KEY_TOLERANCE) are removed,
+// quaternions are compressed to 48 bit (smallest three)
+static AnimationCurve LoadAnimationCurve(const float *times, const float *values, int keyCount, int components, int interpolation)
 {
-    for (int i = 0; i < boneCount; i++)
+    AnimationCurve curve = { 0 };
+    int *keys = (int *)RL_MALLOC(keyCount*sizeof(int));
+    int count = 0;
+
+    curve.interpolation = interpolation;
+
+    if (keyCount > 0) keys[count++] = 0;
+
+    for (int i = 1; i < keyCount; i++)
     {
-        if (bones[i].parent >= 0)
+        bool redundant = true;
+        int previous = keys[count - 1];
+
+        if (i == (keyCount - 1)) redundant = AnimationCurveValueEquals(components, &values[components*i], &values[components*previous]) && (count == 1);
+        else if (interpolation == ANIMATION_CURVE_STEP) redundant = AnimationCurveValueEquals(components, &values[components*i], &values[components*previous]);
+        else
         {
-            if (bones[i].parent > i)
+            // Keyframe can be removed if every keyframe from previous kept one is reproduced interpolating to next keyframe
+            for (int k = previous + 1; (k <= i) && redundant; k++)
             {
-                TRACELOG(LOG_WARNING, "Assumes bones are toplogically sorted, but bone %d has parent %d. Skipping.", i, bones[i].parent);
-                continue;
+                float value[4] = { 0 };
+                float amount = (times[i + 1] > times[previous])? (times[k] - times[previous])/(times[i + 1] - times[previous]) : 0.0f;
+
+                InterpolateAnimationCurve(components, &values[components*previous], &values[components*(i + 1)], amount, value);
+                redundant = AnimationCurveValueEquals(components, value, &values[components*k]);
             }
-            transforms[i].rotation = QuaternionMultiply(transforms[bones[i].parent].rotation, transforms[i].rotation);
-            transforms[i].scale = Vector3Multiply(transforms[i].scale, transforms[bones[i].parent].scale);
-            transforms[i].translation = Vector3Multiply(transforms[i].translation, transforms[bones[i].parent].scale);
-            transforms[i].translation = Vector3RotateByQuaternion(transforms[i].translation, transforms[bones[i].parent].rotation);
-            transforms[i].translation = Vector3Add(transforms[i].translation, transforms[bones[i].parent].translation);
+        }
+
+        if (!redundant) keys[count++] = i;
+    }
+
+    curve.keyCount = count;
+    curve.times = (float *)RL_MALLOC(count*sizeof(float));
+
+    if (components == 4) curve.rotations = (unsigned short *)RL_MALLOC(count*3*sizeof(unsigned short));
+    else curve.values = (float *)RL_MALLOC(count*3*sizeof(float));
+
+    for (int i = 0; i < count; i++)
+    {
+        const float *value = &values[components*keys[i]];
+
+        curve.times[i] = times[keys[i]];
+
+        if (components == 4) CompressQuaternion((Quaternion){ value[0], value[1], value[2], value[3] }, &curve.rotations[3*i]);
+        else
+        {
+            curve.values[3*i] = value[0];
+            curve.values[3*i + 1] = value[1];
+            curve.values[3*i + 2] = value[2];
         }
     }
+
+    RL_FREE(keys);
+
+    return curve;
 }
-#endif
 
 #if defined(SUPPORT_FILEFORMAT_OBJ)
 // Load OBJ mesh data
@@ -4517,6 +6162,11 @@ static Model LoadOBJ(const char *fileName)
         }
     }
 
+#if defined(SUPPORT_MESH_OPTIMIZATION)
+    // Weld vertices shared by faces (OBJ faces are loaded as unindexed triangles)
+    for (int i = 0; i < model.meshCount; i++) OptimizeMesh(&model.meshes[i]);
+#endif
+
     if (objMaterialCount > 0) ProcessMaterialsOBJ(model.materials, objMaterials, objMaterialCount);
     else model.materials[0] = LoadMaterialDefault(); // Set default material for the mesh
 
@@ -4713,7 +6363,10 @@ static Model LoadIQM(const char *fileName)
         model.meshes[i].boneWeights = (float *)RL_CALLOC(model.meshes[i].vertexCount*4, sizeof(float));      // Up-to 4 bones supported!
 
         model.meshes[i].triangleCount = imesh[i].num_triangles;
-        model.meshes[i].indices = (unsigned short *)RL_CALLOC(model.meshes[i].triangleCount*3, sizeof(unsigned short));
+
+        // NOTE: 32-bit indices only required if vertex indices do not fit in 16-bit
+        if (model.meshes[i].vertexCount > 65536) model.meshes[i].indices32 = (unsigned int *)RL_CALLOC(model.meshes[i].triangleCount*3, sizeof(unsigned int));
+        else model.meshes[i].indices = (unsigned short *)RL_CALLOC(model.meshes[i].triangleCount*3, sizeof(unsigned short));
 
         // Animated vertex data, what we actually process for rendering
         // NOTE: Animated vertex should be re-uploaded to GPU (if not using GPU skinning)
@@ -4736,9 +6389,18 @@ static Model LoadIQM(const char *fileName)
             // IQM triangles indexes are stored in counter-clockwise, but raylib processes the index in linear order,
             // expecting they point to the counter-clockwise vertex triangle, so we need to reverse triangle indexes
             // NOTE: raylib renders vertex data in counter-clockwise order (standard convention) by default
-            model.meshes[m].indices[tcounter + 2] = tri[i].vertex[0] - imesh[m].first_vertex;
-            model.meshes[m].indices[tcounter + 1] = tri[i].vertex[1] - imesh[m].first_vertex;
-            model.meshes[m].indices[tcounter] = tri[i].vertex[2] - imesh[m].first_vertex;
+            if (model.meshes[m].indices32 != NULL)
+            {
+                model.meshes[m].indices32[tcounter + 2] = tri[i].vertex[0] - imesh[m].first_vertex;
+                model.meshes[m].indices32[tcounter + 1] = tri[i].vertex[1] - imesh[m].first_vertex;
+                model.meshes[m].indices32[tcounter] = tri[i].vertex[2] - imesh[m].first_vertex;
+            }
+            else
+            {
+                model.meshes[m].indices[tcounter + 2] = tri[i].vertex[0] - imesh[m].first_vertex;
+                model.meshes[m].indices[tcounter + 1] = tri[i].vertex[1] - imesh[m].first_vertex;
+                model.meshes[m].indices[tcounter] = tri[i].vertex[2] - imesh[m].first_vertex;
+            }
             tcounter += 3;
         }
     }
@@ -5004,7 +6666,7 @@ static ModelAnimation *LoadModelAnimationsIQM(const char *fileName, int *animCou
     //fread(anim, sizeof(IQMAnim), iqmHeader->num_anims, iqmFile);
     memcpy(anim, fileDataPtr + iqmHeader->ofs_anims, iqmHeader->num_anims*sizeof(IQMAnim));
 
-    ModelAnimation *animations = (ModelAnimation *)RL_MALLOC(iqmHeader->num_anims*sizeof(ModelAnimation));
+    ModelAnimation *animations = (ModelAnimation *)RL_CALLOC(iqmHeader->num_anims, sizeof(ModelAnimation));
 
     // frameposes
     unsigned short *framedata = (unsigned short *)RL_MALLOC(iqmHeader->num_frames*iqmHeader->num_framechannels*sizeof(unsigned short));
@@ -5024,7 +6686,7 @@ static ModelAnimation *LoadModelAnimationsIQM(const char *fileName, int *animCou
         animations[a].framePoses = (Transform **)RL_MALLOC(anim[a].num_frames*sizeof(Transform *));
         memcpy(animations[a].name, fileDataPtr + iqmHeader->ofs_text + anim[a].name, 32);   //  I don't like this 32 here
         TRACELOG(LOG_INFO, "IQM Anim %s", animations[a].name);
-        // animations[a].framerate = anim.framerate;     // TODO: Use animation framerate data?
+        animations[a].frameRate = (anim[a].framerate > 0.0f)? anim[a].framerate : 60.0f;
 
         for (unsigned int j = 0; j < iqmHeader->num_poses; j++)
         {
@@ -5158,10 +6820,46 @@ static ModelAnimation *LoadModelAnimationsIQM(const char *fileName, int *animCou
 
 #if defined(SUPPORT_FILEFORMAT_GLTF)
 // Load file data callback for cgltf
+// NOTE: If file options provide a mapped files list, files are mapped in memory when possible
 static cgltf_result LoadFileGLTFCallback(const struct cgltf_memory_options *memoryOptions, const struct cgltf_file_options *fileOptions, const char *path, cgltf_size *size, void **data)
 {
-    int filesize;
-    unsigned char *filedata = LoadFileData(path, &filesize);
+    int filesize = 0;
+    unsigned char *filedata = NULL;
+
+#if defined(SUPPORT_GLTF_FILE_MAPPING)
+    GLTFMappedFiles *mappedFiles = (GLTFMappedFiles *)fileOptions->user_data;
+
+    if (mappedFiles != NULL)
+    {
+        filedata = LoadFileMapped(path, &filesize);
+
+        if (filedata != NULL)
+        {
+            // NOTE: Arrays grown one by one, a successfully grown array is kept even if the other fails
+            unsigned char **data = (unsigned char **)RL_REALLOC(mappedFiles->data, (mappedFiles->count + 1)*sizeof(unsigned char *));
+            if (data != NULL) mappedFiles->data = data;
+
+            int *dataSize = (data != NULL)? (int *)RL_REALLOC(mappedFiles->dataSize, (mappedFiles->count + 1)*sizeof(int)) : NULL;
+            if (dataSize != NULL) mappedFiles->dataSize = dataSize;
+
+            if ((data == NULL) || (dataSize == NULL))
+            {
+                // Mapped file can not be tracked for release, unmap it
+                UnloadFileMapped(filedata, filesize);
+                TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to allocate mapped files list", path);
+                return cgltf_result_out_of_memory;
+            }
+
+            mappedFiles->data[mappedFiles->count] = filedata;
+            mappedFiles->dataSize[mappedFiles->count] = filesize;
+            mappedFiles->count++;
+        }
+    }
+
+    if (filedata == NULL) filedata = LoadFileData(path, &filesize);
+#else
+    filedata = LoadFileData(path, &filesize);
+#endif
 
     if (filedata == NULL) return cgltf_result_io_error;
 
@@ -5174,6 +6872,36 @@ static cgltf_result LoadFileGLTFCallback(const struct cgltf_memory_options *memo
 // Release file data callback for cgltf
 static void ReleaseFileGLTFCallback(const struct cgltf_memory_options *memoryOptions, const struct cgltf_file_options *fileOptions, void *data)
 {
+#if defined(SUPPORT_GLTF_FILE_MAPPING)
+    GLTFMappedFiles *mappedFiles = (GLTFMappedFiles *)fileOptions->user_data;
+
+    if (mappedFiles != NULL)
+    {
+        for (int i = 0; i < mappedFiles->count; i++)
+        {
+            if (mappedFiles->data[i] == data)
+            {
+                UnloadFileMapped(mappedFiles->data[i], mappedFiles->dataSize[i]);
+
+                // Move last mapped file to released position
+                mappedFiles->count--;
+                mappedFiles->data[i] = mappedFiles->data[mappedFiles->count];
+                mappedFiles->dataSize[i] = mappedFiles->dataSize[mappedFiles->count];
+
+                if (mappedFiles->count == 0)
+                {
+                    RL_FREE(mappedFiles->data);
+                    RL_FREE(mappedFiles->dataSize);
+                    mappedFiles->data = NULL;
+                    mappedFiles->dataSize = NULL;
+                }
+
+                return;
+            }
+        }
+    }
+#endif
+
     UnloadFileData((unsigned char *)data);
 }
 
@@ -5319,7 +7047,15 @@ static Model LoadGLTF(const char *fileName)
     ***********************************************************************************************/
 
     // Macro to simplify attributes loading code
-    #define LOAD_ATTRIBUTE(accesor, numComp, srcType, dstPtr) LOAD_ATTRIBUTE_CAST(accesor, numComp, srcType, dstPtr, srcType)
+    // NOTE: Tightly packed accessors are copied at once, no conversion is required
+    #define LOAD_ATTRIBUTE(accesor, numComp, srcType, dstPtr) \
+    { \
+        if (accesor->stride == numComp*sizeof(srcType)) \
+        { \
+            memcpy(dstPtr, (unsigned char *)accesor->buffer_view->buffer->data + accesor->buffer_view->offset + accesor->offset, accesor->count*numComp*sizeof(srcType)); \
+        } \
+        else LOAD_ATTRIBUTE_CAST(accesor, numComp, srcType, dstPtr, srcType) \
+    }
 
     #define LOAD_ATTRIBUTE_CAST(accesor, numComp, srcType, dstPtr, dstType) \
     { \
@@ -5337,16 +7073,22 @@ static Model LoadGLTF(const char *fileName)
 
     Model model = { 0 };
 
+    cgltf_options options = { 0 };
+    options.file.read = LoadFileGLTFCallback;
+    options.file.release = ReleaseFileGLTFCallback;
+#if defined(SUPPORT_GLTF_FILE_MAPPING)
+    // NOTE: Files mapped in memory, glb binary chunk is read directly from mapped file
+    GLTFMappedFiles mappedFiles = { 0 };
+    options.file.user_data = &mappedFiles;
+#endif
+
     // glTF file loading
-    int dataSize = 0;
-    unsigned char *fileData = LoadFileData(fileName, &dataSize);
+    cgltf_size dataSize = 0;
+    void *fileData = NULL;
 
-    if (fileData == NULL) return model;
+    if (LoadFileGLTFCallback(&options.memory, &options.file, fileName, &dataSize, &fileData) != cgltf_result_success) return model;
 
     // glTF data loading
-    cgltf_options options = { 0 };
-    options.file.read = LoadFileGLTFCallback;
-    options.file.release = ReleaseFileGLTFCallback;
     cgltf_data *data = NULL;
     cgltf_result result = cgltf_parse(&options, fileData, dataSize, &data);
 
@@ -5826,7 +7568,7 @@ static Model LoadGLTF(const char *fileName)
 
                     model.meshes[meshIndex].triangleCount = (int)attribute->count/3;
 
-                    if (model.meshes[meshIndex].indices != NULL) TRACELOG(LOG_WARNING, "MODEL: [%s] Indices attribute data already loaded", fileName);
+                    if ((model.meshes[meshIndex].indices != NULL) || (model.meshes[meshIndex].indices32 != NULL)) TRACELOG(LOG_WARNING, "MODEL: [%s] Indices attribute data already loaded", fileName);
                     else
                     {
                         if (attribute->component_type == cgltf_component_type_r_16u)
@@ -5846,11 +7588,21 @@ static Model LoadGLTF(const char *fileName)
                         }
                         else if (attribute->component_type == cgltf_component_type_r_32u)
                         {
-                            // Init raylib mesh indices to copy glTF attribute data
-                            model.meshes[meshIndex].indices = (unsigned short *)RL_MALLOC(attribute->count*sizeof(unsigned short));
-                            LOAD_ATTRIBUTE_CAST(attribute, 1, unsigned int, model.meshes[meshIndex].indices, unsigned short);
+                            if (model.meshes[meshIndex].vertexCount > 65536)
+                            {
+                                // Init raylib mesh 32-bit indices to copy glTF attribute data
+                                model.meshes[meshIndex].indices32 = (unsigned int *)RL_MALLOC(attribute->count*sizeof(unsigned int));
 
-                            TRACELOG(LOG_WARNING, "MODEL: [%s] Indices data converted from u32 to u16, possible loss of data", fileName);
+                                // Load unsigned int data type into mesh.indices32
+                                LOAD_ATTRIBUTE(attribute, 1, unsigned int, model.meshes[meshIndex].indices32)
+                            }
+                            else
+                            {
+                                // Init raylib mesh indices to copy glTF attribute data
+                                // NOTE: Vertex indices fit in 16-bit, no data loss
+                                model.meshes[meshIndex].indices = (unsigned short *)RL_MALLOC(attribute->count*sizeof(unsigned short));
+                                LOAD_ATTRIBUTE_CAST(attribute, 1, unsigned int, model.meshes[meshIndex].indices, unsigned short);
+                            }
                         }
                         else TRACELOG(LOG_WARNING, "MODEL: [%s] Indices data format not supported, use u16", fileName);
                     }
@@ -6086,7 +7838,7 @@ static Model LoadGLTF(const char *fileName)
     else TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to load glTF data", fileName);
 
     // WARNING: cgltf requires the file pointer available while reading data
-    UnloadFileData(fileData);
+    ReleaseFileGLTFCallback(&options.memory, &options.file, fileData);
 
     return model;
 }
@@ -6228,25 +7980,96 @@ static bool GetPoseAtTimeGLTF(cgltf_interpolation_type interpolationType, cgltf_
 
 #define GLTF_ANIMDELAY 17    // Animation frames delay, (~1000 ms/60 FPS = 16.666666* ms)
 
-static ModelAnimation *LoadModelAnimationsGLTF(const char *fileName, int *animCount)
+// Load animation curve from glTF animation channel, constant default value curve if no channel provided
+// NOTE: Cubic spline channels are resampled to linear keyframes every GLTF_ANIMDELAY
+static AnimationCurve LoadAnimationCurveGLTF(cgltf_animation_channel *channel, int components, const float *defaultValue)
 {
-    // glTF file loading
-    int dataSize = 0;
-    unsigned char *fileData = LoadFileData(fileName, &dataSize);
+    AnimationCurve curve = { 0 };
+    int keyCount = 0;
+    int interpolation = ANIMATION_CURVE_LINEAR;
+    float *times = NULL;
+    float *values = NULL;
+
+    if ((channel != NULL) && (channel->sampler->input->count > 0))
+    {
+        cgltf_animation_sampler *sampler = channel->sampler;
+
+        if (sampler->interpolation == cgltf_interpolation_type_cubic_spline)
+        {
+            float start = 0.0f;
+            float end = 0.0f;
+            cgltf_accessor_read_float(sampler->input, 0, &start, 1);
+            cgltf_accessor_read_float(sampler->input, sampler->input->count - 1, &end, 1);
+
+            keyCount = (int)((end - start)*1000.0f/GLTF_ANIMDELAY) + 2;
+            times = (float *)RL_MALLOC(keyCount*sizeof(float));
+            values = (float *)RL_MALLOC(keyCount*components*sizeof(float));
+
+            for (int i = 0; i < keyCount; i++)
+            {
+                times[i] = (i < (keyCount - 1))? start + (float)i*GLTF_ANIMDELAY/1000.0f : end;
+
+                // Value initialized to first keyframe, kept if curve has no duration
+                cgltf_accessor_read_float(sampler->output, 1, &values[components*i], components);
+                GetPoseAtTimeGLTF(sampler->interpolation, sampler->input, sampler->output, times[i], &values[components*i]);
+            }
+        }
+        else
+        {
+            if (sampler->interpolation == cgltf_interpolation_type_step) interpolation = ANIMATION_CURVE_STEP;
+
+            keyCount = (int)sampler->input->count;
+            times = (float *)RL_MALLOC(keyCount*sizeof(float));
+            values = (float *)RL_MALLOC(keyCount*components*sizeof(float));
+
+            for (int i = 0; i < keyCount; i++)
+            {
+                cgltf_accessor_read_float(sampler->input, i, &times[i], 1);
+                cgltf_accessor_read_float(sampler->output, i, &values[components*i], components);
+            }
+        }
+    }
+
+    if (keyCount > 0) curve = LoadAnimationCurve(times, values, keyCount, components, interpolation);
+    else
+    {
+        float time = 0.0f;
+        curve = LoadAnimationCurve(&time, defaultValue, 1, components, interpolation);
+    }
 
+    RL_FREE(times);
+    RL_FREE(values);
+
+    return curve;
+}
+
+static ModelAnimation *LoadModelAnimationsGLTF(const char *fileName, int *animCount)
+{
     ModelAnimation *animations = NULL;
 
-    // glTF data loading
     cgltf_options options = { 0 };
     options.file.read = LoadFileGLTFCallback;
     options.file.release = ReleaseFileGLTFCallback;
+#if defined(SUPPORT_GLTF_FILE_MAPPING)
+    GLTFMappedFiles mappedFiles = { 0 };
+    options.file.user_data = &mappedFiles;
+#endif
+
+    // glTF file loading
+    cgltf_size dataSize = 0;
+    void *fileData = NULL;
+
+    *animCount = 0;
+    if (LoadFileGLTFCallback(&options.memory, &options.file, fileName, &dataSize, &fileData) != cgltf_result_success) return NULL;
+
+    // glTF data loading
     cgltf_data *data = NULL;
     cgltf_result result = cgltf_parse(&options, fileData, dataSize, &data);
 
     if (result != cgltf_result_success)
     {
         TRACELOG(LOG_WARNING, "MODEL: [%s] Failed to load glTF data", fileName);
-        *animCount = 0;
+        ReleaseFileGLTFCallback(&options.memory, &options.file, fileData);
         return NULL;
     }
 
@@ -6283,7 +8106,6 @@ static ModelAnimation *LoadModelAnimationsGLTF(const char *fileName, int *animCo
                     cgltf_animation_channel *translate;
                     cgltf_animation_channel *rotate;
                     cgltf_animation_channel *scale;
-                    cgltf_interpolation_type interpolationType;
                 };
 
                 struct Channels *boneChannels = (struct Channels *)RL_CALLOC(animations[i].boneCount, sizeof(struct Channels));
@@ -6309,8 +8131,6 @@ static ModelAnimation *LoadModelAnimationsGLTF(const char *fileName, int *animCo
                         continue;
                     }
 
-                    boneChannels[boneIndex].interpolationType = animData.channels[j].sampler->interpolation;
-
                     if (animData.channels[j].sampler->interpolation != cgltf_interpolation_type_max_enum)
                     {
                         if (channel.target_path == cgltf_animation_path_type_translation)
@@ -6347,61 +8167,44 @@ static ModelAnimation *LoadModelAnimationsGLTF(const char *fileName, int *animCo
                 if (animData.name != NULL) strncpy(animations[i].name, animData.name, sizeof(animations[i].name) - 1);
 
                 animations[i].frameCount = (int)(animDuration*1000.0f/GLTF_ANIMDELAY) + 1;
-                animations[i].framePoses = (Transform **)RL_MALLOC(animations[i].frameCount*sizeof(Transform *));
+                animations[i].frameRate = 1000.0f/GLTF_ANIMDELAY;
 
-                for (int j = 0; j < animations[i].frameCount; j++)
-                {
-                    animations[i].framePoses[j] = (Transform *)RL_MALLOC(animations[i].boneCount*sizeof(Transform));
-                    float time = ((float) j*GLTF_ANIMDELAY)/1000.0f;
+                // Animation keyframes kept by bone, poses sampled on demand
+                animations[i].curves = (rAnimationCurves *)RL_MALLOC(sizeof(rAnimationCurves));
+                animations[i].curves->duration = animDuration;
+                animations[i].curves->root = worldTransform;
+                animations[i].curves->curves = (AnimationCurve *)RL_CALLOC(animations[i].boneCount*3, sizeof(AnimationCurve));
 
-                    for (int k = 0; k < animations[i].boneCount; k++)
-                    {
-                        Vector3 translation = {skin.joints[k]->translation[0], skin.joints[k]->translation[1], skin.joints[k]->translation[2]};
-                        Quaternion rotation = {skin.joints[k]->rotation[0], skin.joints[k]->rotation[1], skin.joints[k]->rotation[2], skin.joints[k]->rotation[3]};
-                        Vector3 scale = {skin.joints[k]->scale[0], skin.joints[k]->scale[1], skin.joints[k]->scale[2]};
+                int keyCount = 0;
 
-                        if (boneChannels[k].translate)
-                        {
-                            if (!GetPoseAtTimeGLTF(boneChannels[k].interpolationType, boneChannels[k].translate->sampler->input, boneChannels[k].translate->sampler->output, time, &translation))
-                            {
-                                TRACELOG(LOG_INFO, "MODEL: [%s] Failed to load translate pose data for bone %s", fileName, animations[i].bones[k].name);
-                            }
-                        }
+                for (int k = 0; k < animations[i].boneCount; k++)
+                {
+                    AnimationCurve *curves = &animations[i].curves->curves[3*k];
 
-                        if (boneChannels[k].rotate)
-                        {
-                            if (!GetPoseAtTimeGLTF(boneChannels[k].interpolationType, boneChannels[k].rotate->sampler->input, boneChannels[k].rotate->sampler->output, time, &rotation))
-                            {
-                                TRACELOG(LOG_INFO, "MODEL: [%s] Failed to load rotate pose data for bone %s", fileName, animations[i].bones[k].name);
-                            }
-                        }
+                    curves[0] = LoadAnimationCurveGLTF(boneChannels[k].translate, 3, skin.joints[k]->translation);
+                    curves[1] = LoadAnimationCurveGLTF(boneChannels[k].rotate, 4, skin.joints[k]->rotation);
+                    curves[2] = LoadAnimationCurveGLTF(boneChannels[k].scale, 3, skin.joints[k]->scale);
 
-                        if (boneChannels[k].scale)
-                        {
-                            if (!GetPoseAtTimeGLTF(boneChannels[k].interpolationType, boneChannels[k].scale->sampler->input, boneChannels[k].scale->sampler->output, time, &scale))
-                            {
-                                TRACELOG(LOG_INFO, "MODEL: [%s] Failed to load scale pose data for bone %s", fileName, animations[i].bones[k].name);
-                            }
-                        }
+                    keyCount += curves[0].keyCount + curves[1].keyCount + curves[2].keyCount;
+                }
 
-                        animations[i].framePoses[j][k] = (Transform){
-                            .translation = translation,
-                            .rotation = rotation,
-                            .scale = scale
-                        };
-                    }
+#if defined(SUPPORT_GLTF_BAKED_POSES)
+                // Bake model space poses by frame, required by code reading anim.framePoses[frame]
+                // NOTE: Last frame time is clamped to animation duration instead of wrapped
+                animations[i].framePoses = (Transform **)RL_MALLOC(animations[i].frameCount*sizeof(Transform *));
+
+                for (int j = 0; j < animations[i].frameCount; j++)
+                {
+                    float time = fminf((j*GLTF_ANIMDELAY)/1000.0f, animDuration);
 
-                    Transform* root = &animations[i].framePoses[j][0];
-                    root->rotation = QuaternionMultiply(worldTransform.rotation, root->rotation);
-                    root->scale = Vector3Multiply(root->scale, worldTransform.scale);
-                    root->translation = Vector3Multiply(root->translation, worldTransform.scale);
-                    root->translation = Vector3RotateByQuaternion(root->translation, worldTransform.rotation);
-                    root->translation = Vector3Add(root->translation, worldTransform.translation);
+                    animations[i].framePoses[j] = (Transform *)RL_MALLOC(animations[i].boneCount*sizeof(Transform));
+                    for (int k = 0; k < animations[i].boneCount; k++) animations[i].framePoses[j][k] = GetAnimationBoneTransform(animations[i], time, k);
 
                     BuildPoseFromParentJoints(animations[i].bones, animations[i].boneCount, animations[i].framePoses[j]);
                 }
+#endif
 
-                TRACELOG(LOG_INFO, "MODEL: [%s] Loaded animation: %s (%d frames, %fs)", fileName, (animData.name != NULL)? animData.name : "NULL", animations[i].frameCount, animDuration);
+                TRACELOG(LOG_INFO, "MODEL: [%s] Loaded animation: %s (%d frames, %d keyframes, %fs)", fileName, (animData.name != NULL)? animData.name : "NULL", animations[i].frameCount, keyCount, animDuration);
                 RL_FREE(boneChannels);
             }
         }
@@ -6413,7 +8216,7 @@ static ModelAnimation *LoadModelAnimationsGLTF(const char *fileName, int *animCo
 
         cgltf_free(data);
     }
-    UnloadFileData(fileData);
+    ReleaseFileGLTFCallback(&options.memory, &options.file, fileData);
     return animations;
 }
 #endif
@@ -6929,6 +8732,7 @@ static ModelAnimation *LoadModelAnimationsM3D(const char *fileName, int *animCou
         for (unsigned int a = 0; a < m3d->numaction; a++)
         {
             animations[a].frameCount = m3d->action[a].durationmsec/M3D_ANIMDELAY;
+            animations[a].frameRate = 1000.0f/M3D_ANIMDELAY;
             animations[a].boneCount = m3d->numbone + 1;
             animations[a].bones = (BoneInfo *)RL_MALLOC((m3d->numbone + 1)*sizeof(BoneInfo));
             animations[a].framePoses = (Transform **)RL_MALLOC(animations[a].frameCount*sizeof(Transform *));
@@ -7000,4 +8804,148 @@ static ModelAnimation *LoadModelAnimationsM3D(const char *fileName, int *animCou
 }
 #endif
 
+
+// Skin mesh vertex range positions and normals (CPU skinning)
+// NOTE: Weighted bone matrices are blended per vertex, then position and normal are transformed once,
+// vertex without bone weights result in zero position and normal
+static void SkinMeshVertices(SkinningJob *job)
+{
+    const Mesh *mesh = &job->mesh;
+    bool normals = ((mesh->normals != NULL) && (mesh->animNormals != NULL));
+
+    for (int v = job->first; v < job->last; v++)
+    {
+        const float *position = &mesh->vertices[3*v];
+        const float *normal = normals? &mesh->normals[3*v] : NULL;
+        float *animPosition = &mesh->animVertices[3*v];
+        float *animNormal = normals? &mesh->animNormals[3*v] : NULL;
+
+#if defined(MODELS_SIMD_SSE2)
+        __m128 t0 = _mm_setzero_ps(), t1 = _mm_setzero_ps(), t2 = _mm_setzero_ps(), t3 = _mm_setzero_ps();
+        __m128 n0 = _mm_setzero_ps(), n1 = _mm_setzero_ps(), n2 = _mm_setzero_ps();
+
+        // Iterates over 4 bones per vertex
+        for (int j = 0; j < 4; j++)
+        {
+            float weight = mesh->boneWeights[4*v + j];
+            if (weight == 0.0f) continue;   // Early stop when no transformation will be applied
+
+            const SkinningBone *bone = &job->bones[mesh->boneIds[4*v + j]];
+            __m128 w = _mm_set1_ps(weight);
+
+            t0 = _mm_add_ps(t0, _mm_mul_ps(w, _mm_loadu_ps(bone->transform)));
+            t1 = _mm_add_ps(t1, _mm_mul_ps(w, _mm_loadu_ps(bone->transform + 4)));
+            t2 = _mm_add_ps(t2, _mm_mul_ps(w, _mm_loadu_ps(bone->transform + 8)));
+            t3 = _mm_add_ps(t3, _mm_mul_ps(w, _mm_loadu_ps(bone->transform + 12)));
+
+            if (normals)
+            {
+                n0 = _mm_add_ps(n0, _mm_mul_ps(w, _mm_loadu_ps(bone->normal)));
+                n1 = _mm_add_ps(n1, _mm_mul_ps(w, _mm_loadu_ps(bone->normal + 4)));
+                n2 = _mm_add_ps(n2, _mm_mul_ps(w, _mm_loadu_ps(bone->normal + 8)));
+            }
+
+            job->updated = true;
+        }
+
+        // NOTE: Only 3 components stored, next vertex could belong to another job
+        __m128 p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(t0, _mm_set1_ps(position[0])), _mm_mul_ps(t1, _mm_set1_ps(position[1]))),
+                              _mm_add_ps(_mm_mul_ps(t2, _mm_set1_ps(position[2])), t3));
+        _mm_storel_pi((__m64 *)animPosition, p);
+        _mm_store_ss(animPosition + 2, _mm_movehl_ps(p, p));
+
+        if (normals)
+        {
+            __m128 n = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n0, _mm_set1_ps(normal[0])), _mm_mul_ps(n1, _mm_set1_ps(normal[1]))),
+                                  _mm_mul_ps(n2, _mm_set1_ps(normal[2])));
+            _mm_storel_pi((__m64 *)animNormal, n);
+            _mm_store_ss(animNormal + 2, _mm_movehl_ps(n, n));
+        }
+#elif defined(MODELS_SIMD_NEON)
+        float32x4_t t0 = vdupq_n_f32(0.0f), t1 = vdupq_n_f32(0.0f), t2 = vdupq_n_f32(0.0f), t3 = vdupq_n_f32(0.0f);
+        float32x4_t n0 = vdupq_n_f32(0.0f), n1 = vdupq_n_f32(0.0f), n2 = vdupq_n_f32(0.0f);
+
+        // Iterates over 4 bones per vertex
+        for (int j = 0; j < 4; j++)
+        {
+            float weight = mesh->boneWeights[4*v + j];
+            if (weight == 0.0f) continue;   // Early stop when no transformation will be applied
+
+            const SkinningBone *bone = &job->bones[mesh->boneIds[4*v + j]];
+
+            t0 = vmlaq_n_f32(t0, vld1q_f32(bone->transform), weight);
+            t1 = vmlaq_n_f32(t1, vld1q_f32(bone->transform + 4), weight);
+            t2 = vmlaq_n_f32(t2, vld1q_f32(bone->transform + 8), weight);
+            t3 = vmlaq_n_f32(t3, vld1q_f32(bone->transform + 12), weight);
+
+            if (normals)
+            {
+                n0 = vmlaq_n_f32(n0, vld1q_f32(bone->normal), weight);
+                n1 = vmlaq_n_f32(n1, vld1q_f32(bone->normal + 4), weight);
+                n2 = vmlaq_n_f32(n2, vld1q_f32(bone->normal + 8), weight);
+            }
+
+            job->updated = true;
+        }
+
+        // NOTE: Only 3 components stored, next vertex could belong to another job
+        float32x4_t p = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(t3, t0, position[0]), t1, position[1]), t2, position[2]);
+        vst1_f32(animPosition, vget_low_f32(p));
+        vst1q_lane_f32(animPosition + 2, p, 2);
+
+        if (normals)
+        {
+            float32x4_t n = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(n0, normal[0]), n1, normal[1]), n2, normal[2]);
+            vst1_f32(animNormal, vget_low_f32(n));
+            vst1q_lane_f32(animNormal + 2, n, 2);
+        }
+#else
+        float t[16] = { 0 };
+        float n[12] = { 0 };
+
+        // Iterates over 4 bones per vertex
+        for (int j = 0; j < 4; j++)
+        {
+            float weight = mesh->boneWeights[4*v + j];
+            if (weight == 0.0f) continue;   // Early stop when no transformation will be applied
+
+            const SkinningBone *bone = &job->bones[mesh->boneIds[4*v + j]];
+
+            for (int k = 0; k < 16; k++) t[k] += weight*bone->transform[k];
+            if (normals) for (int k = 0; k < 12; k++) n[k] += weight*bone->normal[k];
+
+            job->updated = true;
+        }
+
+        animPosition[0] = t[0]*position[0] + t[4]*position[1] + t[8]*position[2] + t[12];
+        animPosition[1] = t[1]*position[0] + t[5]*position[1] + t[9]*position[2] + t[13];
+        animPosition[2] = t[2]*position[0] + t[6]*position[1] + t[10]*position[2] + t[14];
+
+        if (normals)
+        {
+            animNormal[0] = n[0]*normal[0] + n[4]*normal[1] + n[8]*normal[2];
+            animNormal[1] = n[1]*normal[0] + n[5]*normal[1] + n[9]*normal[2];
+            animNormal[2] = n[2]*normal[0] + n[6]*normal[1] + n[10]*normal[2];
+        }
+#endif
+    }
+}
+
+#if defined(SUPPORT_THREADED_SKINNING)
+// Skin mesh vertex range, thread entry point
+#if defined(_WIN32)
+static unsigned int __stdcall SkinMeshVerticesThread(void *job)
+{
+    SkinMeshVertices((SkinningJob *)job);
+    return 0;
+}
+#else
+static void *SkinMeshVerticesThread(void *job)
+{
+    SkinMeshVertices((SkinningJob *)job);
+    return NULL;
+}
+#endif
+#endif
+
 #endif      // SUPPORT_MODULE_RMODELS
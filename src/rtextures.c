@@ -34,10 +34,15 @@
 *       #define SUPPORT_IMAGE_GENERATION
 *           Support procedural image generation functionality (gradient, spot, perlin-noise, cellular)
 *
+*       #define SUPPORT_TEXTURE_ATLAS
+*           Support automatic packing of small textures into shared atlas pages [EnableTextureAtlas()],
+*           textures drawn from the same page do not break the render batch
+*
 *   DEPENDENCIES:
 *       stb_image        - Multiple image formats loading (JPEG, PNG, BMP, TGA, PSD, GIF, PIC)
 *                          NOTE: stb_image has been slightly modified to support Android platform
 *       stb_image_resize - Multiple image resize algorithms
+*       stb_rect_pack    - Rectangles packing, required for texture atlas pages
 *
 *
 *   LICENSE: zlib/libpng
@@ -213,6 +218,22 @@
     #include "external/stb_perlin.h"        // Required for: stb_perlin_fbm_noise3
 #endif
 
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    #if defined(__GNUC__) // GCC and Clang
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wunused-function"
+    #endif
+
+    // NOTE: Static implementation, rtext module could also include it for fonts packing
+    #define STBRP_STATIC
+    #define STB_RECT_PACK_IMPLEMENTATION
+    #include "external/stb_rect_pack.h"     // Required for: stbrp_init_target(), stbrp_pack_rects()
+
+    #if defined(__GNUC__) // GCC and Clang
+        #pragma GCC diagnostic pop
+    #endif
+#endif
+
 #define STBIR_MALLOC(size,c) ((void)(c), RL_MALLOC(size))
 #define STBIR_FREE(ptr,c) ((void)(c), RL_FREE(ptr))
 
@@ -242,15 +263,54 @@
     #define GAUSSIAN_BLUR_ITERATIONS  4    // Number of box blur iterations to approximate gaussian blur
 #endif
 
+#ifndef TEXTURE_BATCH_QUADS
+    #define TEXTURE_BATCH_QUADS     256    // Number of quads generated per rlPushQuads() call on DrawTextureBatch()
+#endif
+
+#ifndef MAX_TEXTURE_ATLAS_PAGES
+    #define MAX_TEXTURE_ATLAS_PAGES   8    // Maximum number of texture atlas pages [EnableTextureAtlas()]
+#endif
+#ifndef TEXTURE_ATLAS_PADDING
+    #define TEXTURE_ATLAS_PADDING     1    // Border pixels replicated around packed textures, avoids sampling neighbours
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+#if defined(SUPPORT_TEXTURE_ATLAS)
+// Texture atlas page, small textures are packed together into one page texture
+typedef struct TextureAtlasPage {
+    unsigned int id;                // Page texture id (GPU)
+    int textureCount;               // Number of textures packed into the page
+    stbrp_context packer;           // Rectangles packing context
+    stbrp_node *nodes;              // Rectangles packing nodes, one per page pixel column
+} TextureAtlasPage;
+
+// Texture atlas location of a packed texture
+typedef struct TextureAtlasEntry {
+    int page;                       // Page index + 1, 0 if texture is not packed
+    int offsetX;                    // Texture position X in page
+    int offsetY;                    // Texture position Y in page
+} TextureAtlasEntry;
+
+// Texture atlas manager
+typedef struct TextureAtlas {
+    bool enabled;                   // Pack textures on LoadTextureFromImage()
+    int pageSize;                   // Page texture width and height
+    int maxTextureSize;             // Maximum texture width/height to be packed
+    int pageCount;                  // Number of pages loaded
+    TextureAtlasPage pages[MAX_TEXTURE_ATLAS_PAGES]; // Pages loaded
+    TextureAtlasEntry *entries;     // Packed textures locations, indexed by texture id
+    int entryCount;                 // Number of entries allocated
+} TextureAtlas;
+#endif
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
-// It's lonely here...
+#if defined(SUPPORT_TEXTURE_ATLAS)
+static TextureAtlas textureAtlas = { 0 };   // Texture atlas manager state
+#endif
 
 //----------------------------------------------------------------------------------
 // Other Modules Functions Declaration (required by text)
@@ -263,6 +323,14 @@ extern void LoadFontDefault(void);          // [Module: text] Loads default font
 static float HalfToFloat(unsigned short x);
 static unsigned short FloatToHalf(float x);
 static Vector4 *LoadImageDataNormalized(Image image);       // Load pixel data from image as Vector4 array (float normalized)
+static void SetTextureQuad(rlQuad *quad, Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float sinRotation, float cosRotation, Color tint); // Set quad vertex data for a part of a texture
+#if defined(SUPPORT_TEXTURE_ATLAS)
+static void AddTextureToAtlas(Texture2D texture, Image image);      // Pack texture into an atlas page, if it fits
+static void RemoveTextureFromAtlas(unsigned int id);                // Remove texture from atlas, drawn from its own texture afterwards
+static void UpdateTextureAtlas(Texture2D texture, const void *pixels); // Update packed texture data in atlas page
+static bool GetTextureAtlasPage(Texture2D texture, Texture2D *page, Vector2 *offset); // Get atlas page and offset of a packed texture
+static bool IsSourceInTexture(Texture2D texture, Rectangle source); // Check if source rectangle is contained in texture (no wrapping)
+#endif
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -4149,6 +4217,11 @@ Texture2D LoadTextureFromImage(Image image)
     texture.mipmaps = image.mipmaps;
     texture.format = image.format;
 
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    // Copy small textures into a shared atlas page, the texture keeps its own GPU copy
+    if (textureAtlas.enabled) AddTextureToAtlas(texture, image);
+#endif
+
     return texture;
 }
 
@@ -4321,6 +4394,9 @@ void UnloadTexture(Texture2D texture)
 {
     if (texture.id > 0)
     {
+#if defined(SUPPORT_TEXTURE_ATLAS)
+        RemoveTextureFromAtlas(texture.id);
+#endif
         rlUnloadTexture(texture.id);
 
         TRACELOG(LOG_INFO, "TEXTURE: [ID %i] Unloaded texture data from VRAM (GPU)", texture.id);
@@ -4347,6 +4423,9 @@ void UnloadRenderTexture(RenderTexture2D target)
         if (target.texture.id > 0)
         {
             // Color texture attached to FBO is deleted
+#if defined(SUPPORT_TEXTURE_ATLAS)
+            RemoveTextureFromAtlas(target.texture.id);
+#endif
             rlUnloadTexture(target.texture.id);
         }
 
@@ -4362,6 +4441,10 @@ void UnloadRenderTexture(RenderTexture2D target)
 void UpdateTexture(Texture2D texture, const void *pixels)
 {
     rlUpdateTexture(texture.id, 0, 0, texture.width, texture.height, texture.format, pixels);
+
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    UpdateTextureAtlas(texture, pixels);
+#endif
 }
 
 // Update GPU texture rectangle with new data
@@ -4370,6 +4453,10 @@ void UpdateTexture(Texture2D texture, const void *pixels)
 // NOTE 3: rec must fit completely within texture's width and height
 void UpdateTextureRec(Texture2D texture, Rectangle rec, const void *pixels)
 {
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    // Partially updated textures are drawn from their own texture
+    RemoveTextureFromAtlas(texture.id);
+#endif
     rlUpdateTexture(texture.id, (int)rec.x, (int)rec.y, (int)rec.width, (int)rec.height, texture.format, pixels);
 }
 
@@ -4381,12 +4468,20 @@ void GenTextureMipmaps(Texture2D *texture)
 {
     // NOTE: NPOT textures support check inside function
     // On WebGL (OpenGL ES 2.0) NPOT textures support is limited
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    RemoveTextureFromAtlas(texture->id);    // Atlas pages have no mipmaps
+#endif
     rlGenTextureMipmaps(texture->id, texture->width, texture->height, texture->format, &texture->mipmaps);
 }
 
 // Set texture scaling filter mode
 void SetTextureFilter(Texture2D texture, int filter)
 {
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    // Atlas pages use point filtering, filtered textures are drawn from their own texture
+    if (filter != TEXTURE_FILTER_POINT) RemoveTextureFromAtlas(texture.id);
+#endif
+
     switch (filter)
     {
         case TEXTURE_FILTER_POINT:
@@ -4480,6 +4575,52 @@ void SetTextureWrap(Texture2D texture, int wrap)
     }
 }
 
+// Enable automatic packing of small textures into shared atlas pages
+// NOTE: Only textures loaded afterwards with LoadTextureFromImage() are packed, they keep their
+// own GPU texture but DrawTexture*() functions draw them from the atlas page, avoiding batch breaks
+void EnableTextureAtlas(int pageSize, int maxTextureSize)
+{
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    if (textureAtlas.enabled) DisableTextureAtlas();
+
+    // NOTE: Software renderer can not allocate empty textures or update texture regions
+    if (rlGetVersion() == RL_OPENGL_11_SOFTWARE)
+    {
+        TRACELOG(LOG_WARNING, "TEXTURE: Texture atlas not supported by software renderer");
+        return;
+    }
+
+    if ((maxTextureSize > 0) && ((maxTextureSize + 2*TEXTURE_ATLAS_PADDING) <= pageSize))
+    {
+        textureAtlas.enabled = true;
+        textureAtlas.pageSize = pageSize;
+        textureAtlas.maxTextureSize = maxTextureSize;
+
+        TRACELOG(LOG_INFO, "TEXTURE: Texture atlas enabled (page size: %i, max texture size: %i)", pageSize, maxTextureSize);
+    }
+    else TRACELOG(LOG_WARNING, "TEXTURE: Texture atlas page size (%i) can not fit textures of size %i", pageSize, maxTextureSize);
+#else
+    TRACELOG(LOG_WARNING, "TEXTURE: Texture atlas not supported, SUPPORT_TEXTURE_ATLAS required");
+#endif
+}
+
+// Disable automatic texture atlas packing, atlas pages are unloaded
+// NOTE: Packed textures are still valid, they are drawn from their own texture afterwards
+void DisableTextureAtlas(void)
+{
+#if defined(SUPPORT_TEXTURE_ATLAS)
+    for (int i = 0; i < textureAtlas.pageCount; i++)
+    {
+        rlUnloadTexture(textureAtlas.pages[i].id);
+        RL_FREE(textureAtlas.pages[i].nodes);
+    }
+
+    RL_FREE(textureAtlas.entries);
+
+    textureAtlas = (TextureAtlas){ 0 };
+#endif
+}
+
 //------------------------------------------------------------------------------------
 // Texture drawing functions
 //------------------------------------------------------------------------------------
@@ -4521,82 +4662,32 @@ void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2
     // Check if texture is valid
     if (texture.id > 0)
     {
-        float width = (float)texture.width;
-        float height = (float)texture.height;
-
-        bool flipX = false;
-
-        if (source.width < 0) { flipX = true; source.width *= -1; }
-        if (source.height < 0) source.y -= source.height;
-
-        if (dest.width < 0) dest.width *= -1;
-        if (dest.height < 0) dest.height *= -1;
-
-        Vector2 topLeft = { 0 };
-        Vector2 topRight = { 0 };
-        Vector2 bottomLeft = { 0 };
-        Vector2 bottomRight = { 0 };
+        float sinRotation = 0.0f;
+        float cosRotation = 1.0f;
 
         // Only calculate rotation if needed
-        if (rotation == 0.0f)
-        {
-            float x = dest.x - origin.x;
-            float y = dest.y - origin.y;
-            topLeft = (Vector2){ x, y };
-            topRight = (Vector2){ x + dest.width, y };
-            bottomLeft = (Vector2){ x, y + dest.height };
-            bottomRight = (Vector2){ x + dest.width, y + dest.height };
-        }
-        else
+        if (rotation != 0.0f)
         {
-            float sinRotation = sinf(rotation*DEG2RAD);
-            float cosRotation = cosf(rotation*DEG2RAD);
-            float x = dest.x;
-            float y = dest.y;
-            float dx = -origin.x;
-            float dy = -origin.y;
-
-            topLeft.x = x + dx*cosRotation - dy*sinRotation;
-            topLeft.y = y + dx*sinRotation + dy*cosRotation;
-
-            topRight.x = x + (dx + dest.width)*cosRotation - dy*sinRotation;
-            topRight.y = y + (dx + dest.width)*sinRotation + dy*cosRotation;
-
-            bottomLeft.x = x + dx*cosRotation - (dy + dest.height)*sinRotation;
-            bottomLeft.y = y + dx*sinRotation + (dy + dest.height)*cosRotation;
-
-            bottomRight.x = x + (dx + dest.width)*cosRotation - (dy + dest.height)*sinRotation;
-            bottomRight.y = y + (dx + dest.width)*sinRotation + (dy + dest.height)*cosRotation;
+            sinRotation = sinf(rotation*DEG2RAD);
+            cosRotation = cosf(rotation*DEG2RAD);
         }
 
-        rlSetTexture(texture.id);
-        rlBegin(RL_QUADS);
-
-            rlColor4ub(tint.r, tint.g, tint.b, tint.a);
-            rlNormal3f(0.0f, 0.0f, 1.0f);                          // Normal vector pointing towards viewer
-
-            // Top-left corner for texture and quad
-            if (flipX) rlTexCoord2f((source.x + source.width)/width, source.y/height);
-            else rlTexCoord2f(source.x/width, source.y/height);
-            rlVertex2f(topLeft.x, topLeft.y);
+#if defined(SUPPORT_TEXTURE_ATLAS)
+        // Draw packed textures from their atlas page, consecutive draws share the page texture
+        Texture2D page = { 0 };
+        Vector2 offset = { 0 };
 
-            // Bottom-left corner for texture and quad
-            if (flipX) rlTexCoord2f((source.x + source.width)/width, (source.y + source.height)/height);
-            else rlTexCoord2f(source.x/width, (source.y + source.height)/height);
-            rlVertex2f(bottomLeft.x, bottomLeft.y);
-
-            // Bottom-right corner for texture and quad
-            if (flipX) rlTexCoord2f(source.x/width, (source.y + source.height)/height);
-            else rlTexCoord2f((source.x + source.width)/width, (source.y + source.height)/height);
-            rlVertex2f(bottomRight.x, bottomRight.y);
-
-            // Top-right corner for texture and quad
-            if (flipX) rlTexCoord2f(source.x/width, source.y/height);
-            else rlTexCoord2f((source.x + source.width)/width, source.y/height);
-            rlVertex2f(topRight.x, topRight.y);
+        if (GetTextureAtlasPage(texture, &page, &offset) && IsSourceInTexture(texture, source))
+        {
+            source.x += offset.x;
+            source.y += offset.y;
+            texture = page;
+        }
+#endif
 
-        rlEnd();
-        rlSetTexture(0);
+        rlQuad quad = { 0 };
+        SetTextureQuad(&quad, texture, source, dest, origin, sinRotation, cosRotation, tint);
+        rlPushQuads(&quad, 1, texture.id);
 
         // NOTE: Vertex position can be transformed using matrices
         // but the process is way more costly than just calculating
@@ -4640,6 +4731,60 @@ void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2
     }
 }
 
+// Draw multiple parts of a texture with shared 'pro' parameters, submitted in bulk
+// NOTE: Equivalent to calling DrawTexturePro() for every source/dest pair, useful for tilemaps and particles
+void DrawTextureBatch(Texture2D texture, const Rectangle *sources, const Rectangle *dests, int count, Vector2 origin, float rotation, Color tint)
+{
+    // Check if texture and rectangles are valid
+    if ((texture.id > 0) && (sources != NULL) && (dests != NULL) && (count > 0))
+    {
+        float sinRotation = 0.0f;
+        float cosRotation = 1.0f;
+
+        // Only calculate rotation if needed, once for all quads
+        if (rotation != 0.0f)
+        {
+            sinRotation = sinf(rotation*DEG2RAD);
+            cosRotation = cosf(rotation*DEG2RAD);
+        }
+
+        Texture2D quadTexture = texture;    // Texture quads are drawn from, atlas page if texture is packed
+        Vector2 offset = { 0 };
+
+#if defined(SUPPORT_TEXTURE_ATLAS)
+        // Draw from atlas page only if all sources are contained in texture, quads share a single texture
+        Texture2D page = { 0 };
+
+        if (GetTextureAtlasPage(texture, &page, &offset))
+        {
+            bool contained = true;
+            for (int i = 0; (i < count) && contained; i++) contained = IsSourceInTexture(texture, sources[i]);
+
+            if (contained) quadTexture = page;
+            else offset = (Vector2){ 0 };
+        }
+#endif
+
+        rlQuad quads[TEXTURE_BATCH_QUADS] = { 0 };
+
+        for (int i = 0; i < count; i += TEXTURE_BATCH_QUADS)
+        {
+            int quadCount = ((count - i) < TEXTURE_BATCH_QUADS)? (count - i) : TEXTURE_BATCH_QUADS;
+
+            for (int q = 0; q < quadCount; q++)
+            {
+                Rectangle source = sources[i + q];
+                source.x += offset.x;
+                source.y += offset.y;
+
+                SetTextureQuad(&quads[q], quadTexture, source, dests[i + q], origin, sinRotation, cosRotation, tint);
+            }
+
+            rlPushQuads(quads, quadCount, quadTexture.id);
+        }
+    }
+}
+
 // Draws a texture (or part of it) that stretches or shrinks nicely using n-patch info
 void DrawTextureNPatch(Texture2D texture, NPatchInfo nPatchInfo, Rectangle dest, Vector2 origin, float rotation, Color tint)
 {
@@ -5588,4 +5733,241 @@ static Vector4 *LoadImageDataNormalized(Image image)
     return pixels;
 }
 
+// Set quad vertex data for a part of a texture, same geometry as DrawTexturePro()
+// NOTE: No rotation is expected as sinRotation = 0.0f and cosRotation = 1.0f
+static void SetTextureQuad(rlQuad *quad, Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float sinRotation, float cosRotation, Color tint)
+{
+    float width = (float)texture.width;
+    float height = (float)texture.height;
+
+    bool flipX = false;
+
+    if (source.width < 0) { flipX = true; source.width *= -1; }
+    if (source.height < 0) source.y -= source.height;
+
+    if (dest.width < 0) dest.width *= -1;
+    if (dest.height < 0) dest.height *= -1;
+
+    Vector2 topLeft = { 0 };
+    Vector2 topRight = { 0 };
+    Vector2 bottomLeft = { 0 };
+    Vector2 bottomRight = { 0 };
+
+    // Only calculate rotation if needed
+    if ((sinRotation == 0.0f) && (cosRotation == 1.0f))
+    {
+        float x = dest.x - origin.x;
+        float y = dest.y - origin.y;
+        topLeft = (Vector2){ x, y };
+        topRight = (Vector2){ x + dest.width, y };
+        bottomLeft = (Vector2){ x, y + dest.height };
+        bottomRight = (Vector2){ x + dest.width, y + dest.height };
+    }
+    else
+    {
+        float x = dest.x;
+        float y = dest.y;
+        float dx = -origin.x;
+        float dy = -origin.y;
+
+        topLeft.x = x + dx*cosRotation - dy*sinRotation;
+        topLeft.y = y + dx*sinRotation + dy*cosRotation;
+
+        topRight.x = x + (dx + dest.width)*cosRotation - dy*sinRotation;
+        topRight.y = y + (dx + dest.width)*sinRotation + dy*cosRotation;
+
+        bottomLeft.x = x + dx*cosRotation - (dy + dest.height)*sinRotation;
+        bottomLeft.y = y + dx*sinRotation + (dy + dest.height)*cosRotation;
+
+        bottomRight.x = x + (dx + dest.width)*cosRotation - (dy + dest.height)*sinRotation;
+        bottomRight.y = y + (dx + dest.width)*sinRotation + (dy + dest.height)*cosRotation;
+    }
+
+    float left = source.x/width;
+    float right = (source.x + source.width)/width;
+    float top = source.y/height;
+    float bottom = (source.y + source.height)/height;
+
+    if (flipX) { float temp = left; left = right; right = temp; }
+
+    // Top-left corner for texture and quad
+    quad->positions[0] = topLeft.x;
+    quad->positions[1] = topLeft.y;
+    quad->texcoords[0] = left;
+    quad->texcoords[1] = top;
+
+    // Bottom-left corner for texture and quad
+    quad->positions[2] = bottomLeft.x;
+    quad->positions[3] = bottomLeft.y;
+    quad->texcoords[2] = left;
+    quad->texcoords[3] = bottom;
+
+    // Bottom-right corner for texture and quad
+    quad->positions[4] = bottomRight.x;
+    quad->positions[5] = bottomRight.y;
+    quad->texcoords[4] = right;
+    quad->texcoords[5] = bottom;
+
+    // Top-right corner for texture and quad
+    quad->positions[6] = topRight.x;
+    quad->positions[7] = topRight.y;
+    quad->texcoords[6] = right;
+    quad->texcoords[7] = top;
+
+    quad->color[0] = tint.r;
+    quad->color[1] = tint.g;
+    quad->color[2] = tint.b;
+    quad->color[3] = tint.a;
+}
+
+#if defined(SUPPORT_TEXTURE_ATLAS)
+// Pack texture into an atlas page, a new page is loaded if it does not fit into existing ones
+// NOTE: Only small textures without mipmaps and with 8-bit uncompressed formats are packed
+static void AddTextureToAtlas(Texture2D texture, Image image)
+{
+    if ((texture.id == 0) || (image.data == NULL) || (image.mipmaps > 1) ||
+        (image.format > PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) ||
+        (image.width > textureAtlas.maxTextureSize) || (image.height > textureAtlas.maxTextureSize)) return;
+
+    stbrp_rect rect = { 0 };
+    rect.w = image.width + 2*TEXTURE_ATLAS_PADDING;
+    rect.h = image.height + 2*TEXTURE_ATLAS_PADDING;
+
+    int pageIndex = 0;
+
+    for (; pageIndex < textureAtlas.pageCount; pageIndex++)
+    {
+        stbrp_pack_rects(&textureAtlas.pages[pageIndex].packer, &rect, 1);
+        if (rect.was_packed) break;
+    }
+
+    if (!rect.was_packed && (textureAtlas.pageCount < MAX_TEXTURE_ATLAS_PAGES))
+    {
+        TextureAtlasPage *page = &textureAtlas.pages[textureAtlas.pageCount];
+
+        page->id = rlLoadTexture(NULL, textureAtlas.pageSize, textureAtlas.pageSize, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+
+        if (page->id > 0)
+        {
+            page->nodes = (stbrp_node *)RL_MALLOC(textureAtlas.pageSize*sizeof(stbrp_node));
+            stbrp_init_target(&page->packer, textureAtlas.pageSize, textureAtlas.pageSize, page->nodes, textureAtlas.pageSize);
+            stbrp_pack_rects(&page->packer, &rect, 1);
+
+            pageIndex = textureAtlas.pageCount;
+            textureAtlas.pageCount++;
+
+            TRACELOG(LOG_INFO, "TEXTURE: [ID %i] Texture atlas page loaded successfully (%i x %i)", page->id, textureAtlas.pageSize, textureAtlas.pageSize);
+        }
+    }
+
+    if (!rect.was_packed) return;
+
+    // Entries are indexed by texture id, grow entries array if required
+    if ((int)texture.id >= textureAtlas.entryCount)
+    {
+        int entryCount = (textureAtlas.entryCount > 0)? textureAtlas.entryCount : 64;
+        while (entryCount <= (int)texture.id) entryCount *= 2;
+
+        TextureAtlasEntry *entries = (TextureAtlasEntry *)RL_REALLOC(textureAtlas.entries, entryCount*sizeof(TextureAtlasEntry));
+        if (entries == NULL) return;
+
+        for (int i = textureAtlas.entryCount; i < entryCount; i++) entries[i] = (TextureAtlasEntry){ 0 };
+
+        textureAtlas.entries = entries;
+        textureAtlas.entryCount = entryCount;
+    }
+
+    textureAtlas.entries[texture.id].page = pageIndex + 1;
+    textureAtlas.entries[texture.id].offsetX = rect.x + TEXTURE_ATLAS_PADDING;
+    textureAtlas.entries[texture.id].offsetY = rect.y + TEXTURE_ATLAS_PADDING;
+    textureAtlas.pages[pageIndex].textureCount++;
+
+    UpdateTextureAtlas(texture, image.data);
+}
+
+// Remove texture from atlas, page space is reclaimed once all its textures are removed
+static void RemoveTextureFromAtlas(unsigned int id)
+{
+    if (((int)id >= textureAtlas.entryCount) || (textureAtlas.entries[id].page == 0)) return;
+
+    TextureAtlasPage *page = &textureAtlas.pages[textureAtlas.entries[id].page - 1];
+
+    page->textureCount--;
+    if (page->textureCount == 0) stbrp_init_target(&page->packer, textureAtlas.pageSize, textureAtlas.pageSize, page->nodes, textureAtlas.pageSize);
+
+    textureAtlas.entries[id] = (TextureAtlasEntry){ 0 };
+}
+
+// Update packed texture data in atlas page, border pixels replicated into padding
+// NOTE: pixels data must match texture.format
+static void UpdateTextureAtlas(Texture2D texture, const void *pixels)
+{
+    if (((int)texture.id >= textureAtlas.entryCount) || (textureAtlas.entries[texture.id].page == 0) || (pixels == NULL)) return;
+
+    TextureAtlasEntry entry = textureAtlas.entries[texture.id];
+    Image image = { (void *)pixels, texture.width, texture.height, 1, texture.format };
+
+    // Atlas pages are RGBA, 8-bit formats sample the same once converted
+    if (texture.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        image = ImageCopy(image);
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+
+    int width = image.width + 2*TEXTURE_ATLAS_PADDING;
+    int height = image.height + 2*TEXTURE_ATLAS_PADDING;
+    const Color *source = (const Color *)image.data;
+    Color *padded = (Color *)RL_MALLOC(width*height*sizeof(Color));
+
+    for (int y = 0; y < height; y++)
+    {
+        int sy = y - TEXTURE_ATLAS_PADDING;
+        if (sy < 0) sy = 0;
+        else if (sy >= image.height) sy = image.height - 1;
+
+        for (int x = 0; x < width; x++)
+        {
+            int sx = x - TEXTURE_ATLAS_PADDING;
+            if (sx < 0) sx = 0;
+            else if (sx >= image.width) sx = image.width - 1;
+
+            padded[y*width + x] = source[sy*image.width + sx];
+        }
+    }
+
+    rlUpdateTexture(textureAtlas.pages[entry.page - 1].id, entry.offsetX - TEXTURE_ATLAS_PADDING, entry.offsetY - TEXTURE_ATLAS_PADDING,
+        width, height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, padded);
+
+    RL_FREE(padded);
+    if (image.data != pixels) UnloadImage(image);
+}
+
+// Get atlas page texture and texture offset in page, if texture is packed
+static bool GetTextureAtlasPage(Texture2D texture, Texture2D *page, Vector2 *offset)
+{
+    if (((int)texture.id >= textureAtlas.entryCount) || (textureAtlas.entries[texture.id].page == 0)) return false;
+
+    TextureAtlasEntry entry = textureAtlas.entries[texture.id];
+
+    page->id = textureAtlas.pages[entry.page - 1].id;
+    page->width = textureAtlas.pageSize;
+    page->height = textureAtlas.pageSize;
+    page->mipmaps = 1;
+    page->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    offset->x = (float)entry.offsetX;
+    offset->y = (float)entry.offsetY;
+
+    return true;
+}
+
+// Check if source rectangle is contained in texture, same area as sampled by SetTextureQuad()
+// NOTE: Sources out of texture rely on texture wrap mode, they can not be drawn from atlas pages
+static bool IsSourceInTexture(Texture2D texture, Rectangle source)
+{
+    return ((source.x >= 0.0f) && (source.y >= 0.0f) &&
+        ((source.x + fabsf(source.width)) <= (float)texture.width) &&
+        ((source.y + fabsf(source.height)) <= (float)texture.height));
+}
+#endif
+
 #endif      // SUPPORT_MODULE_RTEXTURES
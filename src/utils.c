@@ -49,6 +49,29 @@
 #include <stdarg.h>                     // Required for: va_list, va_start(), va_end()
 #include <string.h>                     // Required for: strcpy(), strcat()
 
+// Platforms supporting read-only file mapping: LoadFileMapped()
+#if defined(SUPPORT_STANDARD_FILEIO) && !defined(PLATFORM_ANDROID) && !defined(PLATFORM_WEB)
+    #if defined(_WIN32)
+        #define UTILS_FILE_MAPPING_WIN32
+    #elif defined(__unix__) || defined(__APPLE__)
+        #define UTILS_FILE_MAPPING_POSIX
+        #include <fcntl.h>              // Required for: open()
+        #include <unistd.h>             // Required for: close()
+        #include <sys/mman.h>           // Required for: mmap(), munmap()
+        #include <sys/stat.h>           // Required for: fstat()
+    #endif
+#endif
+
+#if defined(UTILS_FILE_MAPPING_WIN32)
+// Functions required to map files, avoid including windows.h (conflicts with raylib names)
+__declspec(dllimport) void *__stdcall CreateFileA(const char *lpFileName, unsigned long dwDesiredAccess, unsigned long dwShareMode, void *lpSecurityAttributes, unsigned long dwCreationDisposition, unsigned long dwFlagsAndAttributes, void *hTemplateFile);
+__declspec(dllimport) int __stdcall GetFileSizeEx(void *hFile, long long *lpFileSize);
+__declspec(dllimport) void *__stdcall CreateFileMappingA(void *hFile, void *lpFileMappingAttributes, unsigned long flProtect, unsigned long dwMaximumSizeHigh, unsigned long dwMaximumSizeLow, const char *lpName);
+__declspec(dllimport) void *__stdcall MapViewOfFile(void *hFileMappingObject, unsigned long dwDesiredAccess, unsigned long dwFileOffsetHigh, unsigned long dwFileOffsetLow, size_t dwNumberOfBytesToMap);
+__declspec(dllimport) int __stdcall UnmapViewOfFile(const void *lpBaseAddress);
+__declspec(dllimport) int __stdcall CloseHandle(void *hObject);
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -249,6 +272,77 @@ void UnloadFileData(unsigned char *data)
     RL_FREE(data);
 }
 
+// Load file data mapped in memory (read-only)
+// NOTE: Returns NULL if file can not be mapped (custom file data loader set or platform
+// not supported), data should be loaded with LoadFileData() instead
+unsigned char *LoadFileMapped(const char *fileName, int *dataSize)
+{
+    unsigned char *data = NULL;
+    *dataSize = 0;
+
+    if ((fileName == NULL) || (loadFileData != NULL)) return NULL;
+
+#if defined(UTILS_FILE_MAPPING_WIN32)
+    void *file = CreateFileA(fileName, 0x80000000, 0x00000001, NULL, 3, 0x80, NULL);   // GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL
+
+    if (file != (void *)(long long)-1)   // INVALID_HANDLE_VALUE
+    {
+        long long size = 0;
+
+        if (GetFileSizeEx(file, &size) && (size > 0) && (size <= 2147483647))
+        {
+            void *mapping = CreateFileMappingA(file, NULL, 0x02, 0, 0, NULL);           // PAGE_READONLY
+
+            if (mapping != NULL)
+            {
+                data = (unsigned char *)MapViewOfFile(mapping, 0x0004, 0, 0, 0);        // FILE_MAP_READ
+                if (data != NULL) *dataSize = (int)size;
+
+                CloseHandle(mapping);   // NOTE: View keeps the mapping alive
+            }
+        }
+
+        CloseHandle(file);
+    }
+#elif defined(UTILS_FILE_MAPPING_POSIX)
+    int file = open(fileName, O_RDONLY);
+
+    if (file != -1)
+    {
+        struct stat info = { 0 };
+
+        if ((fstat(file, &info) == 0) && (info.st_size > 0) && (info.st_size <= 2147483647))
+        {
+            void *mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (mapping != MAP_FAILED)
+            {
+                data = (unsigned char *)mapping;
+                *dataSize = (int)info.st_size;
+            }
+        }
+
+        close(file);    // NOTE: Mapping is kept after closing the file
+    }
+#endif
+
+    if (data != NULL) TRACELOG(LOG_INFO, "FILEIO: [%s] File mapped successfully", fileName);
+
+    return data;
+}
+
+// Unload file data mapped in memory
+void UnloadFileMapped(unsigned char *data, int dataSize)
+{
+    if (data == NULL) return;
+
+#if defined(UTILS_FILE_MAPPING_WIN32)
+    UnmapViewOfFile(data);
+#elif defined(UTILS_FILE_MAPPING_POSIX)
+    munmap(data, (size_t)dataSize);
+#endif
+}
+
 // Save data to file from buffer
 bool SaveFileData(const char *fileName, void *data, int dataSize)
 {
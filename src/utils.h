@@ -74,6 +74,9 @@ void InitAssetManager(AAssetManager *manager, const char *dataPath);   // Initia
 FILE *android_fopen(const char *fileName, const char *mode);           // Replacement for fopen() -> Read-only!
 #endif
 
+unsigned char *LoadFileMapped(const char *fileName, int *dataSize);     // Load file data mapped in memory (read-only), NULL if not supported
+void UnloadFileMapped(unsigned char *data, int dataSize);              // Unload file data mapped in memory
+
 #if defined(__cplusplus)
 }
 #endif